@@ -0,0 +1,27 @@
+# Convertit un fichier binaire en tableau C++ compilé dans l'exécutable.
+#
+# Utilisation :
+#   cmake -DINPUT=<fichier> -DOUTPUT=<source.cpp> -DSYMBOL=<nom> -P EmbedResource.cmake
+#
+# Le source généré définit, dans l'espace de noms `resources` :
+#   const unsigned char <SYMBOL>Data[];
+#   const std::size_t   <SYMBOL>Size;
+
+file(READ "${INPUT}" content HEX)
+string(LENGTH "${content}" hexLength)
+math(EXPR byteCount "${hexLength} / 2")
+
+# Un octet "ab" devient "0xab," (une ligne très longue suffit au compilateur)
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${content}")
+
+get_filename_component(inputName "${INPUT}" NAME)
+
+file(WRITE "${OUTPUT}"
+"// Fichier généré par cmake/EmbedResource.cmake à partir de ${inputName} : ne pas modifier.
+#include <cstddef>
+
+namespace resources {
+    extern const unsigned char ${SYMBOL}Data[] = { ${bytes} };
+    extern const std::size_t ${SYMBOL}Size = ${byteCount};
+}
+")
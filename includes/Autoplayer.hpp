@@ -0,0 +1,53 @@
+#ifndef AUTOPLAYER_HPP
+#define AUTOPLAYER_HPP
+
+#include <memory>
+#include <vector>
+#include "Board.hpp"
+#include "Lookahead.hpp"
+#include "MoveSearch.hpp"
+#include "Simulation.hpp"
+#include "Tetromino.hpp"
+
+/**
+ * @brief Joueur automatique simple : parmi toutes les poses atteignables,
+ * garde la mieux notée par une évaluation pondérée de la grille.
+ *
+ * Sert au banc d'essai et au mur de spectateurs. Ne regarde ni la pièce
+ * suivante ni la gravité ; les chemins avec descente rapide sont ignorés.
+ * Avec `setLookahead()`, `play()` anticipe les pièces suivantes (`bot::Lookahead`).
+ */
+class Autoplayer {
+public:
+    Autoplayer(int width, int height);
+
+    /// Touches menant à la meilleure pose de `piece` (vide si aucune), valables jusqu'au prochain appel.
+    template <class BoardT>
+    const std::vector<Key>& choose(const BoardT& board, const Tetromino& piece);
+
+    /**
+     * @brief Joue la meilleure pose de la pièce courante de `snap` : déplacements puis chute instantanée.
+     *
+     * @return false s'il n'y avait rien à jouer (pièce suivante attendue, fin de partie).
+     */
+    bool play(Simulation& sim, const GameSnapshot& snap);
+
+    /// Fait chercher les coups de `play()` sur plusieurs pièces (`pieces` doit survivre au joueur).
+    void setLookahead(const PieceSet& pieces, const bot::SearchConfig& config);
+    /// Mesures du dernier coup cherché (nul sans anticipation).
+    const bot::SearchStats* searchStats() const { return lookahead ? &lookahead->stats() : nullptr; }
+
+    /// Note d'une pose (plus haut = mieux) : lignes, hauteur cumulée, trous, irrégularité.
+    template <class BoardT>
+    static double rate(const BoardT& board, const Cells& blocks);
+
+private:
+    int width;
+    int height;
+    MoveSearch search;
+    std::unique_ptr<bot::Lookahead> lookahead;
+    std::vector<Key> best;
+    std::vector<Key> keys;
+};
+
+#endif // AUTOPLAYER_HPP
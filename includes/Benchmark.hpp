@@ -0,0 +1,99 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Banc d'essai du rendu : une partie scriptée et déterministe, mesurée image par image.
+ *
+ * Le script (`tetris --bench <script>`) est un fichier texte, une commande par ligne :
+ * @code
+ * seed 2025          graine du tirage des pièces
+ * wait 120           120 images sans action
+ * click Jouer        clic sur le bouton de ce libellé (écran courant)
+ * key Space          appui puis relâchement (Left, Right, Up, Down, Space, P, R, Escape)
+ * autoplay 1800 6    1800 images de jeu automatique, une pièce toutes les 6 images
+ * repeat 40          répète les lignes suivantes jusqu'au `end` correspondant
+ * end
+ * @endcode
+ * `#` commence un commentaire. Seules `wait` et `autoplay` font avancer les images.
+ */
+namespace bench {
+
+    /// Catégories d'images mesurées (pause, aide et à propos comptent comme menu).
+    enum class Phase : std::uint8_t { Menu, Playing, Clearing, GameOver };
+    constexpr std::size_t PHASE_COUNT = 4;
+    constexpr std::array<const char*, PHASE_COUNT> PHASE_NAMES {"menu", "playing", "clearing", "gameover"};
+
+    struct Step {
+        enum class Kind : std::uint8_t { Wait, Key, Click, AutoPlay };
+
+        Kind kind = Kind::Wait;
+        int frames = 0;                         ///< Wait, AutoPlay
+        int every = 1;                          ///< AutoPlay : images entre deux pièces
+        sf::Keyboard::Key key = sf::Keyboard::Unknown;
+        std::string label;                      ///< Click : libellé du bouton
+    };
+
+    struct Script {
+        std::uint32_t seed = 1;
+        std::vector<Step> steps;                ///< Blocs `repeat` déjà dépliés
+
+        long frameCount() const;
+
+        /// Lit un script ; en cas d'échec, `error` indique la ligne fautive.
+        static std::optional<Script> load(const std::string& path, std::string& error);
+    };
+
+    /// Résumé d'une catégorie : temps d'image (ms) et appels de dessin par image.
+    struct PhaseStats {
+        long frames = 0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double drawCalls = 0.0;                 ///< Moyenne par image
+        std::uint32_t maxDrawCalls = 0;
+    };
+    using Summary = std::array<PhaseStats, PHASE_COUNT>;
+
+    /**
+     * @brief Garde chaque mesure : les centiles sont exacts (quelques milliers d'images).
+     */
+    class Recorder {
+    public:
+        void add(Phase phase, double frameMs, std::uint32_t drawCalls);
+        Summary summarize() const;
+
+    private:
+        struct Samples {
+            std::vector<double> frameMs;
+            std::vector<std::uint32_t> drawCalls;
+        };
+        std::array<Samples, PHASE_COUNT> samples;
+    };
+
+    void report(const Summary& summary, std::ostream& out);
+
+    /// Écrit le résumé au format relu par `loadBaseline` (une ligne par catégorie).
+    bool save(const Summary& summary, const std::string& path);
+    std::optional<Summary> loadBaseline(const std::string& path);
+
+    /**
+     * @brief Compare un résumé à une référence et décrit chaque régression dans `out`.
+     *
+     * - p50, p95 et p99 : régression au-delà de `tolerance` (0.15 : +15 %).
+     * - Appels de dessin : déterministes, toute hausse de la moyenne est une régression.
+     *
+     * @return Le nombre de régressions.
+     */
+    int compare(const Summary& current, const Summary& baseline, double tolerance, std::ostream& out);
+}
+
+#endif // BENCHMARK_HPP
@@ -2,31 +2,101 @@
 #define BOARD_HPP
 
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include <vector>
 #include <memory>
+#include "GameWindow.hpp"
 #include "Tetromino.hpp"
 
-class Board {
+/**
+ * @brief Grille de jeu, de taille fixée à la compilation (`W` x `H`) ou à l'exécution (`W` = `H` = 0).
+ *
+ * - Taille à l'exécution (`Board`) : une ligne allouée par rangée, toute taille
+ *   acceptée (outils, puzzles, jeux de pièces).
+ * - Taille fixe (`StandardBoard`, 10 x 20) : cases dans un `std::array` (copie
+ *   sans allocation), et une ligne de bits par rangée tenue à jour avec les
+ *   couleurs. Collisions, lignes pleines et hauteur de la pile se lisent sur ces
+ *   bits, avec un masque de ligne pleine constant et des boucles de longueur
+ *   connue que le compilateur déroule.
+ *
+ * Les deux variantes ont la même interface et le même comportement (vérifié
+ * par `tetris-fuzz`) ; seules elles deux sont instanciées, dans Board.cpp.
+ */
+template <int W = 0, int H = 0>
+class BasicBoard {
 public:
-    Board(int w, int h);
+    static constexpr bool FIXED = W > 0 && H > 0;
+    static_assert(FIXED || (W == 0 && H == 0), "BasicBoard : largeur et hauteur fixées ensemble");
+    static_assert(W <= 32, "BasicBoard : 32 colonnes au plus pour une taille fixe");
+
+    BasicBoard(int w, int h);
+    BasicBoard(int w, int h, std::span<const std::uint32_t> rows, sf::Color color);
+    /// Copie d'une grille de l'autre variante (la taille doit convenir à celle-ci).
+    template <int W2, int H2>
+    explicit BasicBoard(const BasicBoard<W2, H2>& other) : BasicBoard(other.getWidth(), other.getHeight()) {
+        for (int y = 0; y < getHeight(); y++) {
+            for (int x = 0; x < getWidth(); x++) setCell(x, y, other.getCell(x, y));
+        }
+    }
     bool checkCollision(const Tetromino& tetro) const;
+    int dropDistance(const Tetromino& tetro) const;
     void mergeTetromino(const Tetromino& tetro);
     void detectLinesToClear();
     void performClearLines();
-    void draw(sf::RenderWindow& window, int tileSize);
-    void drawGrid(sf::RenderWindow& window, int tileSize);
-    void drawExplosion(sf::RenderWindow& window, int tileSize, float animTime);
+    void reinsertLine(int y, std::span<const sf::Color> row);
+    void setCell(int x, int y, sf::Color c) {
+        grid[y][x] = c;
+        if constexpr (FIXED) {
+            if (c != sf::Color::Black) occupied[y] |= 1u << x;
+            else occupied[y] &= ~(1u << x);
+        }
+    }
+    void draw(GameWindow& window, int tileSize) const;
+    void drawGrid(GameWindow& window, int tileSize) const;
+    void drawExplosion(GameWindow& window, int tileSize, std::span<const int> rows, float progress) const;
 
-    int getWidth() const { return width; }
-    int getHeight() const { return height; }
+    constexpr int getWidth() const { if constexpr (FIXED) return W; else return width; }
+    constexpr int getHeight() const { if constexpr (FIXED) return H; else return height; }
+    int getStackHeight() const;
+    const sf::Color& getCell(int x, int y) const { return grid[y][x]; }
+    /// Cases occupées de la ligne `y` (bit x : colonne x), sur les 32 premières colonnes.
+    std::uint32_t getRowBits(int y) const {
+        if constexpr (FIXED) return occupied[y];
+        else {
+            std::uint32_t bits = 0;
+            for (int x = 0; x < width && x < 32; x++) {
+                if (grid[y][x] != sf::Color::Black) bits |= 1u << x;
+            }
+            return bits;
+        }
+    }
     bool isClearing() const { return !linesToClear.empty(); }
     const std::vector<int>& getLinesToClear() const { return linesToClear; }
 
 private:
+    using Row = std::conditional_t<FIXED, std::array<sf::Color, W>, std::vector<sf::Color>>;
+    using Grid = std::conditional_t<FIXED, std::array<Row, H>, std::vector<Row>>;
+    /// Lignes de bits (bit x : case occupée), en taille fixe seulement.
+    using Occupancy = std::conditional_t<FIXED, std::array<std::uint32_t, H>, std::array<std::uint32_t, 0>>;
+
+    static constexpr std::uint32_t FULL_ROW = FIXED ? static_cast<std::uint32_t>((std::uint64_t{1} << W) - 1) : 0;
+
     int width;
     int height;
-    std::vector<std::vector<sf::Color>> grid;
+    Grid grid;
+    Occupancy occupied{};
     std::vector<int> linesToClear;
 };
 
-#endif // BOARD_HPP
\ No newline at end of file
+/// Grille de taille quelconque, choisie à l'exécution.
+using Board = BasicBoard<>;
+/// Grille du jeu standard, 10 x 20, de taille fixée à la compilation.
+using StandardBoard = BasicBoard<10, 20>;
+
+extern template class BasicBoard<>;
+extern template class BasicBoard<10, 20>;
+
+#endif // BOARD_HPP
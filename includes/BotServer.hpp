@@ -0,0 +1,81 @@
+#ifndef BOT_SERVER_HPP
+#define BOT_SERVER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Lookahead.hpp"
+#include "MoveSearch.hpp"
+#include "PieceSet.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @brief Protocole texte pour piloter des parties sans fenêtre (outil `tetris-server`).
+ *
+ * Une requête par ligne ; une ligne peut regrouper plusieurs commandes séparées
+ * par `;`. La réponse tient sur une ligne : un résultat par partie visée, dans
+ * l'ordre, séparés par `;`. Un client peut donc jouer des centaines de parties
+ * par aller-retour.
+ * @code
+ * new 100 42                    -> ok 0-99              (100 parties, graines 42 à 141)
+ * state 3                       -> ok 3 score=0 lines=0 level=1 over=0 piece=T next=S rows=0,0,...
+ * moves 3                       -> ok 3 4,18/5,18/4,19/5,19 ...   (cases de chaque pose atteignable)
+ * place 3 7; place 4 0          -> ok 3 lines=0 score=0 over=0; ok 4 lines=1 score=100 over=0
+ * think 0-9 [ms]                -> joue le coup de bot::Lookahead (5 ms par défaut) : ... depth=2 nodes=13950
+ * input 0-99 LLUH               -> gauche, gauche, rotation, chute (T : un tick) ; rien n'est joué si une touche est inconnue
+ * step * 60                     -> 60 ticks de gravité pour toutes les parties
+ * reset 3 [graine] | free 3     -> recommence | supprime la partie
+ * pieces | help | quit          -> noms des pièces | aide | fin de session (seule sur sa ligne)
+ * @endcode
+ * Une partie se désigne par `n`, `a-b` ou `*` (toutes). Les parties n'avancent
+ * que sur demande : `place`, `input` et `step` ; une chute attend l'apparition
+ * de la pièce suivante avant de répondre, elle est donc prête.
+ * Toute erreur répond `err <raison>` sans interrompre les autres commandes.
+ */
+namespace bot {
+
+    class Server {
+    public:
+        Server(int width, int height, const PieceSet& pieces);
+
+        /**
+         * @brief Exécute une ligne de requête et ajoute sa réponse (terminée par `\n`) à `out`.
+         *
+         * @return false si le client a demandé `quit` (rien n'est ajouté).
+         */
+        bool handleLine(std::string_view line, std::string& out);
+
+        std::size_t gameCount() const;
+
+    private:
+        struct Slot {
+            std::unique_ptr<Simulation> sim;
+            std::uint32_t seed = 0;
+        };
+
+        void execute(std::string_view command, std::string& out);
+        bool select(std::string_view selector, std::vector<std::uint32_t>& ids, std::string& error) const;
+
+        void newGames(std::string_view args, std::string& out);
+        void state(std::uint32_t id, std::string& out);
+        void moves(std::uint32_t id, std::string& out);
+        void place(std::uint32_t id, long index, std::string& out);
+        void think(std::uint32_t id, double budgetMs, std::string& out);
+        void input(std::uint32_t id, std::string_view keys, std::string& out);
+        void settle(Simulation& sim);
+        void outcome(std::uint32_t id, int linesBefore, std::string& out);
+
+        int width;
+        int height;
+        const PieceSet& pieces;
+        std::vector<Slot> games;            ///< Par numéro ; `sim` nul après `free`
+        std::vector<std::uint32_t> ids;     ///< Tampon des parties visées
+        GameSnapshot snap;                  ///< Tampon de lecture des états
+        MoveSearch search;                  ///< Partagée : son cache suit la grille interrogée
+        std::unique_ptr<bot::Lookahead> lookahead;  ///< Créée au premier `think` (un thread par cœur)
+    };
+}
+
+#endif // BOT_SERVER_HPP
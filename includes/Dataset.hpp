@@ -0,0 +1,156 @@
+#ifndef DATASET_HPP
+#define DATASET_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+#include "PieceSet.hpp"
+
+/**
+ * @brief Jeux de données de poses pour l'apprentissage : parties de robot sans
+ * fenêtre, une ligne de taille fixe par pose (outil `tetris-dataset`).
+ *
+ * @code
+ * FileHeader (64 o) | noms des pièces (8 o chacun) | remplissage jusqu'à headerSize | Record | Record | ...
+ * @endcode
+ *
+ * Les entiers sont dans l'ordre natif (little-endian). Le nombre de lignes n'est
+ * pas stocké : c'est `(taille du fichier - headerSize) / recordSize`, ce qui garde
+ * lisible un fichier interrompu. Avec numpy (`header_size` : u16 à l'octet 6) :
+ * @code
+ * record = np.dtype([("rows", "<u2", 24), ("game", "<u4"), ("move", "<u4"), ("reward", "<u4"),
+ *                    ("piece", "u1"), ("next", "u1"), ("rotation", "u1"), ("x", "i1"), ("y", "i1"),
+ *                    ("lines", "u1"), ("flags", "u1"), ("choice", "u1"), ("choices", "u1"), ("reserved", "u1", 3)])
+ * samples = np.memmap(path, dtype=record, mode="r", offset=header_size)
+ * @endcode
+ */
+namespace dataset {
+
+    constexpr std::array<char, 4> MAGIC {'T', 'D', 'A', 'T'};
+    constexpr std::uint16_t FORMAT_VERSION = 1;
+    constexpr int MAX_COLUMNS = 16;
+    constexpr int MAX_ROWS = 24;
+    constexpr std::size_t NAME_SIZE = 8;
+    constexpr std::uint8_t NO_PIECE = 0xFF;
+
+    struct FileHeader {
+        std::array<char, 4> magic = MAGIC;
+        std::uint16_t version = FORMAT_VERSION;
+        std::uint16_t headerSize = 0;       ///< Début de la première ligne
+        std::uint16_t recordSize = 0;
+        std::uint8_t width = 0;
+        std::uint8_t height = 0;
+        std::uint16_t pieceCount = 0;       ///< Noms des pièces à la suite de l'en-tête
+        std::uint16_t reserved = 0;
+        std::uint64_t seed = 0;
+        std::uint32_t explorePermille = 0;  ///< Part des coups explorés (pour mille)
+        std::array<std::uint8_t, 36> reserved2{};
+    };
+
+    /// Drapeaux d'une ligne.
+    enum Flag : std::uint8_t {
+        GameOver = 1 << 0,      ///< La pose a terminé la partie
+        Explored = 1 << 1,      ///< Pose tirée au hasard plutôt que la mieux notée
+    };
+
+    /**
+     * @brief Une pose : l'état avant, la pose choisie et ce qu'elle a rapporté.
+     *
+     * La pose se retrouve à partir de la pièce : `rotation` quarts de tour depuis
+     * l'apparition, coin haut gauche des cases en (`x`, `y`).
+     */
+    struct Record {
+        std::array<std::uint16_t, MAX_ROWS> rows{};  ///< Grille avant la pose, ligne du haut en premier (bit x : colonne x)
+        std::uint32_t game = 0;             ///< Numéro de la partie dans le fichier
+        std::uint32_t move = 0;             ///< Numéro de la pose dans la partie
+        std::uint32_t reward = 0;           ///< Points rapportés par la pose
+        std::uint8_t piece = 0;             ///< Pièce courante (indice dans les noms de l'en-tête)
+        std::uint8_t next = NO_PIECE;       ///< Pièce suivante (le jeu n'en montre qu'une)
+        std::uint8_t rotation = 0;
+        std::int8_t x = 0;
+        std::int8_t y = 0;
+        std::uint8_t lines = 0;             ///< Lignes effacées par la pose
+        std::uint8_t flags = 0;
+        std::uint8_t choice = 0;            ///< Rang de la pose parmi les poses jouables
+        std::uint8_t choices = 0;           ///< Nombre de poses jouables
+        std::array<std::uint8_t, 3> reserved{};
+    };
+
+    static_assert(sizeof(FileHeader) == 64 && sizeof(Record) == 72,
+                  "Le format du fichier ne doit pas dépendre du compilateur");
+
+    /// Réglages de l'export.
+    struct Config {
+        int width = 10;
+        int height = 20;
+        std::uint64_t samples = 1'000'000;  ///< Lignes à écrire
+        unsigned threads = 0;               ///< 0 : un par cœur
+        std::uint64_t seed = 1;             ///< Le thread i joue avec la graine seed + i
+        double explore = 0.05;              ///< Probabilité d'une pose au hasard
+    };
+
+    /// Bilan d'un export.
+    struct Stats {
+        std::uint64_t samples = 0;
+        std::uint64_t games = 0;            ///< Parties terminées dans le fichier
+        std::uint64_t bytes = 0;
+        double seconds = 0.0;
+        unsigned threads = 0;
+
+        double samplesPerMinute() const { return seconds > 0.0 ? samples * 60.0 / seconds : 0.0; }
+    };
+
+    /**
+     * @brief Fichier de lignes, écrit par lots depuis plusieurs threads.
+     *
+     * Chaque thread remplit son propre lot et le remet en entier : un seul
+     * `write` par lot, sous verrou. L'ordre des lignes entre threads n'est donc
+     * pas fixé, mais les lignes d'une partie restent dans l'ordre.
+     */
+    class Writer {
+    public:
+        Writer(const std::string& path, const FileHeader& header, const PieceSet& pieces);
+
+        bool isOpen() const { return static_cast<bool>(file); }
+
+        /**
+         * @brief Ajoute un lot, tronqué à ce qui reste jusqu'à `limit` lignes.
+         *
+         * @return false une fois la limite atteinte (ou en cas d'erreur d'écriture).
+         */
+        bool append(std::span<const Record> batch, std::uint64_t limit);
+
+        std::uint64_t records() const { return written.load(std::memory_order_relaxed); }
+        /// Parties dont la dernière pose a été écrite.
+        std::uint64_t games() const { return ended.load(std::memory_order_relaxed); }
+        std::uint64_t bytes() const;
+
+    private:
+        std::ofstream file;
+        std::mutex lock;
+        std::atomic<std::uint64_t> written{0};
+        std::atomic<std::uint64_t> ended{0};
+        std::uint16_t headerSize = 0;
+    };
+
+    /**
+     * @brief Parties de robot sur `config.threads` threads jusqu'à `config.samples` lignes.
+     *
+     * Chaque thread a sa simulation, sa recherche de poses et son lot. La pose
+     * jouée est la mieux notée par `Autoplayer::rate`, ou avec la probabilité
+     * `explore` une pose jouable au hasard. Le drapeau `stop` arrête l'export
+     * (lignes déjà produites écrites).
+     */
+    Stats run(const Config& config, const PieceSet& pieces, Writer& writer, const std::atomic<bool>& stop);
+
+    /// En-tête correspondant aux réglages.
+    FileHeader makeHeader(const Config& config, const PieceSet& pieces);
+}
+
+#endif // DATASET_HPP
@@ -0,0 +1,50 @@
+#ifndef FIXED_VECTOR_HPP
+#define FIXED_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Petit vecteur de capacité fixe, stocké sur place (aucune allocation).
+ *
+ * Sert aux cases d'une pièce : copier une pièce reste une simple copie mémoire.
+ */
+template <typename T, std::size_t Capacity>
+class FixedVector {
+    static_assert(Capacity > 0 && Capacity < 256, "Capacité de 1 à 255 éléments");
+
+public:
+    FixedVector() = default;
+
+    void push_back(const T& value) {
+        assert(count < Capacity);
+        items[count++] = value;
+    }
+    void clear() { count = 0; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    T& operator[](std::size_t i) { return items[i]; }
+    const T& operator[](std::size_t i) const { return items[i]; }
+
+    T* begin() { return items.data(); }
+    T* end() { return items.data() + count; }
+    const T* begin() const { return items.data(); }
+    const T* end() const { return items.data() + count; }
+
+    /// Compare les éléments présents uniquement (les emplacements libres sont ignorés).
+    bool operator==(const FixedVector& other) const {
+        return count == other.count && std::equal(begin(), end(), other.begin());
+    }
+
+private:
+    std::array<T, Capacity> items{};
+    std::uint8_t count = 0;
+};
+
+#endif // FIXED_VECTOR_HPP
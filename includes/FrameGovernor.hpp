@@ -0,0 +1,118 @@
+#ifndef FRAME_GOVERNOR_HPP
+#define FRAME_GOVERNOR_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Budget de temps par image : retire les effets facultatifs quand le rendu
+ * ne tient plus dans le budget, et les rend quand la marge revient.
+ *
+ * Les effets sont retirés un par un, dans l'ordre des niveaux (`Level`). Le temps
+ * mesuré est celui d'une image (événements, mise à jour, rendu), lissé sur
+ * quelques images :
+ * - au-dessus de `OVER` × budget pendant `DEGRADE_FRAMES` images, ou pour une seule
+ *   image au-delà de `SPIKE` × budget, on descend d'un niveau ;
+ * - sous `HEADROOM` × budget pendant `RESTORE_SECONDS`, on remonte d'un niveau.
+ *
+ * L'écart entre les deux seuils et l'attente avant de remonter (hystérésis)
+ * évitent d'osciller entre deux niveaux. La gravité et les entrées tournent
+ * sur le thread de simulation : elles ne dépendent pas de ce budget.
+ */
+class FrameGovernor {
+public:
+    /// Niveaux de dégradation, chacun retire un effet de plus que le précédent.
+    enum class Level : std::uint8_t {
+        Full = 0,       ///< Tous les effets
+        NoGrid,         ///< Sans la grille du plateau
+        NoGhost,        ///< Sans la pièce fantôme
+        NoExplosions,   ///< Sans explosions ni nouvelles particules
+        SlowHud,        ///< Textes du panneau mis à jour `SLOW_HUD_HZ` fois par seconde
+    };
+    static constexpr int LEVEL_COUNT = 5;
+
+    /// Position du temps lissé par rapport au budget.
+    enum class Budget : std::uint8_t { Headroom, Tight, Over };
+
+    static constexpr double OVER = 0.9;
+    static constexpr double SPIKE = 2.0;
+    static constexpr double HEADROOM = 0.6;
+    static constexpr int DEGRADE_FRAMES = 3;
+    static constexpr double RESTORE_SECONDS = 2.0;
+    static constexpr int SLOW_HUD_HZ = 10;
+
+    /// @param budgetMs Budget d'une image en millisecondes (0 : effets toujours complets).
+    explicit FrameGovernor(double budgetMs = 1000.0 / 60.0);
+
+    void setBudget(double budgetMs);
+    double budget() const { return budgetMs; }
+    bool enabled() const { return budgetMs > 0.0; }
+
+    /**
+     * @brief Fin d'une image : ajuste le niveau pour les images suivantes.
+     *
+     * @param workMs Durée de l'image : événements, mise à jour et rendu, sans la présentation (ms).
+     * @param dt Temps écoulé depuis l'image précédente (secondes).
+     * @return true si le niveau a changé.
+     */
+    bool frame(double workMs, float dt);
+
+    Level level() const { return current; }
+    Budget state() const { return budgetState; }
+    double averageMs() const { return average; }
+
+    bool drawGrid() const { return current < Level::NoGrid; }
+    bool drawGhost() const { return current < Level::NoGhost; }
+    bool drawExplosions() const { return current < Level::NoExplosions; }
+    /// Les textes du panneau sont-ils à recalculer pour cette image ?
+    bool refreshHud() const { return current < Level::SlowHud || hudDue; }
+
+    /// Temps passé à chaque niveau, images hors budget, changements de niveau.
+    void report(std::ostream& out) const;
+
+private:
+    void change(int delta);
+
+    double budgetMs;
+    double average = 0.0;
+    Level current = Level::Full;
+    Budget budgetState = Budget::Headroom;
+    int overFrames = 0;
+    float headroomSeconds = 0.f;
+    float hudSeconds = 0.f;
+    bool hudDue = true;
+
+    // Bilan
+    std::array<double, LEVEL_COUNT> secondsAt{};
+    std::uint64_t frames = 0;
+    std::uint64_t framesOver = 0;
+    std::uint64_t degrades = 0;
+    std::uint64_t restores = 0;
+    double worstMs = 0.0;
+};
+
+/**
+ * @brief Nom lisible d'un niveau (pour les rapports et le panneau).
+ */
+constexpr const char* toString(FrameGovernor::Level level) {
+    switch (level) {
+        case FrameGovernor::Level::Full:         return "complet";
+        case FrameGovernor::Level::NoGrid:       return "sans grille";
+        case FrameGovernor::Level::NoGhost:      return "sans fantome";
+        case FrameGovernor::Level::NoExplosions: return "sans effets";
+        case FrameGovernor::Level::SlowHud:      return "panneau lent";
+    }
+    return "?";
+}
+
+constexpr const char* toString(FrameGovernor::Budget budget) {
+    switch (budget) {
+        case FrameGovernor::Budget::Headroom: return "marge";
+        case FrameGovernor::Budget::Tight:    return "juste";
+        case FrameGovernor::Budget::Over:     return "depasse";
+    }
+    return "?";
+}
+
+#endif // FRAME_GOVERNOR_HPP
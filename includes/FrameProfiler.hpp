@@ -0,0 +1,42 @@
+#ifndef FRAME_PROFILER_HPP
+#define FRAME_PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <ostream>
+#include "GameState.hpp"
+
+/**
+ * @brief Mesure le temps réel, le temps CPU et le nombre d'images par état du jeu.
+ *
+ * `tick()` est appelé une fois par tour de boucle : le temps écoulé depuis
+ * l'appel précédent est attribué à l'état qui était actif pendant ce temps.
+ * Le rapport permet de vérifier que les écrans inactifs (menu, pause...)
+ * ne consomment presque plus de CPU.
+ */
+class FrameProfiler {
+public:
+    FrameProfiler();
+
+    void tick(GameState current);
+    void frameRendered() { buckets[index(lastState)].frames++; }
+    void report(std::ostream& out) const;
+
+private:
+    struct Bucket {
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        long iterations = 0;
+        long frames = 0;
+    };
+
+    static std::size_t index(GameState s) { return static_cast<std::size_t>(s); }
+
+    std::array<Bucket, GAME_STATE_COUNT> buckets{};
+    GameState lastState = GameState::MENU;
+    std::chrono::steady_clock::time_point lastWall;
+    std::clock_t lastCpu;
+};
+
+#endif // FRAME_PROFILER_HPP
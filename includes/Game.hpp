@@ -2,21 +2,30 @@
 #define GAME_HPP
 
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <memory>
 #include <vector>
 #include <functional>
+#include <future>
+#include "Autoplayer.hpp"
+#include "Benchmark.hpp"
 #include "Board.hpp"
+#include "FrameGovernor.hpp"
+#include "FrameProfiler.hpp"
+#include "GameState.hpp"
+#include "GameWindow.hpp"
+#include "MoveSearch.hpp"
+#include "ParticleSystem.hpp"
+#include "PerfectClear.hpp"
+#include "PerfCounters.hpp"
+#include "PieceSet.hpp"
+#include "PuzzlePack.hpp"
+#include "SimulationRunner.hpp"
+#include "StateFeed.hpp"
+#include "StartupTrace.hpp"
+#include "Telemetry.hpp"
 #include "Tetromino.hpp"
 
-enum class GameState {
-    MENU,
-    PLAYING,
-    PAUSED,
-    HELP,
-    ABOUT,
-    GAME_OVER
-};
-
 // Structure pour gérer un bouton simple
 struct Button {
     sf::RectangleShape shape;
@@ -33,11 +42,72 @@ public:
     Game(int width, int height, int tileSize);
     void run();
 
+    /// Affiche le rapport du profileur (temps et CPU par état) à la fermeture.
+    void setProfiling(bool enabled) { profiling = enabled; }
+
+    /**
+     * @brief Compteurs matériels par phase (événements, mise à jour, rendu, recherche du robot)
+     * écrits dans un fichier CSV, avec un bilan à la fermeture (à appeler depuis le thread de `run()`).
+     *
+     * @return false si le fichier ne peut être créé.
+     */
+    bool setPerfCounters(const std::string& path) { return perfLog.open(path); }
+
+    /**
+     * @brief Publie l'état de chaque tick dans le segment de mémoire partagée `name`
+     * (voir StateFeed.hpp), avant `run()`.
+     *
+     * @return false si le segment ne peut être créé (message sur `std::cerr`).
+     */
+    bool setStateFeed(const std::string& name);
+
+    /**
+     * @brief Budget d'une image en millisecondes : au-delà, les effets facultatifs
+     * sont retirés un à un (voir FrameGovernor.hpp) ; 0 les garde toujours.
+     */
+    void setFrameBudget(double ms) { governor.setBudget(ms); }
+
+    /// Fichier de télémétrie des parties (chaîne vide : désactivée).
+    void setTelemetryPath(const std::string& path) { telemetryPath = path; }
+
+    /// Ouvre un paquet de puzzles et ajoute l'entrée "Puzzles" au menu.
+    bool setPuzzlePack(const std::string& path, std::uint32_t first = 0);
+
+    /// Joue avec les pièces d'un fichier plutôt qu'avec les tétrominos (avant `run()`).
+    bool setPieceSet(const std::string& path);
+
+    /// Délais de verrouillage, d'apparition et d'effacement (avant `run()`).
+    void setDelays(const gravity::Delays& delays) { simulation.setDelays(delays); }
+
+    /**
+     * @brief Joue un script de banc d'essai image par image (voir Benchmark.hpp).
+     *
+     * La simulation avance d'un pas par image sur ce thread : la partie est
+     * identique d'une exécution à l'autre. Seuls `update()` et `render()` sont chronométrés.
+     *
+     * @return false si la fenêtre a été fermée avant la fin du script.
+     */
+    bool runBenchmark(const bench::Script& script, bench::Recorder& recorder);
+
 private:
     void processEvents();
+    void handleEvent(const sf::Event& e);
+    bool isIdleScreen() const;
+    bool waitEventFor(sf::Event& e, sf::Time timeout);
+    bool runIdleScreen();
+    std::vector<Button>* activeButtons();
+    bool updateHover(const sf::Vector2f& mousePos);
     void update(float dt);
+    void syncSimulation();
+    void sendCommand(Command type, bool repeat = false);
     void render();
 
+    // Banc d'essai
+    void benchFrame(bench::Recorder& recorder);
+    void benchKey(sf::Keyboard::Key key, bool pressed);
+    bool benchClick(const std::string& label);
+    void benchAutoMove(Autoplayer& bot);
+
     void setupMenuButtons();
     void setupPauseButtons();
 
@@ -53,36 +123,88 @@ private:
     void resetGame();
     void loadBestScore();
     void saveBestScore();
-    void updateScore(int linesCleared);
+    void finishTelemetry(int finalScore, int finalLevel);
     void drawScore();
+    void updateHud();
+    void updateHint();
+    void drawHint();
+
+    sf::Font loadFont();
+    void prebakeGlyphs();
 
-    Tetromino computeGhost() const;
+    StartupTrace trace;                ///< Chronologie du démarrage (construite en premier)
+    sf::Font font;
+    std::future<void> glyphPrebake;    ///< Pré-rendu des glyphes pendant la création de la fenêtre
+    bool firstFrameShown = false;
 
-    sf::RenderWindow window;
-    Board board;
+    GameWindow window;
+    int boardWidth;
+    int boardHeight;
     int tileSize;
 
-    std::unique_ptr<Tetromino> current;
-    std::unique_ptr<Tetromino> next;
+    std::unique_ptr<PieceSet> pieceSet; ///< Pièces chargées (nul : tétrominos) ; survit à la simulation
+    std::unique_ptr<feed::Writer> stateFeed; ///< Flux d'état pour les observateurs ; survit à la simulation
 
-    int score = 0;
-    int level = 1;
-    int totalLinesCleared = 0;
-    int bestScore = 0;
+    // Simulation sur son propre thread ; l'affichage dessine le dernier état publié
+    SimulationRunner simulation;
+    std::uint32_t gameId = 0;           ///< Partie en cours (les états d'une partie précédente sont ignorés)
+    bool simulationRunning = false;     ///< Dernier ordre Resume/Pause envoyé
 
-    float timer;
-    float delay;
+    int bestScore = 0;
+    int finesseFaults = 0;              ///< Pièces posées avec plus d'appuis que nécessaire
+    int finesseExtraKeys = 0;
+    std::array<bool, sf::Keyboard::KeyCount> heldKeys{}; ///< Distingue les répétitions automatiques
 
-    bool clearing;
-    float clearTimer;
-    bool gameOver;
+    ParticleSystem particles{65536};    ///< Effets (lignes, chute instantanée, niveau)
 
     GameState state;
-    sf::Font font;
 
     // Boutons dans le jeu
     std::vector<Button> menuButtons;
     std::vector<Button> pauseButtons;
+
+    // Écrans inactifs (menu, aide, à propos, pause) : redessinés seulement si besoin
+    bool screenDirty = true;            ///< Contenu à redessiner (survol, fenêtre exposée...)
+    GameState renderedState;            ///< État affiché lors du dernier rendu
+    int hoveredButton = -2;             ///< Bouton survolé (-1 : aucun, -2 : inconnu)
+
+    FrameProfiler profiler;
+    bool profiling = false;
+    FrameGovernor governor;             ///< Effets retirés quand les images dépassent leur budget
+
+    // Textes du panneau, recalculés au rythme permis par le budget
+    sf::Text hudScore;
+    sf::Text hudBest;
+    sf::Text hudLevel;
+    sf::Text hudFinesse;
+    sf::Text hudMode;                   ///< Puzzle ou entraînement (vide sinon)
+    sf::Text hudBudget;                 ///< Budget et niveau de dégradation (avec `--profile`)
+    sf::Text hudHint;                   ///< Résultat de l'aide au perfect clear (touche H)
+    perf::Log perfLog;                  ///< Compteurs matériels par phase (inactif sans `setPerfCounters`)
+
+    // Mode puzzle : grilles et pièces imposées, lues dans un paquet projeté en mémoire
+    std::unique_ptr<puzzle::Pack> puzzlePack;
+    std::uint32_t puzzleIndex = 0;
+    bool puzzleMode = false;
+    int puzzleResult = -1;              ///< -1 : en cours, 0 : échoué, 1 : réussi
+    std::vector<PieceId> puzzlePieces;  ///< Suite imposée du puzzle en cours
+
+    // Aide au perfect clear (touche H) : recherche en arrière-plan à chaque nouvelle pièce
+    bool hintMode = false;
+    std::unique_ptr<bot::PerfectClear> clearSolver;
+    const PieceSet* clearPieces = nullptr;      ///< Jeu de pièces du solveur
+    std::future<bot::ClearResult> clearSearch;  ///< Recherche en cours (détruite avant le solveur)
+    std::vector<std::uint32_t> searchKey;       ///< Grille et suite de la recherche en cours
+    std::vector<std::uint32_t> hintKey;         ///< Grille et suite du résultat `clearHint`
+    bot::ClearResult clearHint;
+    bool hintCurrent = false;                   ///< `clearHint` correspond à la pièce en jeu
+
+    // Mode entraînement : poses annulables (Retour arrière), ni télémétrie ni meilleur score
+    bool practiceMode = false;
+    float rewindTime = 0.f;             ///< Durée d'appui sur Retour arrière (retour continu)
+
+    telemetry::Recorder gameTelemetry;
+    std::string telemetryPath = "telemetry.bin";
 };
 
 #endif // GAME_HPP
@@ -0,0 +1,33 @@
+#ifndef GAME_STATE_HPP
+#define GAME_STATE_HPP
+
+#include <cstddef>
+
+enum class GameState {
+    MENU,
+    PLAYING,
+    PAUSED,
+    HELP,
+    ABOUT,
+    GAME_OVER
+};
+
+/// Nombre d'états (pour indexer des tableaux par état).
+constexpr std::size_t GAME_STATE_COUNT = 6;
+
+/**
+ * @brief Nom lisible d'un état (pour les rapports et les traces).
+ */
+constexpr const char* toString(GameState s) {
+    switch (s) {
+        case GameState::MENU:      return "menu";
+        case GameState::PLAYING:   return "jeu";
+        case GameState::PAUSED:    return "pause";
+        case GameState::HELP:      return "aide";
+        case GameState::ABOUT:     return "a propos";
+        case GameState::GAME_OVER: return "game over";
+    }
+    return "?";
+}
+
+#endif // GAME_STATE_HPP
@@ -0,0 +1,39 @@
+#ifndef GAME_WINDOW_HPP
+#define GAME_WINDOW_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fenêtre du jeu : une `sf::RenderWindow` qui compte ses appels de dessin.
+ *
+ * Les `draw` de SFML ne sont pas virtuels : seuls les appels passant par une
+ * `GameWindow` sont comptés. Board, Tetromino et ParticleSystem dessinent donc
+ * sur une `GameWindow&` plutôt que sur une `sf::RenderTarget&`.
+ */
+class GameWindow : public sf::RenderWindow {
+public:
+    using sf::RenderWindow::RenderWindow;
+    using sf::RenderTarget::draw;
+
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default) {
+        drawCalls++;
+        sf::RenderTarget::draw(drawable, states);
+    }
+
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        drawCalls++;
+        sf::RenderTarget::draw(vertices, count, type, states);
+    }
+
+    /// Appels de dessin depuis le dernier `resetDrawCalls()`.
+    std::uint32_t getDrawCalls() const { return drawCalls; }
+    void resetDrawCalls() { drawCalls = 0; }
+
+private:
+    std::uint32_t drawCalls = 0;
+};
+
+#endif // GAME_WINDOW_HPP
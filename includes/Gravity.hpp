@@ -0,0 +1,75 @@
+#ifndef GRAVITY_HPP
+#define GRAVITY_HPP
+
+#include <algorithm>
+#include <array>
+
+/**
+ * @brief Horloge de simulation à pas fixe et table de gravité par niveau.
+ *
+ * La logique du jeu avance par ticks de 1/60 s, indépendamment de la cadence
+ * d'affichage. La gravité est exprimée en virgule fixe Q16 : `ONE_G` vaut une
+ * ligne par tick (1G), `ONE_G / 30` une ligne toutes les 30 ticks. Le nombre de
+ * lignes à descendre s'accumule d'un tick à l'autre, ce qui permet des chutes
+ * fractionnaires comme des chutes de plusieurs lignes par tick (jusqu'à 20G).
+ */
+namespace gravity {
+
+    constexpr int TICKS_PER_SECOND = 60;
+    constexpr float TICK_SECONDS = 1.f / TICKS_PER_SECOND;
+
+    /// Au-delà, le temps de retard est abandonné (fenêtre déplacée, machine bloquée...).
+    constexpr int MAX_TICKS_PER_FRAME = 15;
+
+    constexpr int ONE_G = 1 << 16;
+    constexpr int MAX_G = 20;
+
+    /// Gravité d'une ligne toutes les `frames` ticks.
+    constexpr int framesPerRow(int frames) { return ONE_G / frames; }
+    /// Gravité de `rows` lignes par tick.
+    constexpr int rowsPerFrame(int rows) { return ONE_G * rows; }
+
+    /**
+     * @brief Gravité par niveau (indice 0 : niveau 1).
+     *
+     * Le niveau 1 (30 ticks par ligne) correspond à l'ancien délai de 0,5 s.
+     * Les niveaux au-delà de la table restent à 20G.
+     */
+    constexpr std::array<int, 18> TABLE {
+        framesPerRow(30), framesPerRow(25), framesPerRow(20), framesPerRow(16),
+        framesPerRow(13), framesPerRow(10), framesPerRow(8),  framesPerRow(6),
+        framesPerRow(5),  framesPerRow(4),  framesPerRow(3),  framesPerRow(2),
+        rowsPerFrame(1),  rowsPerFrame(2),  rowsPerFrame(3),  rowsPerFrame(5),
+        rowsPerFrame(10), rowsPerFrame(MAX_G)
+    };
+
+    /// Gravité minimale quand la descente rapide (flèche bas) est maintenue.
+    constexpr int SOFT_DROP = framesPerRow(3);
+
+    /// Ticks passés posé sur la pile avant verrouillage (0,5 s, comme l'ancien délai).
+    constexpr int LOCK_DELAY_TICKS = 30;
+
+    /// Durée de l'effet d'effacement des lignes (0,3 s), joué par-dessus la partie.
+    constexpr int CLEAR_EFFECT_TICKS = 18;
+
+    /**
+     * @brief Délais de jeu réglables, en ticks.
+     *
+     * Après chaque pose, la pièce suivante attend `entry` ticks, plus `lineClear`
+     * si des lignes ont été effacées : c'est le temps mort de la pose. Par défaut
+     * il est nul, l'effet d'effacement se superposant à la pièce suivante
+     * (`lineClear = CLEAR_EFFECT_TICKS` retrouve l'ancien gel de 0,3 s).
+     */
+    struct Delays {
+        int lock = LOCK_DELAY_TICKS;
+        int entry = 0;
+        int lineClear = 0;
+        int clearEffect = CLEAR_EFFECT_TICKS;
+    };
+
+    constexpr int forLevel(int level) {
+        return TABLE[std::clamp(level, 1, static_cast<int>(TABLE.size())) - 1];
+    }
+}
+
+#endif // GRAVITY_HPP
@@ -0,0 +1,150 @@
+#ifndef LOOKAHEAD_HPP
+#define LOOKAHEAD_HPP
+
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Board.hpp"
+#include "MoveSearch.hpp"
+#include "PieceSet.hpp"
+#include "Tetromino.hpp"
+
+namespace bot {
+
+    /// Réglages de la recherche avec anticipation.
+    struct SearchConfig {
+        int depth = 3;              ///< Pièces inconnues prévues au-delà de la suivante
+        int beam = 6;               ///< Poses développées par pièce (les mieux notées seulement)
+        double budgetMs = 5.0;      ///< Temps par coup (0 : sans limite, résultat reproductible)
+        unsigned threads = 0;       ///< Threads de recherche, appelant compris (0 : un par cœur)
+    };
+
+    /// Mesures du dernier coup cherché.
+    struct SearchStats {
+        std::uint64_t nodes = 0;        ///< Grilles évaluées
+        std::uint64_t cacheHits = 0;    ///< Espérances reprises du cache
+        int depth = 0;                  ///< Pièces inconnues entièrement explorées
+        double ms = 0.0;
+
+        double nodesPerSecond() const { return ms > 0.0 ? nodes * 1000.0 / ms : 0.0; }
+    };
+
+    /**
+     * @brief Recherche expectimax : la pièce courante, la suivante, puis l'espérance
+     * sur toutes les pièces possibles, jusqu'à `depth` pièces inconnues.
+     *
+     * - Les poses de la pièce courante viennent de `MoveSearch` (glissements et
+     *   rotations compris) ; au-delà, les pièces tombent tout droit, sur des
+     *   lignes de bits, sans allocation.
+     * - À chaque pièce, seules les `beam` meilleures poses selon l'évaluation de
+     *   `Autoplayer::rate` (mêmes poids) sont développées.
+     * - Les espérances déjà calculées sont gardées dans un cache par thread,
+     *   indexé par la grille : elles resservent d'un coup à l'autre.
+     * - Approfondissement itératif : chaque profondeur complète remplace le choix
+     *   de la précédente ; à l'échéance du budget, la profondeur en cours est abandonnée.
+     * - Les poses de départ sont réparties entre les threads ; celui de l'appelant en fait partie.
+     *
+     * Les pièces inconnues sont équiprobables, comme le tirage de `Simulation`.
+     */
+    class Lookahead {
+    public:
+        /**
+         * @param pieces Pièces possibles (doit survivre à la recherche).
+         * @throws std::invalid_argument Si le plateau dépasse 32 colonnes ou 32 lignes.
+         */
+        Lookahead(int width, int height, const PieceSet& pieces, SearchConfig config = {});
+        ~Lookahead();
+
+        Lookahead(const Lookahead&) = delete;
+        Lookahead& operator=(const Lookahead&) = delete;
+
+        /// Touches menant à la meilleure pose de `current` (vide si aucune), valables jusqu'au prochain appel.
+        template <class BoardT>
+        const std::vector<Key>& choose(const BoardT& board, const Tetromino& current, const Tetromino& next);
+
+        void setBudget(double ms) { config.budgetMs = ms; }
+        const SearchStats& stats() const { return last; }
+
+    private:
+        static constexpr int MAX_ROWS = 32;
+
+        /// Grille en lignes de bits (bit x : colonne x).
+        struct Field {
+            std::array<std::uint32_t, MAX_ROWS> rows{};
+        };
+
+        /// Orientation distincte d'une pièce, en masques de lignes calés à gauche.
+        struct Orientation {
+            std::array<std::uint32_t, MAX_CELLS> masks{};
+            int span = 0;                   ///< Lignes occupées
+            int columns = 0;                ///< Colonnes occupées
+        };
+
+        /// Grille obtenue après une pose.
+        struct Child {
+            Field field;
+            int lines = 0;
+            double rating = 0.0;
+        };
+
+        struct Root {
+            Placement placement;
+            Child child;
+            double value = 0.0;
+        };
+
+        struct CacheEntry {
+            std::uint64_t key = 0;
+            double value = 0.0;
+        };
+
+        /// État propre à chaque thread de recherche.
+        struct Worker {
+            std::vector<CacheEntry> cache;
+            std::vector<std::vector<Child>> levels;     ///< Poses en cours, par niveau de récursion
+            std::uint64_t nodes = 0;
+            std::uint64_t hits = 0;
+            std::uint32_t checks = 0;                   ///< Expansions depuis le début (lecture de l'horloge)
+        };
+
+        void workerLoop(Worker& w);
+        void searchRoots(Worker& w);
+        double maxNode(Worker& w, const Field& field, PieceId piece, int unknown, int level);
+        double chanceNode(Worker& w, const Field& field, int unknown, int level);
+        void expand(Worker& w, const Field& field, PieceId piece, std::vector<Child>& out);
+        double rateShape(const Field& field) const;
+        int clearFull(Field& field) const;
+        bool timeUp(Worker& w);
+
+        int width;
+        int height;
+        std::uint32_t fullRow;
+        SearchConfig config;
+        std::vector<std::vector<Orientation>> orientations;    ///< Par pièce
+
+        MoveSearch search;
+        std::vector<Root> roots;
+        PieceId nextPiece = 0;
+        std::vector<Key> best;
+        SearchStats last;
+
+        // Groupe de threads : une passe sur les poses de départ par profondeur
+        unsigned threadCount;
+        std::vector<Worker> workers;                ///< workers[0] : thread appelant
+        std::vector<std::thread> threads;
+        std::barrier<> passStart;
+        std::barrier<> passDone;
+        std::atomic<std::size_t> nextRoot{0};
+        std::atomic<bool> stopped{false};
+        std::chrono::steady_clock::time_point deadline;
+        int passDepth = 0;                          ///< Pièces inconnues de la passe en cours
+        bool timed = false;                         ///< La passe peut être abandonnée
+        bool stopping = false;
+    };
+}
+
+#endif // LOOKAHEAD_HPP
@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Fichier projeté en mémoire en lecture seule (mmap / MapViewOfFile).
+ *
+ * Seules les pages réellement lues sont chargées : ouvrir un gros fichier
+ * ne coûte rien en mémoire tant qu'on ne le parcourt pas.
+ */
+class MappedFile {
+public:
+    /// Indication au système sur l'ordre des lectures.
+    enum class Access { Sequential, Random };
+
+    explicit MappedFile(const std::string& path, Access access = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const unsigned char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,100 @@
+#ifndef MOVESEARCH_HPP
+#define MOVESEARCH_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Board.hpp"
+#include "Tetromino.hpp"
+
+/// Touches du joueur considérées par la recherche.
+enum class Key : std::uint8_t { Left, Right, Rotate, SoftDrop, HardDrop };
+
+/**
+ * @brief Position finale atteignable d'une pièce (après la chute instantanée).
+ */
+struct Placement {
+    Cells blocks;                        ///< Cases occupées une fois posée (triées)
+    int rotation = 0;                    ///< Quarts de tour depuis la pièce de départ
+    int keys = 0;                        ///< Nombre minimal d'appuis (chute comprise)
+    PieceId piece = 0;
+    std::uint32_t from = 0;              ///< État d'où part la chute (reconstruction du chemin)
+};
+
+/**
+ * @brief Recherche de toutes les poses atteignables d'une pièce, avec le chemin de touches minimal.
+ *
+ * Les états (x, y, rotation, touche maintenue) sont explorés par un parcours en
+ * largeur 0-1 : chaque nouvel appui coûte 1, maintenir gauche, droite ou bas
+ * (répétition automatique) ne coûte rien de plus. Une rotation relâche la touche
+ * maintenue, comme le décompte de `Simulation::play`. Les rotations suivent
+ * `Tetromino::rotate` (sans décalage contre les murs), donc les glissements sous
+ * un surplomb et les rotations en fin de chute sont trouvés. La gravité est ignorée.
+ *
+ * Le graphe d'états de chaque pièce est gardé en cache et réutilisé tant que
+ * `setBoard` reçoit une grille identique ; les tests de collision se font sur
+ * des lignes de bits, sans copier de Tetromino. Les orientations viennent des
+ * tables de `PieceShape` : toute taille de pièce est acceptée, la marge autour
+ * du plateau s'agrandit pour les pièces de grande portée.
+ */
+class MoveSearch {
+public:
+    MoveSearch(int width, int height);
+
+    /// Met à jour la grille (`Board` ou `StandardBoard`) ; le cache n'est vidé que si elle a changé.
+    template <class BoardT>
+    void setBoard(const BoardT& board);
+
+    /// Poses atteignables depuis `start` (une par ensemble de cases, coût minimal).
+    const std::vector<Placement>& placements(const Tetromino& start);
+
+    /// Coût minimal pour poser `start` sur les cases `blocks` (-1 si inatteignable).
+    int keysFor(const Tetromino& start, const Cells& blocks);
+
+    /// Touches successives menant à `p` (valable jusqu'au prochain changement de grille) ;
+    /// des touches identiques consécutives (hors rotation) forment un seul appui maintenu.
+    std::vector<Key> path(const Placement& p) const;
+
+    std::uint64_t getSearches() const { return searches; }
+    std::uint64_t getCacheHits() const { return cacheHits; }
+
+private:
+    static constexpr int MIN_PAD = 4;
+    static constexpr int HELD_KINDS = 4;   ///< Aucune, gauche, droite, bas
+
+    struct Graph {
+        bool valid = false;
+        const PieceShape* shape = nullptr;
+        Cells start;                            ///< Cases de la pièce de départ
+        std::array<Cells, 4> shapes{};          ///< Décalages au pivot, par quart de tour depuis le départ
+        int rotations = 4;
+        std::vector<std::uint8_t> dist;
+        std::vector<std::int32_t> parent;
+        std::vector<Key> via;
+        std::vector<Placement> placements;
+    };
+
+    void build(Graph& g, const Tetromino& start);
+    void setPad(int p);
+    bool collides(const Graph& g, int px, int py, int r) const;
+    std::uint32_t index(int px, int py, int r, int held) const;
+    void decode(std::uint32_t s, int& px, int& py, int& r, int& held) const;
+
+    int width;
+    int height;
+    int pad = MIN_PAD;                     ///< Marge autour du plateau (portée maximale des pièces)
+    int stateCount;
+    std::vector<std::uint64_t> rows;       ///< Bit x : case (x, y) occupée
+    std::vector<Graph> graphs;             ///< Par identifiant de pièce
+
+    // Tampons réutilisés d'une recherche à l'autre
+    std::vector<std::uint8_t> blocked;     ///< Par (x, y, rotation) : position en collision
+    std::vector<std::uint32_t> frontier, nextFrontier;
+    std::vector<int> bestAt;
+    std::vector<std::uint32_t> bestFrom;
+
+    std::uint64_t searches = 0;
+    std::uint64_t cacheHits = 0;
+};
+
+#endif // MOVESEARCH_HPP
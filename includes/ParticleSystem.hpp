@@ -0,0 +1,55 @@
+#ifndef PARTICLESYSTEM_HPP
+#define PARTICLESYSTEM_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "GameWindow.hpp"
+
+/**
+ * @brief Effets de particules (lignes effacées, chute instantanée, niveau).
+ *
+ * Les particules sont stockées en structure de tableaux (un tableau contigu
+ * par attribut) de capacité fixe : la boucle d'intégration ne contient ni
+ * branche ni appel et se vectorise. Toute la mémoire (y compris les sommets)
+ * est réservée à la construction ; plus aucune allocation ensuite.
+ * L'ensemble est dessiné en un seul appel `draw` d'un `sf::VertexArray`.
+ */
+class ParticleSystem {
+public:
+    explicit ParticleSystem(std::size_t capacity);
+
+    void update(float dt);
+    void draw(GameWindow& target);
+    void clear() { count = 0; }
+
+    /// Éclats le long des lignes effacées (bit `y` de `rowMask` : ligne `y`).
+    void emitLineClear(std::uint32_t rowMask, int boardWidth, int tileSize);
+    /// Poussière au point d'impact et traînée sur la hauteur de chute.
+    void emitHardDrop(int minX, int maxX, int bottomY, int distance, int tileSize);
+    /// Gerbe depuis le bas du plateau.
+    void emitLevelUp(int boardWidth, int boardHeight, int tileSize);
+
+    std::size_t size() const { return count; }
+    std::size_t getCapacity() const { return capacity; }
+
+private:
+    void spawn(float px, float py, float pvx, float pvy, float lifetime, float size, sf::Color color);
+    float random();                     ///< Uniforme dans [0, 1)
+
+    std::size_t capacity;
+    std::size_t count = 0;
+
+    // Structure de tableaux
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> life;            ///< Temps restant (s)
+    std::vector<float> invLifetime;     ///< 1 / durée de vie initiale
+    std::vector<float> halfSize;
+    std::vector<sf::Color> color;
+
+    sf::VertexArray vertices;
+    std::uint32_t rngState = 0x9E3779B9u;
+};
+
+#endif // PARTICLESYSTEM_HPP
@@ -0,0 +1,114 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace perf {
+
+    /// Compteurs matériels suivis.
+    enum class Event : std::uint8_t {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+    };
+
+    constexpr std::size_t EVENT_COUNT = 4;
+
+    /// Valeurs cumulées des compteurs (ou différence entre deux lectures).
+    struct Reading {
+        std::array<std::uint64_t, EVENT_COUNT> values{};
+        std::uint64_t ns = 0;           ///< Temps réel
+
+        std::uint64_t operator[](Event e) const { return values[static_cast<std::size_t>(e)]; }
+        Reading& operator+=(const Reading& other);
+        friend Reading operator-(const Reading& a, const Reading& b);
+    };
+
+    /**
+     * @brief Compteurs matériels du thread appelant, ouverts par `perf_event_open` (Linux).
+     *
+     * - Les quatre compteurs forment un groupe : ils sont programmés ensemble
+     *   sur le processeur et lus d'un seul appel système.
+     * - Seul le code utilisateur est compté : cela suffit avec le réglage par
+     *   défaut de `perf_event_paranoid` (2) et les appels système (affichage,
+     *   fichiers) n'y sont pas mêlés.
+     * - Si le processeur doit partager ses compteurs (multiplexage), les
+     *   valeurs sont extrapolées au temps total d'activation.
+     *
+     * Un compteur refusé (machine virtuelle, autre système...) reste à zéro et
+     * `has()` le signale. Les threads créés ensuite ne sont pas comptés.
+     */
+    class Counters {
+    public:
+        Counters();
+        ~Counters();
+
+        Counters(const Counters&) = delete;
+        Counters& operator=(const Counters&) = delete;
+
+        bool available() const { return leader >= 0; }
+        bool has(Event e) const { return fds[static_cast<std::size_t>(e)] >= 0; }
+        /// Raison de l'échec si aucun compteur n'a pu être ouvert.
+        const std::string& error() const { return failure; }
+
+        Reading read() const;
+
+    private:
+        std::array<int, EVENT_COUNT> fds;
+        int leader = -1;
+        int opened = 0;                 ///< Compteurs du groupe, dans l'ordre d'ouverture des événements
+        std::string failure;
+    };
+
+    /// Compteurs du thread appelant (ouverts au premier appel, fermés avec le thread).
+    Counters& threadCounters();
+
+    /**
+     * @brief Journal CSV des compteurs par phase : une ligne par phase et par image.
+     *
+     * Colonnes : `image,phase,cycles,instructions,cache_misses,branch_misses,ns`
+     * (un compteur indisponible laisse sa colonne vide). `start()` et `lap()`
+     * lisent les compteurs du thread appelant : un journal ne sert qu'à un thread,
+     * les mesures faites ailleurs sont ajoutées par `add()`.
+     */
+    class Log {
+    public:
+        /// Ouvre le fichier et les compteurs ; false si le fichier ne peut être créé.
+        bool open(const std::string& path);
+        bool isOpen() const { return enabled; }
+
+        /// Point de départ de la prochaine phase.
+        void start() { if (enabled) mark = threadCounters().read(); }
+        /// Écrit la phase écoulée depuis le point de départ, qui est repris ensuite.
+        void lap(std::string_view phase);
+        void add(std::string_view phase, const Reading& delta);
+        void nextFrame() { frame++; }
+
+        /// Totaux par phase : IPC, défauts de cache et erreurs de branchement pour 1000 instructions
+        /// (le format de `stream` n'est pas modifié).
+        void report(std::ostream& stream) const;
+
+    private:
+        struct Total {
+            std::string phase;
+            Reading sum;
+            long rows = 0;
+        };
+
+        std::ofstream file;
+        bool enabled = false;
+        std::array<bool, EVENT_COUNT> present{};
+        long frame = 0;
+        Reading mark;
+        std::vector<Total> totals;
+    };
+}
+
+#endif // PERF_COUNTERS_HPP
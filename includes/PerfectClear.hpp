@@ -0,0 +1,108 @@
+#ifndef PERFECT_CLEAR_HPP
+#define PERFECT_CLEAR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Board.hpp"
+#include "PieceSet.hpp"
+
+namespace bot {
+
+    /// Réglages de la recherche de grille vide.
+    struct ClearConfig {
+        int maxPieces = 10;         ///< Pièces de la suite utilisables au plus
+        int maxHeight = 6;          ///< Lignes du bas à effacer au plus (jusqu'à `PerfectClear::MAX_HEIGHT`)
+        unsigned threads = 0;       ///< Threads, appelant compris (0 : un par cœur)
+        double budgetMs = 0.0;      ///< Temps maximal (0 : sans limite)
+    };
+
+    /// Résultat d'une recherche.
+    struct ClearResult {
+        bool found = false;
+        bool timedOut = false;          ///< Budget épuisé avant la fin : `found` faux ne prouve rien
+        std::vector<Cells> placements;  ///< Cases de chaque pose, dans les coordonnées de la grille du moment
+        int height = 0;                 ///< Lignes effacées par la solution
+        std::uint64_t nodes = 0;        ///< Grilles développées
+        std::uint64_t memoHits = 0;     ///< Échecs repris du cache
+        std::uint64_t pruned = 0;       ///< Grilles écartées par le décompte des cases vides
+        double ms = 0.0;
+    };
+
+    /**
+     * @brief Cherche une suite de poses qui vide entièrement la grille (perfect clear),
+     * avec les pièces connues, dans l'ordre, sans réserve.
+     *
+     * - Pour chaque hauteur h possible (pile comprise), le nombre de pièces est
+     *   imposé : leurs cases doivent remplir exactement les h lignes du bas. Aucune
+     *   case ne peut dépasser ces h lignes.
+     * - Grille en lignes de bits ; les positions atteignables d'une pièce sont
+     *   calculées par masques (une ligne de positions par rotation et par hauteur),
+     *   avec les règles de `MoveSearch` : déplacements, descente, rotation autour
+     *   du pivot sans décalage, gravité ignorée.
+     * - Coupure : les cases vides forment des groupes de colonnes (deux colonnes
+     *   voisines sont liées si une ligne a ses deux cases vides) ; effacer une
+     *   ligne ne déplace pas les colonnes, donc chaque groupe doit être rempli par
+     *   des pièces entières. Avec des pièces de même taille, chaque groupe doit en
+     *   être un multiple.
+     * - Les échecs sont mémorisés (grille, profondeur) dans un cache par thread.
+     * - Les poses de la première pièce sont réparties entre les threads ; la
+     *   solution retenue est celle de la première pose qui réussit, dans l'ordre :
+     *   le résultat ne dépend pas du nombre de threads.
+     */
+    class PerfectClear {
+    public:
+        static constexpr int MAX_HEIGHT = 8;
+        static constexpr int MAX_WIDTH = 16;
+
+        /**
+         * @param pieces Pièces désignées par les identifiants de la suite (doit survivre au solveur).
+         * @throws std::invalid_argument Si le plateau dépasse `MAX_WIDTH` colonnes.
+         */
+        PerfectClear(int width, int height, const PieceSet& pieces, ClearConfig config = {});
+
+        /**
+         * @param sequence Pièces à venir, la pièce courante en premier.
+         */
+        template <class BoardT>
+        ClearResult solve(const BoardT& board, std::span<const PieceId> sequence);
+
+        /// Interrompt une recherche en cours depuis un autre thread (elle rend `timedOut`).
+        void cancel() { cancelled = true; }
+
+        const ClearConfig& getConfig() const { return config; }
+
+    private:
+        /// Lignes de la zone, celle du bas en premier (bit x : colonne x).
+        using Field = std::array<std::uint32_t, MAX_HEIGHT>;
+
+        struct Drop {
+            Field cells{};          ///< Cases de la pièce posée
+            int top = 0;            ///< Ligne la plus haute occupée (+1)
+        };
+
+        struct Worker;
+
+        void placements(const Field& field, int height, PieceId piece, std::vector<Drop>& out) const;
+        bool search(Worker& w, const Field& field, int height, std::size_t depth) const;
+        bool viable(const Field& field, int height) const;
+
+        int width;
+        int boardHeight;
+        const PieceSet& pieces;
+        ClearConfig config;
+        std::uint32_t fullRow;
+
+        // Recherche en cours (lues par tous les threads)
+        std::span<const PieceId> sequence;
+        std::size_t used = 0;               ///< Pièces de la hauteur en cours de recherche
+        int uniformCells = 0;               ///< Taille commune des pièces de la suite (0 : tailles mêlées)
+        std::atomic<bool> cancelled{false};
+        mutable std::atomic<bool> expired{false};   ///< Budget dépassé (signalé pendant la recherche)
+        std::atomic<int> bestRoot{0};       ///< Plus petite pose de départ qui a réussi
+    };
+}
+
+#endif // PERFECT_CLEAR_HPP
@@ -0,0 +1,65 @@
+#ifndef PIECE_SET_HPP
+#define PIECE_SET_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "FixedVector.hpp"
+
+/// Nombre maximal de cases d'une pièce.
+constexpr std::size_t MAX_CELLS = 8;
+
+/// Cases d'une pièce, stockées sur place.
+using Cells = FixedVector<sf::Vector2i, MAX_CELLS>;
+
+/// Indice d'une pièce dans son jeu de pièces.
+using PieceId = std::uint8_t;
+
+/**
+ * @brief Forme d'une pièce et ses rotations, calculées au chargement.
+ */
+struct PieceShape {
+    PieceId id = 0;
+    std::string name;
+    sf::Color color;
+    Cells cells;                        ///< Cases à l'apparition (x relatif à la colonne de départ)
+    int pivot = 0;                      ///< Indice de la case autour de laquelle la pièce tourne
+    int rotations = 1;                  ///< 4, ou 1 pour une pièce qui ne tourne pas
+    int reach = 0;                      ///< Plus grand écart d'une case au pivot (toutes rotations)
+    std::array<Cells, 4> offsets;       ///< Par quart de tour : décalage de chaque case au pivot
+};
+
+/**
+ * @brief Jeu de pièces (polyominos) lu dans un fichier texte.
+ *
+ * Une pièce par ligne : un nom, une couleur `R,G,B`, puis ses cases `x,y`.
+ * La case précédée de `*` est le pivot ; sans pivot, la pièce ne tourne pas.
+ * @code
+ * # nom  couleur      cases
+ * T      255,0,255    1,1 *1,2 0,2 0,3
+ * O      255,255,0    0,1 1,1 0,2 1,2
+ * @endcode
+ * Chaque quart de tour fait tourner les cases de 90° dans le sens horaire
+ * autour du pivot ; les quatre orientations sont précalculées.
+ */
+class PieceSet {
+public:
+    /// Les 7 tétrominos, dans l'ordre de `TetrominoType`.
+    static const PieceSet& standard();
+
+    /// Lit un jeu de pièces ; en cas d'échec, `error` indique la ligne fautive.
+    static std::optional<PieceSet> load(const std::string& path, std::string& error);
+    static std::optional<PieceSet> parse(std::string_view text, const std::string& source, std::string& error);
+
+    std::size_t size() const { return shapes.size(); }
+    const PieceShape& operator[](std::size_t i) const { return shapes[i]; }
+
+private:
+    std::vector<PieceShape> shapes;
+};
+
+#endif // PIECE_SET_HPP
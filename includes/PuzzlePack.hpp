@@ -0,0 +1,108 @@
+#ifndef PUZZLE_PACK_HPP
+#define PUZZLE_PACK_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Board.hpp"
+#include "MappedFile.hpp"
+#include "Tetromino.hpp"
+
+/**
+ * @brief Paquets de puzzles : grilles de départ et suites de pièces imposées.
+ *
+ * Format d'un paquet (petit-boutiste) :
+ * @code
+ * PackHeader                     24 octets
+ * enregistrements                pour chaque puzzle :
+ *     height × rowBytes octets   lignes de bits (bit x de l'octet x/8), de haut en bas
+ *     pieceCount octets          types des pièces (0..6, ordre de TetrominoType)
+ * IndexEntry[count]              16 octets chacun, à indexOffset (aligné sur 8)
+ * @endcode
+ *
+ * Le paquet est projeté en mémoire ; un puzzle n'est décodé en `Board`
+ * qu'au moment où il est choisi. L'ouverture ne lit que l'en-tête.
+ */
+namespace puzzle {
+
+    constexpr std::uint32_t PACK_MAGIC = 0x4C5A5054;   ///< "TPZL"
+    constexpr std::uint16_t FORMAT_VERSION = 1;
+    constexpr int MAX_WIDTH = 32;
+
+    struct PackHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t width;
+        std::uint16_t height;
+        std::uint16_t reserved;
+        std::uint32_t count;
+        std::uint64_t indexOffset;
+    };
+    static_assert(sizeof(PackHeader) == 24, "PackHeader doit faire 24 octets");
+
+    struct IndexEntry {
+        std::uint64_t offset;       ///< Début de l'enregistrement dans le fichier
+        std::uint16_t pieceCount;
+        std::uint16_t goalLines;    ///< Lignes à effacer pour réussir
+        std::uint32_t reserved;
+    };
+    static_assert(sizeof(IndexEntry) == 16, "IndexEntry doit faire 16 octets");
+
+    /// Puzzle décodé, prêt à être joué.
+    struct Puzzle {
+        std::uint32_t index = 0;
+        Board board;
+        std::vector<TetrominoType> pieces;
+        int goalLines = 1;
+    };
+
+    /// Couleur des cases pré-remplies.
+    inline const sf::Color GARBAGE_COLOR(128, 128, 128);
+
+    /**
+     * @brief Paquet de puzzles projeté en mémoire (lecture seule).
+     */
+    class Pack {
+    public:
+        explicit Pack(const std::string& path);
+
+        /// En-tête valide et index entièrement contenu dans le fichier.
+        bool isValid() const { return valid; }
+        std::uint32_t size() const { return valid ? header().count : 0; }
+        int getWidth() const { return valid ? header().width : 0; }
+        int getHeight() const { return valid ? header().height : 0; }
+
+        /// Décode le puzzle `i` ; vide si l'indice ou l'enregistrement est invalide.
+        std::optional<Puzzle> load(std::uint32_t i) const;
+
+    private:
+        const PackHeader& header() const { return *reinterpret_cast<const PackHeader*>(file.data()); }
+
+        MappedFile file;
+        bool valid = false;
+    };
+
+    /**
+     * @brief Écrit un paquet puzzle par puzzle ; l'index est ajouté par `finish()`.
+     */
+    class PackWriter {
+    public:
+        PackWriter(const std::string& path, int width, int height);
+
+        bool isOpen() const { return out.good(); }
+        void add(const Board& board, const std::vector<TetrominoType>& pieces, int goalLines);
+        bool finish();
+
+    private:
+        std::ofstream out;
+        int width;
+        int height;
+        std::uint64_t offset;
+        std::vector<IndexEntry> index;
+        std::vector<unsigned char> record;
+    };
+}
+
+#endif // PUZZLE_PACK_HPP
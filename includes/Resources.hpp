@@ -0,0 +1,17 @@
+#ifndef RESOURCES_HPP
+#define RESOURCES_HPP
+
+#include <cstddef>
+
+/**
+ * @brief Ressources binaires compilées dans l'exécutable.
+ *
+ * Les définitions sont générées à la compilation par `cmake/EmbedResource.cmake`.
+ */
+namespace resources {
+    /// Police par défaut (DejaVu Sans, voir assets/fonts/LICENSE).
+    extern const unsigned char defaultFontData[];
+    extern const std::size_t defaultFontSize;
+}
+
+#endif // RESOURCES_HPP
@@ -0,0 +1,239 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <vector>
+#include "Board.hpp"
+#include "Gravity.hpp"
+#include "MoveSearch.hpp"
+#include "PieceSet.hpp"
+#include "PuzzlePack.hpp"
+#include "Tetromino.hpp"
+#include "Timeline.hpp"
+#include "UndoJournal.hpp"
+
+/// Commandes envoyées par le thread d'affichage à la simulation.
+enum class Command : std::uint8_t {
+    MoveLeft,
+    MoveRight,
+    Rotate,
+    SoftDropPress,
+    SoftDropRelease,
+    HardDrop,
+    Undo,           ///< Mode entraînement : annule la dernière pose
+    Pause,
+    Resume,
+    Reset           ///< Nouvelle partie, numérotée par `gameId`
+};
+
+struct InputCommand {
+    Command type = Command::Pause;
+    std::uint32_t gameId = 0;
+    bool repeat = false;        ///< Répétition automatique d'une touche maintenue
+};
+
+/// Événements de jeu produits par la simulation (télémétrie, effets...).
+struct GameEvent {
+    enum class Type : std::uint8_t {
+        PiecePlaced,    ///< value : hauteur de la pile après la pose
+        LinesCleared,   ///< value : nombre de lignes, extra : masque des lignes (bit y)
+        HardDropped,    ///< value : lignes parcourues, extra : colonnes min | max << 8 | ligne basse << 16
+        Finesse,        ///< value : appuis utilisés pour la pièce, extra : minimum possible
+        PuzzleEnded,    ///< value : 1 si réussi, 0 sinon ; extra : numéro du puzzle
+        LevelChanged,   ///< value : nouveau niveau
+        GameOver,       ///< value : score final, extra : niveau final
+        Undone          ///< Mode entraînement, pose annulée ; value : lignes rendues, extra : 1 si le niveau a baissé
+    };
+
+    Type type = Type::PiecePlaced;
+    std::uint32_t gameId = 0;
+    std::uint64_t tick = 0;
+    int value = 0;
+    int extra = 0;
+};
+
+/// Mesures du thread de simulation (durée de calcul et retard des ticks).
+struct SimTimings {
+    std::uint64_t steps = 0;         ///< Tours de boucle de simulation
+    std::uint64_t busyUs = 0;        ///< Temps de calcul cumulé
+    std::uint32_t lastBusyUs = 0;
+    std::uint32_t maxBusyUs = 0;
+    std::uint32_t maxLateUs = 0;     ///< Plus grand retard d'un tick sur son échéance
+    std::uint64_t lateSteps = 0;     ///< Ticks démarrés avec plus d'une période de retard
+
+    void report(std::ostream& out) const;
+};
+
+/**
+ * @brief État immuable de la partie publié par la simulation pour l'affichage.
+ *
+ * @tparam BoardT Grille de la partie, celle de la simulation qui le publie.
+ */
+template <class BoardT>
+struct BasicSnapshot {
+    BasicSnapshot(int width, int height);
+
+    std::uint32_t gameId = 0;
+    std::uint64_t tick = 0;
+
+    BoardT board;
+    Tetromino current;
+    Tetromino ghost;
+    Tetromino next;
+
+    int score = 0;
+    int level = 1;
+    int lines = 0;
+
+    bool waiting = false;            ///< Pièce suivante pas encore en jeu (délai d'apparition)
+    bool clearing = false;           ///< Effet d'effacement en cours (la partie continue)
+    float clearPhase = 0.f;          ///< Avancement de l'effet, de 0 à 1
+    std::vector<int> clearedRows;    ///< Lignes effacées par l'effet en cours
+    bool gameOver = false;
+    bool running = false;
+
+    int piecesLeft = -1;             ///< Mode puzzle : pièces restantes, pièce courante comprise (-1 : partie normale)
+    int goalLines = 0;               ///< Mode puzzle : lignes à effacer
+    int undoDepth = -1;              ///< Mode entraînement : poses annulables (-1 : désactivé)
+
+    int deadTicks = 0;               ///< Ticks sans pièce en jeu depuis le début de la partie
+    int clearDeadTicks = 0;          ///< Dont ceux qui suivent un effacement de lignes
+    int clears = 0;                  ///< Poses qui ont effacé des lignes
+
+    SimTimings timings;
+
+    void reportDeadTime(std::ostream& out) const;
+};
+
+/**
+ * @brief Règles du jeu à pas fixe, sans fenêtre ni horloge.
+ *
+ * La simulation avance uniquement par `tick()` (1/60 s) et reçoit les actions
+ * du joueur par `apply()`. Elle ne dépend ni de SFML Window ni du temps réel,
+ * ce qui la rend déterministe pour une graine donnée.
+ *
+ * Les suites minutées (apparition différée, fin de l'effet d'effacement) sont
+ * des tâches de la `timeline::Timeline` de la partie, avancée par `tick()`.
+ *
+ * La grille est un paramètre : `Simulation` joue sur la grille 10 x 20 fixée à
+ * la compilation (`StandardBoard`), `BasicSimulation<Board>` sur toute autre taille.
+ * Seules ces deux variantes sont instanciées, dans Simulation.cpp.
+ */
+template <class BoardT>
+class BasicSimulation {
+public:
+    BasicSimulation(int width, int height, std::uint32_t seed);
+
+    void apply(const InputCommand& cmd);
+    /// Applique un chemin de `MoveSearch` (touches identiques consécutives : appui maintenu ; descente comprise).
+    void play(const std::vector<Key>& keys);
+    void tick();
+
+    /// Puzzle joué à partir du prochain `Reset` (aucun : partie normale).
+    void setPuzzle(std::optional<puzzle::Puzzle> p) { activePuzzle = std::move(p); }
+    /// Mode entraînement (annulation des poses) à partir du prochain `Reset`, hors puzzle.
+    void setPractice(bool enabled) { practiceRequested = enabled; }
+    /// Nouvelle graine du tirage ; la partie en cours recommence avec elle.
+    void reseed(std::uint32_t seed) { rng.seed(seed); reset(gameId); }
+    /// Pièces tirées hors puzzle (le jeu doit survivre à la simulation) ; la partie recommence.
+    void setPieceSet(const PieceSet& set) { pieces = &set; reset(gameId); }
+    /// Délais de verrouillage, d'apparition et d'effacement (pris en compte à la pose suivante).
+    void setDelays(const gravity::Delays& d) { delays = d; }
+    /// Mesure de la finesse à chaque pose (une recherche de chemins) ; activée par défaut.
+    void setFinesse(bool enabled) { finesse = enabled; }
+    void writeSnapshot(BasicSnapshot<BoardT>& out) const;
+
+    const std::vector<GameEvent>& events() const { return pendingEvents; }
+    void clearEvents() { pendingEvents.clear(); }
+
+    bool isRunning() const { return running && !gameOver; }
+    bool isGameOver() const { return gameOver; }
+    /// Vrai entre une pose et l'apparition de la pièce suivante.
+    bool isWaiting() const { return waiting; }
+    std::uint64_t getTick() const { return tickCount; }
+
+private:
+    void reset(std::uint32_t id);
+    void applyGravity();
+    void lockPiece();
+    int clearLines();
+    timeline::Task spawnAfter(int ticks);
+    timeline::Task endClearEffect(std::uint32_t effect);
+    void spawnNext();
+    void recordPlacement();
+    void undo();
+    void updateScore(int linesCleared);
+    bool checkPuzzleEnd();
+    Tetromino randomPiece();
+    Tetromino drawPiece();
+    Tetromino computeGhost() const;
+    void emit(GameEvent::Type type, int value, int extra = 0);
+
+    BoardT board;
+    const PieceSet* pieces = &PieceSet::standard();
+    std::mt19937 rng;
+    Tetromino current;
+    Tetromino next;
+    Tetromino spawned;              ///< Pièce courante telle qu'apparue (référence de la finesse)
+    int pieceKeys = 0;              ///< Appuis du joueur depuis l'apparition
+    bool finesse = true;            ///< Événement Finesse à chaque pose
+
+    MoveSearch search;
+
+    std::uint32_t gameId = 0;
+    std::uint64_t tickCount = 0;
+    bool running = false;
+
+    int score = 0;
+    int level = 1;
+    int totalLinesCleared = 0;
+
+    int gravityAccumulator = 0;     ///< Fraction de ligne due (virgule fixe Q16)
+    int lockTicks = 0;              ///< Ticks passés posé sur la pile
+    bool softDrop = false;          ///< Flèche bas maintenue
+
+    gravity::Delays delays;
+    timeline::Timeline clock;       ///< Horloge des tâches minutées, avancée à chaque tick
+    bool waiting = false;           ///< Pose faite, pièce suivante attendue
+    bool waitAfterClear = false;    ///< L'attente suit un effacement de lignes
+    bool gameOver = false;
+
+    // Effet d'effacement : lignes à faire clignoter, par-dessus la partie
+    std::vector<int> effectRows;
+    std::uint64_t effectStart = 0;
+    std::uint32_t effectId = 0;     ///< Numéro de l'effet en cours (un effet plus récent le remplace)
+
+    int deadTicks = 0;
+    int clearDeadTicks = 0;
+    int clears = 0;
+
+    std::optional<puzzle::Puzzle> activePuzzle;
+    std::size_t puzzleNext = 0;     ///< Prochaine pièce à tirer de la suite imposée
+    int piecesLeft = -1;
+
+    // Mode entraînement : chaque pose est journalisée pour pouvoir l'annuler
+    bool practiceRequested = false;
+    bool practice = false;
+    UndoJournal journal;
+    PlacementDelta delta;           ///< Pose en cours (cases, lignes effacées, points)
+    int scoreBefore = 0;
+    int levelBefore = 1;
+    std::vector<PieceId> replay;    ///< Pièces à retirer avant le hasard (rendues par les annulations)
+
+    std::vector<GameEvent> pendingEvents;
+};
+
+/// État publié par `Simulation` (grille 10 x 20).
+using GameSnapshot = BasicSnapshot<StandardBoard>;
+/// Simulation du jeu standard, sur la grille 10 x 20 fixée à la compilation.
+using Simulation = BasicSimulation<StandardBoard>;
+
+extern template struct BasicSnapshot<Board>;
+extern template struct BasicSnapshot<StandardBoard>;
+extern template class BasicSimulation<Board>;
+extern template class BasicSimulation<StandardBoard>;
+
+#endif // SIMULATION_HPP
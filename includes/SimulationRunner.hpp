@@ -0,0 +1,77 @@
+#ifndef SIMULATION_RUNNER_HPP
+#define SIMULATION_RUNNER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include "Simulation.hpp"
+#include "SpscQueue.hpp"
+#include "StateFeed.hpp"
+#include "TripleBuffer.hpp"
+
+/**
+ * @brief Fait tourner la simulation sur son propre thread, à cadence fixe.
+ *
+ * - Les commandes du joueur arrivent par une file SPSC (thread d'affichage → simulation).
+ * - Après chaque tick, un état complet est publié dans un triple tampon sans verrou :
+ *   l'affichage dessine toujours le dernier état publié, sans jamais bloquer la simulation.
+ * - Les événements de jeu repartent par une seconde file SPSC (simulation → affichage).
+ *
+ * Un affichage lent ne retarde donc ni la gravité ni le traitement des commandes.
+ * Avec `setStateFeed()`, chaque état publié part aussi vers les observateurs externes.
+ */
+class SimulationRunner {
+public:
+    SimulationRunner(int width, int height, std::uint32_t seed);
+    ~SimulationRunner();
+
+    SimulationRunner(const SimulationRunner&) = delete;
+    SimulationRunner& operator=(const SimulationRunner&) = delete;
+
+    void start();
+    void stop();
+
+    // --- Côté affichage ---
+    bool send(const InputCommand& cmd) { return inputs.push(cmd); }
+    bool refresh() { return snapshots.update(); }
+    const GameSnapshot& snapshot() const { return snapshots.read(); }
+    bool pollEvent(GameEvent& e) { return events.pop(e); }
+    void setPuzzle(std::optional<puzzle::Puzzle> p);
+    /// Mode entraînement pour les prochaines parties (pris en compte au `Reset`).
+    void setPractice(bool enabled) { practice = enabled; }
+
+    // --- Côté simulation ---
+    void step();
+    /// Relance la partie avec une autre graine (thread arrêté uniquement).
+    void reseed(std::uint32_t seed);
+    /// Change le jeu de pièces et relance la partie (thread arrêté uniquement).
+    void setPieceSet(const PieceSet& set);
+    /// Délais de jeu de la simulation (thread arrêté uniquement).
+    void setDelays(const gravity::Delays& delays) { sim.setDelays(delays); }
+    /// Flux d'état écrit à chaque publication (thread arrêté uniquement ; doit survivre au thread).
+    void setStateFeed(feed::Writer* writer) { stateFeed = writer; }
+
+private:
+    void threadLoop();
+    void publish();
+
+    Simulation sim;
+    TripleBuffer<GameSnapshot> snapshots;
+    SpscQueue<InputCommand, 256> inputs;
+    SpscQueue<GameEvent, 1024> events;
+    SimTimings timings;
+    feed::Writer* stateFeed = nullptr;
+
+    // Puzzle remis à la simulation avant le prochain Reset (rare : un verrou suffit)
+    std::mutex puzzleMutex;
+    std::optional<puzzle::Puzzle> pendingPuzzle;
+    std::atomic<bool> puzzlePending{false};
+    std::atomic<bool> practice{false};
+
+    std::thread thread;
+    std::atomic<bool> stopRequested{false};
+};
+
+#endif // SIMULATION_RUNNER_HPP
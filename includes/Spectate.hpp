@@ -0,0 +1,139 @@
+#ifndef SPECTATE_HPP
+#define SPECTATE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "StateFeed.hpp"
+
+/**
+ * @brief Protocole de diffusion d'une partie aux spectateurs (outil `tetris-spectate`).
+ *
+ * Le flux TCP est une suite de messages `type (u8) | longueur (u16, petit-boutiste) | charge`.
+ * Les charges sont des champs de bits, bit de poids faible d'abord :
+ *
+ * - `Hello` : version, largeur et hauteur du plateau.
+ * - `Keyframe` : état complet (plateau, pièces, score...), envoyé à l'arrivée
+ *   d'un spectateur, à chaque nouvelle partie et après un retard rattrapé.
+ * - `Delta` : différences avec l'état précédemment diffusé, seulement s'il y en a :
+ *   - la pose de la pièce est rejouée chez le spectateur (fusion de la pièce à
+ *     sa position fantôme, puis effacement des lignes pleines, comme
+ *     `mergeTetromino` et `performClearLines`) : un bit au lieu des lignes décalées ;
+ *   - puis seules les lignes encore différentes sont envoyées ;
+ *   - une pièce qui tombe ou glisse ne coûte qu'un décalage (dx, dy).
+ *
+ * La pièce fantôme n'est pas transmise : le spectateur la déduit de la distance de chute.
+ */
+namespace spectate {
+
+    constexpr std::uint16_t DEFAULT_PORT = 7777;
+    constexpr std::uint8_t PROTOCOL_VERSION = 1;
+    constexpr std::size_t FRAME_HEADER = 3;
+
+    enum class MessageType : std::uint8_t {
+        Hello = 1,
+        Keyframe = 2,
+        Delta = 3,
+    };
+
+    /// Écriture de champs de bits à la suite d'une chaîne.
+    class BitWriter {
+    public:
+        explicit BitWriter(std::string& out) : out(out) {}
+        ~BitWriter() { flush(); }
+
+        void put(std::uint32_t value, int bits);
+        void putSigned(std::int32_t value, int bits) { put(static_cast<std::uint32_t>(value), bits); }
+        /// Entier par groupes de 7 bits, chacun suivi d'un bit « encore ».
+        void varint(std::uint32_t value);
+        /// Entier signé en zigzag (petits écarts, petites valeurs).
+        void zigzag(std::int32_t value) { varint((static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31)); }
+        /// Complète le dernier octet.
+        void flush();
+
+    private:
+        std::string& out;
+        std::uint64_t pending = 0;
+        int count = 0;
+    };
+
+    /// Lecture de champs de bits ; une lecture au-delà de la fin met `ok()` à false.
+    class BitReader {
+    public:
+        BitReader(const unsigned char* data, std::size_t size) : data(data), size(size) {}
+
+        std::uint32_t get(int bits);
+        std::int32_t getSigned(int bits);
+        std::uint32_t varint();
+        std::int32_t zigzag() { std::uint32_t v = varint(); return static_cast<std::int32_t>((v >> 1) ^ (0u - (v & 1))); }
+        bool ok() const { return valid; }
+
+    private:
+        const unsigned char* data;
+        std::size_t size;
+        std::size_t position = 0;      ///< En bits
+        bool valid = true;
+    };
+
+    /**
+     * @brief Côté serveur : produit les messages à partir des états successifs (`feed::Record`).
+     */
+    class Encoder {
+    public:
+        Encoder(int width, int height);
+
+        void hello(std::string& out) const;
+        void keyframe(const feed::Record& state, std::string& out) const;
+
+        /**
+         * @brief Message qui fait passer un spectateur de `previous` à `current`.
+         *
+         * Un changement de partie donne une image clé.
+         *
+         * @return false si seul le tick a changé (aucun message).
+         */
+        bool delta(const feed::Record& previous, const feed::Record& current, std::string& out) const;
+
+    private:
+        int width;
+        int height;
+    };
+
+    /**
+     * @brief Côté spectateur : reconstruit l'état à partir des octets reçus.
+     */
+    class Decoder {
+    public:
+        /**
+         * @brief Ajoute des octets reçus et applique tous les messages complets.
+         *
+         * @return false si le flux est invalide (à fermer).
+         */
+        bool receive(const char* bytes, std::size_t size);
+
+        /// Une image clé a été reçue : `state()` est complet.
+        bool ready() const { return hasKeyframe; }
+        const feed::Record& state() const { return current; }
+        int width() const { return boardWidth; }
+        int height() const { return boardHeight; }
+        std::uint64_t messages() const { return count; }
+
+    private:
+        bool apply(MessageType type, const unsigned char* payload, std::size_t size);
+
+        std::vector<char> buffer;
+        std::size_t consumed = 0;
+        feed::Record current{};
+        int boardWidth = 0;
+        int boardHeight = 0;
+        bool hasKeyframe = false;
+        std::uint64_t count = 0;
+    };
+
+    /// Fusionne la pièce fantôme dans les lignes puis retire les lignes pleines (comme le jeu à la pose).
+    void lockPiece(std::array<std::uint32_t, feed::MAX_SIZE>& rows, const feed::Piece& ghost, int width, int height);
+}
+
+#endif // SPECTATE_HPP
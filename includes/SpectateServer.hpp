@@ -0,0 +1,112 @@
+#ifndef SPECTATE_SERVER_HPP
+#define SPECTATE_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Spectate.hpp"
+#include "StateFeed.hpp"
+
+namespace spectate {
+
+    /// Compteurs du serveur depuis son démarrage.
+    struct ServerStats {
+        std::uint64_t ticks = 0;            ///< États reçus de la source
+        std::uint64_t deltas = 0;           ///< Messages delta produits (une fois pour tous)
+        std::uint64_t keyframes = 0;        ///< Images clés envoyées (par spectateur)
+        std::uint64_t bytes = 0;            ///< Octets envoyés, tous spectateurs
+        std::uint64_t keyframeBytes = 0;    ///< Dont images clés
+        std::uint64_t sends = 0;            ///< Appels à send()
+        std::uint64_t resyncs = 0;          ///< Spectateurs trop lents remis à niveau par une image clé
+        std::uint64_t accepted = 0;
+        double viewerSeconds = 0.0;         ///< Intégrale du nombre de spectateurs dans le temps
+        double cpuSeconds = 0.0;            ///< Temps CPU du thread du serveur
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Diffusion d'une partie à des spectateurs TCP locaux, sur un seul thread (epoll).
+     *
+     * - Chaque état de la source est comparé au dernier état diffusé : le delta
+     *   est encodé une seule fois, puis envoyé tel quel à chaque spectateur à jour
+     *   (un `send()` par spectateur et par message, sans copie tant qu'il suit).
+     * - Un spectateur dont le tampon d'envoi dépasse `MAX_BACKLOG` ne reçoit plus
+     *   de deltas ; une fois son retard écoulé, une image clé le remet à niveau.
+     *   Un spectateur lent ne retarde donc ni la source ni les autres.
+     * - Le serveur n'écoute que sur 127.0.0.1 ; les spectateurs n'envoient rien.
+     */
+    class Server {
+    public:
+        static constexpr std::size_t MAX_BACKLOG = 64 * 1024;
+
+        /// Résultat d'un appel à la source.
+        enum class Source { Updated, Idle, Stop };
+
+        /// En cas d'échec (port pris...), `isOpen()` retourne false et `error()` en donne la raison.
+        Server(int width, int height, std::uint16_t port);
+        ~Server();
+
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        bool isOpen() const { return epollFd >= 0; }
+        const std::string& error() const { return failure; }
+
+        /**
+         * @brief Boucle du serveur : `next` est appelé à `hz` par seconde (ticks en retard
+         * rattrapés, au plus `MAX_TICKS_PER_FRAME` d'un coup) et remplit l'état courant.
+         *
+         * @param reportSeconds Intervalle du bilan sur `std::clog` (0 : seulement à la fin).
+         */
+        void run(double hz, const std::function<Source(feed::Record&)>& next, double reportSeconds = 5.0);
+
+        /// Arrête `run()` (utilisable depuis un gestionnaire de signal).
+        static void requestStop() { stopRequested = true; }
+
+        const ServerStats& stats() const { return totals; }
+        std::size_t viewers() const { return clients.size(); }
+        /// Bilan depuis le démarrage : débit et CPU par spectateur.
+        void report(std::ostream& out) const;
+
+    private:
+        struct Client {
+            int fd = -1;
+            std::string pending;            ///< Octets pas encore acceptés par le noyau
+            std::size_t sent = 0;           ///< Déjà envoyés dans `pending`
+            bool resync = false;            ///< En retard : deltas suspendus jusqu'à l'image clé
+            bool writable = true;           ///< EPOLLOUT non demandé
+            bool closed = false;
+        };
+
+        void accept();
+        void broadcast(const feed::Record& state);
+        void queue(Client& c, const std::string& bytes);
+        void flush(Client& c);
+        void catchUp(Client& c);
+        void drop(Client& c);
+        void watchWrites(Client& c, bool enable);
+        void sweep();
+        void reportSince(const ServerStats& from, std::ostream& out) const;
+
+        Encoder encoder;
+        int listenFd = -1;
+        int epollFd = -1;
+        int timerFd = -1;
+        std::string failure;
+
+        std::vector<std::unique_ptr<Client>> clients;
+        feed::Record sent{};                ///< Dernier état diffusé (base des deltas)
+        bool hasState = false;
+        std::string message;                ///< Message en cours de diffusion, réutilisé
+        std::string keyframeBuffer;
+
+        ServerStats totals;
+        static inline std::atomic<bool> stopRequested{false};
+    };
+}
+
+#endif // SPECTATE_SERVER_HPP
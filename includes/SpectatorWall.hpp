@@ -0,0 +1,121 @@
+#ifndef SPECTATOR_WALL_HPP
+#define SPECTATOR_WALL_HPP
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Autoplayer.hpp"
+#include "GameWindow.hpp"
+#include "PerfCounters.hpp"
+#include "PieceSet.hpp"
+#include "Simulation.hpp"
+
+/**
+ * @brief Mur de spectateurs : de 16 à 64 parties de robots jouées et affichées ensemble.
+ *
+ * - À chaque image, toutes les parties avancent des ticks dus sur un groupe de
+ *   threads (chaque thread prend la prochaine partie non traitée, le thread
+ *   d'affichage compris), puis l'affichage lit leurs états.
+ * - Tous les plateaux sont écrits dans un seul tableau de sommets, et tous les
+ *   textes dans un second, construit directement à partir des glyphes de la
+ *   police : deux appels de dessin par image, quel que soit le nombre de parties.
+ *
+ * Une partie terminée reste affichée deux secondes puis recommence avec une autre graine.
+ * Avec un temps de réflexion, les robots anticipent les pièces suivantes (`bot::Lookahead`,
+ * un thread chacun : les parties sont déjà réparties sur les cœurs).
+ */
+class SpectatorWall {
+public:
+    static constexpr int MIN_GAMES = 16;
+    static constexpr int MAX_GAMES = 64;
+
+    /**
+     * @param games Nombre de parties (ramené entre `MIN_GAMES` et `MAX_GAMES`).
+     * @param seed Graine de la première partie ; les suivantes en dérivent.
+     * @param pieces Jeu de pièces des parties (doit survivre au mur).
+     * @param threads Threads de simulation, affichage compris (0 : un par cœur).
+     * @param thinkMs Temps de recherche par coup des robots (0 : choix immédiat, sans anticipation).
+     */
+    SpectatorWall(int games, std::uint32_t seed, const PieceSet& pieces, unsigned threads = 0, double thinkMs = 0.0);
+    ~SpectatorWall();
+
+    SpectatorWall(const SpectatorWall&) = delete;
+    SpectatorWall& operator=(const SpectatorWall&) = delete;
+
+    /**
+     * @brief Compteurs matériels par image : recherche des robots (tous threads confondus) et rendu.
+     *
+     * `log` doit avoir été ouvert sur le thread de `run()` et survivre au mur.
+     */
+    void setPerfLog(perf::Log* log) { perfLog = log; }
+
+    /// Boucle d'affichage jusqu'à la fermeture (ou `frames` images), puis bilan sur `std::clog`.
+    void run(long frames = 0);
+
+private:
+    struct Match {
+        Match(int width, int height, std::uint32_t seed, const PieceSet& pieces);
+
+        Simulation sim;
+        Autoplayer bot;
+        GameSnapshot snap;
+        std::uint32_t seed;
+        int every;                      ///< Ticks entre deux pièces jouées par le robot
+        int countdown = 0;
+        int overTicks = 0;              ///< Ticks passés sur l'écran de fin
+        int played = 0;                 ///< Parties terminées
+
+        // Recherche des coups (avec anticipation seulement)
+        long searches = 0;
+        long depthSum = 0;
+        std::uint64_t nodes = 0;
+        double searchMs = 0.0;
+        perf::Reading searchCounters;   ///< Compteurs des coups de l'image en cours (avec `perfLog`)
+    };
+
+    void workerLoop();
+    void stepMatches();
+    void stepMatch(Match& m);
+    void layout();
+    void render();
+    void appendQuad(sf::VertexArray& target, sf::FloatRect rect, sf::Color color, sf::FloatRect tex = {});
+    void appendText(std::string_view text, float x, float y, sf::Color color);
+
+    int boardWidth = 10;
+    int boardHeight = 20;
+
+    sf::Font font;
+    GameWindow window;
+    std::vector<std::unique_ptr<Match>> matches;
+
+    // Groupe de threads : une passe sur toutes les parties par image
+    unsigned threadCount;
+    std::vector<std::thread> workers;
+    std::barrier<> frameStart;
+    std::barrier<> frameDone;
+    std::atomic<std::size_t> nextMatch{0};
+    int pendingTicks = 0;               ///< Ticks à jouer par partie pendant la passe
+    bool stopping = false;
+
+    // Rendu groupé
+    sf::VertexArray cells{sf::Quads};   ///< Fonds, cases, pièces et voiles de fin
+    sf::VertexArray glyphs{sf::Quads};  ///< Textes (texture de la police)
+    int columns = 1;
+    float cellSize = 4.f;
+    sf::Vector2f tileSize;
+    std::string label;                  ///< Tampon des textes, réutilisé
+
+    perf::Log* perfLog = nullptr;
+
+    double stepMs = 0.0;                ///< Temps cumulé des passes de simulation
+    double renderMs = 0.0;
+    long framesShown = 0;
+};
+
+#endif // SPECTATOR_WALL_HPP
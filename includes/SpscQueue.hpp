@@ -0,0 +1,42 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief File circulaire sans verrou, un seul producteur et un seul consommateur.
+ *
+ * Capacité fixe (puissance de deux), aucune allocation après la construction.
+ * `push()` échoue si la file est pleine plutôt que de bloquer le producteur.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "La capacité doit être une puissance de deux");
+
+public:
+    bool push(const T& value) {
+        std::size_t tail = writeIndex.load(std::memory_order_relaxed);
+        if (tail - readIndex.load(std::memory_order_acquire) == Capacity) return false;
+        slots[tail & (Capacity - 1)] = value;
+        writeIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire)) return false;
+        out = slots[head & (Capacity - 1)];
+        readIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> slots{};
+    alignas(64) std::atomic<std::size_t> writeIndex{0};
+    alignas(64) std::atomic<std::size_t> readIndex{0};
+};
+
+#endif // SPSC_QUEUE_HPP
@@ -0,0 +1,37 @@
+#ifndef STARTUP_TRACE_HPP
+#define STARTUP_TRACE_HPP
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Chronologie du démarrage du jeu (jusqu'à la première image affichée).
+ *
+ * Chaque étape est horodatée par `mark()` ; `report()` affiche le temps
+ * écoulé depuis la construction et la durée de chaque étape.
+ */
+class StartupTrace {
+public:
+    StartupTrace();
+
+    void mark(const std::string& label);
+    void report(std::ostream& out) const;
+
+    /// Temps total écoulé jusqu'au dernier jalon (en millisecondes).
+    double totalMs() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Step {
+        std::string label;
+        Clock::time_point at;
+    };
+
+    Clock::time_point start;
+    std::vector<Step> steps;
+};
+
+#endif // STARTUP_TRACE_HPP
@@ -0,0 +1,145 @@
+#ifndef STATE_FEED_HPP
+#define STATE_FEED_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Déclarations seules : les lecteurs du flux n'ont besoin ni de SFML ni de la simulation
+template <int W, int H> class BasicBoard;
+template <class BoardT> struct BasicSnapshot;
+using GameSnapshot = BasicSnapshot<BasicBoard<10, 20>>;
+
+/**
+ * @brief Flux d'état en mémoire partagée POSIX, pour des observateurs locaux
+ * (incrustations, enregistreurs, analyseurs).
+ *
+ * La simulation écrit un enregistrement de taille fixe par tick dans un anneau
+ * de `CAPACITY` cases. L'écrivain ne lit jamais rien des lecteurs : il ne peut
+ * ni attendre ni ralentir, qu'il y ait zéro, un ou plusieurs lecteurs. Un
+ * lecteur trop lent perd les enregistrements écrasés et le sait.
+ *
+ * Chaque case est protégée par un numéro de séquence (seqlock) : impair pendant
+ * l'écriture de l'enregistrement n (2n + 1), pair une fois terminé (2n + 2).
+ * Le lecteur copie la case puis relit le numéro : s'il a changé, la copie est
+ * déchirée et jetée. Ni sérialisation ni appel système côté écrivain.
+ *
+ * @code
+ * Header (128 octets) | Slot[CAPACITY] (256 octets chacun)
+ * @endcode
+ *
+ * Les entiers sont dans l'ordre natif : lecteur et écrivain sont sur la même machine.
+ * Cet en-tête ne dépend que de la bibliothèque standard : un observateur peut l'inclure seul.
+ */
+namespace feed {
+
+    constexpr std::array<char, 4> MAGIC {'T', 'F', 'E', 'D'};
+    constexpr std::uint16_t FORMAT_VERSION = 1;
+    constexpr std::uint32_t CAPACITY = 256;     ///< Cases de l'anneau (un peu plus de 4 s de jeu)
+    constexpr int MAX_SIZE = 32;                ///< Largeur et hauteur maximales du plateau
+    constexpr std::size_t PIECE_CELLS = 8;      ///< Cases par pièce (`MAX_CELLS`, sans dépendre de SFML)
+
+    /// Bits de `Record::flags`.
+    enum Flag : std::uint32_t {
+        Running = 1u << 0,      ///< Partie en cours (ni en pause ni terminée)
+        GameOver = 1u << 1,
+        Waiting = 1u << 2,      ///< Pièce suivante pas encore en jeu (délai d'apparition)
+        Clearing = 1u << 3,     ///< Effet d'effacement de lignes en cours
+        Puzzle = 1u << 4,
+        Practice = 1u << 5,
+    };
+
+    /// Pièce : identifiant dans le jeu de pièces et cases (x, y) sur le plateau.
+    struct Piece {
+        std::uint8_t id;
+        std::uint8_t rotation;
+        std::uint8_t cellCount;
+        std::uint8_t reserved;
+        std::array<std::int8_t, 2 * PIECE_CELLS> cells;
+    };
+
+    /// État publié à chaque tick.
+    struct Record {
+        std::uint64_t tick;
+        std::uint32_t gameId;
+        std::uint32_t flags;
+        std::uint32_t score;
+        std::uint32_t level;
+        std::uint32_t lines;
+        std::uint32_t reserved;
+        // Mesures du thread de simulation (voir SimTimings)
+        std::uint32_t lastBusyUs;
+        std::uint32_t maxBusyUs;
+        std::uint32_t maxLateUs;
+        std::uint32_t lateSteps;
+        Piece current;
+        Piece ghost;
+        Piece next;                 ///< File d'attente (le jeu n'en montre qu'une pièce)
+        std::uint32_t reserved2;
+        std::array<std::uint32_t, MAX_SIZE> rows;  ///< Occupation du plateau : bit x de rows[y]
+    };
+
+    /// Case de l'anneau : une ligne de cache par 64 octets, jamais partagée entre deux cases.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> sequence;
+        Record record;
+    };
+
+    struct alignas(64) Header {
+        std::array<char, 4> magic;
+        std::uint16_t version;
+        std::uint16_t slotSize;
+        std::uint32_t capacity;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t producer;                     ///< pid de l'écrivain
+        alignas(64) std::atomic<std::uint64_t> published;   ///< Enregistrements terminés
+        std::atomic<std::uint32_t> alive;           ///< 0 quand l'écrivain a fermé le flux
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "Les compteurs partagés entre processus doivent être sans verrou");
+    static_assert(sizeof(Record) == 240 && sizeof(Slot) == 256 && sizeof(Header) == 128,
+                  "Le format du flux ne doit pas dépendre du compilateur");
+
+    constexpr std::size_t SEGMENT_BYTES = sizeof(Header) + CAPACITY * sizeof(Slot);
+
+    /// Remplit `out` à partir d'un état publié par la simulation (champs réservés à zéro).
+    void capture(Record& out, const GameSnapshot& snap);
+
+    /**
+     * @brief Côté jeu : crée le segment partagé et y écrit un enregistrement par appel.
+     *
+     * Le segment est supprimé à la destruction ; les lecteurs déjà attachés
+     * gardent leur projection et voient `alive` passer à 0.
+     */
+    class Writer {
+    public:
+        /**
+         * @param name Nom POSIX du segment (ex. "/tetris-feed"). En cas d'échec,
+         * `isOpen()` retourne false et `error()` en donne la raison.
+         */
+        Writer(const std::string& name, int width, int height);
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        bool isOpen() const { return header != nullptr; }
+        const std::string& error() const { return failure; }
+
+        /// Écrit l'état dans la case suivante (écrivain unique ; aucun appel système).
+        void publish(const GameSnapshot& snap);
+
+    private:
+        std::string name;
+        std::string failure;
+        Header* header = nullptr;
+        Slot* slots = nullptr;
+        std::uint64_t written = 0;
+    };
+}
+
+#endif // STATE_FEED_HPP
@@ -0,0 +1,52 @@
+#ifndef STATE_FEED_READER_HPP
+#define STATE_FEED_READER_HPP
+
+#include <cstdint>
+#include <string>
+#include "StateFeed.hpp"
+
+namespace feed {
+
+    /**
+     * @brief Côté observateur : projette le segment en lecture seule et suit l'anneau.
+     *
+     * Le lecteur n'écrit rien dans le segment : l'écrivain ignore son existence.
+     * S'il prend plus de `CAPACITY` enregistrements de retard, il saute au plus
+     * récent et compte les enregistrements perdus.
+     */
+    class Reader {
+    public:
+        enum class Status {
+            Record,     ///< Un enregistrement a été copié
+            Empty,      ///< Rien de nouveau pour l'instant
+            Closed      ///< L'écrivain a fermé le flux et tout a été lu
+        };
+
+        /// En cas d'échec, `isOpen()` retourne false et `error()` en donne la raison.
+        explicit Reader(const std::string& name);
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        bool isOpen() const { return header != nullptr; }
+        const std::string& error() const { return failure; }
+        const Header& info() const { return *header; }
+
+        /// Copie le prochain enregistrement (le premier lu est le plus récent au moment de l'ouverture).
+        Status next(Record& out);
+
+        std::uint64_t received() const { return count; }
+        std::uint64_t missed() const { return lost; }
+
+    private:
+        std::string failure;
+        const Header* header = nullptr;
+        const Slot* slots = nullptr;
+        std::uint64_t cursor = 0;       ///< Numéro du prochain enregistrement à lire
+        std::uint64_t count = 0;
+        std::uint64_t lost = 0;
+    };
+}
+
+#endif // STATE_FEED_READER_HPP
@@ -0,0 +1,170 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Télémétrie par partie : collecte en jeu et format de fichier colonnaire.
+ *
+ * Le fichier est une suite de segments ajoutés en fin de fichier. Chaque segment
+ * regroupe N parties et stocke chaque champ dans une colonne contiguë, alignée
+ * sur 8 octets, ce qui permet à l'outil `tetris-telemetry` de le lire directement
+ * via mmap. Les entiers sont stockés dans l'ordre natif (little-endian).
+ *
+ * @code
+ * SegmentHeader | ColumnDesc[columnCount] | colonne 1 | colonne 2 | ... | SegmentTrailer
+ * @endcode
+ *
+ * Le SegmentTrailer est écrit en dernier : un segment interrompu n'en a pas, ou
+ * son checksum ne correspond pas, et les lecteurs le sautent même si un autre
+ * segment a été ajouté derrière lui. Les segments de version 1 n'en ont pas.
+ */
+namespace telemetry {
+
+    constexpr std::array<char, 4> SEGMENT_MAGIC {'T', 'L', 'M', 'S'};
+    constexpr std::array<char, 4> SEGMENT_END {'T', 'L', 'M', 'E'};
+    constexpr std::uint16_t FORMAT_VERSION = 2;
+    /// Dernière version sans SegmentTrailer (encore lue).
+    constexpr std::uint16_t UNCHECKED_VERSION = 1;
+
+    /// Identifiants des colonnes (un lecteur ignore les colonnes inconnues).
+    enum class Column : std::uint16_t {
+        StartTime = 1,      ///< u64 : début de la partie (secondes Unix)
+        DurationMs,         ///< u32 : durée de jeu effective (pauses exclues)
+        Score,              ///< u32
+        FinalLevel,         ///< u32
+        Pieces,             ///< u32 : pièces posées
+        Lines,              ///< u32 : lignes effacées
+        Clears1,            ///< u32 : effacements d'une ligne
+        Clears2,            ///< u32 : effacements de deux lignes
+        Clears3,            ///< u32 : effacements de trois lignes
+        Clears4,            ///< u32 : effacements de quatre lignes (Tetris)
+        MaxStackHeight,     ///< u32 : hauteur maximale de la pile (en cases)
+        FrameCount,         ///< u32 : images jouées
+        FrameMeanUs,        ///< u32 : durée moyenne d'une image
+        FrameP50Us,         ///< u32
+        FrameP99Us,         ///< u32
+        FrameMaxUs,         ///< u32
+        PlacementOffsets,   ///< u64[N+1] : début des poses de chaque partie dans PlacementMs
+        PlacementMs,        ///< u32[] : instant de chaque pose (ms depuis le début de la partie)
+        LevelUpOffsets,     ///< u64[N+1] : début des changements de niveau de chaque partie
+        LevelUpMs,          ///< u32[] : instant du changement de niveau
+        LevelUpLevel        ///< u32[] : nouveau niveau
+    };
+
+    struct SegmentHeader {
+        std::array<char, 4> magic;
+        std::uint16_t version;
+        std::uint16_t columnCount;
+        std::uint32_t rowCount;
+        std::uint32_t reserved;
+        std::uint64_t segmentBytes;  ///< Taille totale du segment (en-tête compris)
+    };
+
+    struct ColumnDesc {
+        std::uint16_t id;
+        std::uint16_t elementSize;
+        std::uint32_t reserved;
+        std::uint64_t offset;        ///< Depuis le début du segment
+        std::uint64_t count;         ///< Nombre d'éléments
+    };
+
+    /// Marque de fin : occupe les 8 derniers octets du segment (compris dans segmentBytes).
+    struct SegmentTrailer {
+        std::array<char, 4> magic;
+        std::uint32_t checksum;      ///< FNV-1a des octets du segment qui précèdent
+    };
+
+    static_assert(sizeof(SegmentHeader) == 24 && sizeof(ColumnDesc) == 24 && sizeof(SegmentTrailer) == 8,
+                  "Le format du fichier ne doit pas dépendre du compilateur");
+
+    struct LevelUp {
+        std::uint32_t atMs;
+        std::uint32_t level;
+    };
+
+    /// Résumé des durées d'image d'une partie.
+    struct FrameSummary {
+        std::uint32_t count = 0;
+        std::uint32_t meanUs = 0;
+        std::uint32_t p50Us = 0;
+        std::uint32_t p99Us = 0;
+        std::uint32_t maxUs = 0;
+    };
+
+    /// Une partie complète (une ligne du fichier).
+    struct GameRecord {
+        std::uint64_t startTime = 0;
+        std::uint32_t durationMs = 0;
+        std::uint32_t score = 0;
+        std::uint32_t finalLevel = 1;
+        std::uint32_t lines = 0;
+        std::array<std::uint32_t, 4> clears{};
+        std::uint32_t maxStackHeight = 0;
+        FrameSummary frames;
+        std::vector<std::uint32_t> placementMs;
+        std::vector<LevelUp> levelUps;
+    };
+
+    /**
+     * @brief Histogramme à cases de largeur fixe (la dernière case reçoit les valeurs hors borne).
+     */
+    class Histogram {
+    public:
+        Histogram(double bucketWidth, std::size_t bucketCount);
+
+        void add(double value);
+        void merge(const Histogram& other);
+
+        std::uint64_t count() const { return total; }
+        double mean() const { return total ? sum / total : 0.0; }
+        double max() const { return maximum; }
+        double percentile(double p) const;
+
+    private:
+        double width;
+        std::vector<std::uint64_t> buckets;
+        std::uint64_t total = 0;
+        double sum = 0.0;
+        double maximum = 0.0;
+    };
+
+    /**
+     * @brief Collecte la télémétrie d'une partie pendant le jeu.
+     *
+     * Le temps de jeu avance avec `advance()` (appelé à chaque image jouée),
+     * les pauses et les menus ne sont donc pas comptés.
+     */
+    class Recorder {
+    public:
+        Recorder();
+
+        void begin();
+        bool isActive() const { return active; }
+
+        void advance(float dt);
+        void onPiecePlaced(int stackHeight);
+        void onLinesCleared(int count);
+        void onLevelChanged(int level);
+        void onUndone(int linesCleared, bool levelDown);
+
+        GameRecord finish(int score, int level);
+
+    private:
+        bool active = false;
+        double elapsedMs = 0.0;
+        GameRecord record;
+        Histogram frameTimes;
+    };
+
+    /// FNV-1a 32 bits de `size` octets (checksum du SegmentTrailer).
+    std::uint32_t checksum(const unsigned char* data, std::size_t size);
+
+    bool appendSegment(const std::string& path, const std::vector<GameRecord>& games);
+}
+
+#endif // TELEMETRY_HPP
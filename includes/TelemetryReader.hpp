@@ -0,0 +1,93 @@
+#ifndef TELEMETRY_READER_HPP
+#define TELEMETRY_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include "MappedFile.hpp"
+#include "Telemetry.hpp"
+
+namespace telemetry {
+
+    /**
+     * @brief Vue en lecture seule sur un segment projeté en mémoire.
+     *
+     * Les colonnes sont exposées sans copie sous forme de `std::span`.
+     */
+    class Segment {
+    public:
+        explicit Segment(const unsigned char* base);
+
+        std::uint32_t rows() const { return header().rowCount; }
+
+        /// Colonne `id` typée en T, vide si absente ou de taille d'élément différente.
+        template <typename T>
+        std::span<const T> column(Column id) const {
+            const ColumnDesc* d = find(id);
+            if (!d || d->elementSize != sizeof(T)) return {};
+            return {reinterpret_cast<const T*>(base + d->offset), static_cast<std::size_t>(d->count)};
+        }
+
+        GameRecord row(std::size_t i) const;
+
+        /// Vérifie que l'en-tête et toutes les colonnes tiennent dans `available` octets.
+        static bool isValid(const unsigned char* base, std::size_t available);
+
+        /// Vrai si `p` est la fin des données ou le début d'un en-tête de segment.
+        static bool isBoundary(const unsigned char* p, std::size_t available);
+
+    private:
+        const SegmentHeader& header() const { return *reinterpret_cast<const SegmentHeader*>(base); }
+        const ColumnDesc* find(Column id) const;
+
+        const unsigned char* base;
+    };
+
+    /**
+     * @brief Fichier de télémétrie projeté en mémoire, parcouru segment par segment.
+     */
+    class SegmentFile {
+    public:
+        explicit SegmentFile(const std::string& path) : file(path, MappedFile::Access::Sequential) {}
+
+        bool isOpen() const { return file.isOpen(); }
+        std::size_t size() const { return file.size(); }
+
+        /**
+         * @brief Appelle `f(const Segment&)` pour chaque segment valide.
+         *
+         * Un segment n'est lu que s'il est intact (SegmentTrailer) et que sa fin
+         * tombe sur la fin du fichier ou sur un en-tête. Sinon (segment tronqué,
+         * éventuellement suivi d'autres segments), la lecture reprend au prochain
+         * en-tête valide aligné sur 8 octets.
+         *
+         * @return Le nombre de segments lus.
+         */
+        template <typename F>
+        std::size_t forEachSegment(F&& f) const {
+            const unsigned char* data = file.data();
+            const std::size_t length = file.size();
+            std::size_t segments = 0;
+            std::size_t pos = 0;
+            while (pos + sizeof(SegmentHeader) <= length) {
+                const unsigned char* p = data + pos;
+                const std::size_t end = Segment::isValid(p, length - pos)
+                    ? pos + reinterpret_cast<const SegmentHeader*>(p)->segmentBytes : 0;
+                if (end != 0 && Segment::isBoundary(data + end, length - end)) {
+                    f(Segment(p));
+                    segments++;
+                    pos = end;
+                } else {
+                    pos += 8;
+                }
+            }
+            return segments;
+        }
+
+    private:
+        MappedFile file;
+    };
+}
+
+#endif // TELEMETRY_READER_HPP
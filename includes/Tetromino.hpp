@@ -1,27 +1,43 @@
 #ifndef TETROMINO_HPP
 #define TETROMINO_HPP
 
-#include <array>
 #include <SFML/Graphics.hpp>
+#include "GameWindow.hpp"
+#include "PieceSet.hpp"
 
+/// Tétrominos du jeu standard (indices dans `PieceSet::standard()`).
 enum class TetrominoType { I, O, T, S, Z, J, L };
 
+/**
+ * @brief Pièce en jeu : un polyomino d'un `PieceSet` (des tétrominos par défaut).
+ *
+ * Les cases sont stockées sur place (aucune allocation par pièce) et les
+ * rotations lues dans les tables précalculées de la forme.
+ *
+ * @warning La pièce pointe vers sa forme : le jeu de pièces doit lui survivre.
+ */
 class Tetromino {
 public:
     Tetromino(TetrominoType type, int startX);
+    Tetromino(const PieceShape& shape, int startX);
 
     void move(int dx, int dy);
     void rotate();
-    void draw(sf::RenderWindow& window, int tileSize);
-    std::array<sf::Vector2i, 4> getBlocks() const { return blocks; }
-    void setBlocks(const std::array<sf::Vector2i, 4>& b) { blocks = b; }
+    void draw(GameWindow& window, int tileSize) const;
+    const Cells& getBlocks() const { return blocks; }
+    /// Remplace les cases (pose calculée ailleurs) ; l'orientation mémorisée n'est pas modifiée.
+    void setBlocks(const Cells& b) { blocks = b; }
     inline void setColor(sf::Color c) { color = c; }
     inline sf::Color getColor() const { return color; }
+    inline PieceId getId() const { return shape->id; }
+    inline const PieceShape& getShape() const { return *shape; }
+    inline int getRotation() const { return rotation; }
 
 private:
-    TetrominoType type;
-    std::array<sf::Vector2i, 4> blocks;
+    const PieceShape* shape;
+    Cells blocks;
     sf::Color color;
+    std::uint8_t rotation = 0;
 };
 
-#endif // TETROMINO_HPP
\ No newline at end of file
+#endif // TETROMINO_HPP
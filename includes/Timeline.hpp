@@ -0,0 +1,91 @@
+#ifndef TIMELINE_HPP
+#define TIMELINE_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+/**
+ * @brief Ordonnanceur de coroutines sur l'horloge de la simulation.
+ *
+ * Les comportements minutés (apparition différée, effet d'effacement...) s'écrivent
+ * comme des tâches qui attendent des ticks, au lieu d'indicateurs et de compteurs
+ * testés à chaque tick :
+ * @code
+ * timeline::Task Simulation::spawnAfter(int ticks) {
+ *     co_await clock.delay(ticks);
+ *     spawnNext();
+ * }
+ * @endcode
+ * L'horloge n'avance que par `advance()` : en pause, les tâches attendent aussi,
+ * et l'ordre des reprises est déterministe.
+ */
+namespace timeline {
+
+    using Tick = std::uint64_t;
+
+    /**
+     * @brief Tâche sans résultat : elle démarre à l'appel et s'exécute jusqu'à son premier `co_await`.
+     *
+     * Une tâche en attente appartient à sa `Timeline`, qui la détruit si elle est
+     * vidée ; une tâche terminée libère sa mémoire elle-même. Les cadres de
+     * coroutine sont recyclés : une tâche ne coûte pas d'allocation en régime établi.
+     */
+    struct Task {
+        struct promise_type {
+            Task get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+
+            static void* operator new(std::size_t size);
+            static void operator delete(void* frame, std::size_t size) noexcept;
+        };
+    };
+
+    class Timeline {
+    public:
+        /// Attente de `co_await delay(n)` ; immédiate si l'échéance est déjà atteinte.
+        struct Delay {
+            Timeline& timeline;
+            Tick due;
+
+            bool await_ready() const noexcept { return due <= timeline.current; }
+            void await_suspend(std::coroutine_handle<> task) { timeline.schedule(due, task); }
+            void await_resume() const noexcept {}
+        };
+
+        Timeline() { waiting.reserve(8); }
+        ~Timeline() { clear(); }
+
+        Timeline(const Timeline&) = delete;
+        Timeline& operator=(const Timeline&) = delete;
+
+        /// Reprend la tâche `ticks` ticks plus tard (0 : sans suspendre).
+        Delay delay(int ticks) { return {*this, current + static_cast<Tick>(ticks > 0 ? ticks : 0)}; }
+
+        void advance();
+        void clear();
+
+        Tick now() const { return current; }
+        std::size_t pending() const { return waiting.size(); }
+
+    private:
+        struct Waiting {
+            Tick due;
+            std::uint64_t order;            ///< À échéance égale : ordre de mise en attente
+            std::coroutine_handle<> task;
+        };
+
+        void schedule(Tick due, std::coroutine_handle<> task);
+
+        std::vector<Waiting> waiting;       ///< Tas : prochaine échéance en tête
+        Tick current = 0;
+        std::uint64_t scheduled = 0;
+    };
+}
+
+#endif // TIMELINE_HPP
@@ -0,0 +1,58 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Triple tampon sans verrou entre un seul producteur et un seul consommateur.
+ *
+ * Le producteur remplit `writeBuffer()` puis appelle `publish()` ; le consommateur
+ * appelle `update()` puis lit `read()`. Les deux côtés ne se bloquent jamais :
+ * le consommateur voit toujours le dernier état publié complet, et les états
+ * intermédiaires qu'il n'a pas eu le temps de lire sont simplement remplacés.
+ *
+ * Les trois tampons sont alloués une fois pour toutes à la construction.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(const T& initial) : buffers{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /// Tampon réservé au producteur (contenu obsolète : à réécrire entièrement).
+    T& writeBuffer() { return buffers[back]; }
+
+    /// Rend le tampon d'écriture visible au consommateur.
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Récupère le dernier état publié, s'il y en a un nouveau.
+     *
+     * @return true si `read()` désigne désormais un état plus récent.
+     */
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /// Dernier état récupéré par `update()` (stable jusqu'au prochain `update()`).
+    const T& read() const { return buffers[front]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    std::array<T, 3> buffers;
+    std::uint8_t back = 0;                  ///< Côté producteur uniquement
+    std::atomic<std::uint8_t> middle{1};    ///< Échangé entre les deux côtés
+    std::uint8_t front = 2;                 ///< Côté consommateur uniquement
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -0,0 +1,65 @@
+#ifndef UNDO_JOURNAL_HPP
+#define UNDO_JOURNAL_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PieceSet.hpp"
+
+/**
+ * @brief Ce qu'une pose a changé, sous forme décodée (réutilisée d'une pose à l'autre).
+ */
+struct PlacementDelta {
+    PieceId piece = 0;                  ///< Pièce posée : elle réapparaît à l'annulation
+    Cells cells;                        ///< Cases remplies par `Board::mergeTetromino`
+    std::vector<int> rows;              ///< Lignes effacées (indices avant effacement, croissants)
+    std::vector<sf::Color> rowCells;    ///< Contenu de ces lignes, ligne après ligne
+    int score = 0;                      ///< Points gagnés
+    bool levelUp = false;
+};
+
+/**
+ * @brief Journal borné des poses, pour l'annulation en mode entraînement.
+ *
+ * Chaque pose est encodée en quelques dizaines d'octets dans un anneau de taille
+ * fixe : une case posée tient sur 2 octets, une ligne effacée sur 1 octet par
+ * colonne (indice dans une palette de couleurs). Quand l'anneau est plein, les
+ * poses les plus anciennes sont oubliées.
+ * @code
+ * u16 taille | pièce | niveau | u16 points | nb cases | nb lignes | (x, y)... | (y, couleurs...)... | u16 taille
+ * @endcode
+ * La taille en tête et en queue permet de retirer la pose la plus récente comme
+ * la plus ancienne. Les coordonnées tiennent sur un octet (plateau de 255 cases au plus).
+ */
+class UndoJournal {
+public:
+    /// ~256 Kio : plus de 10 000 poses de tétrominos.
+    static constexpr std::size_t DEFAULT_BYTES = 256 * 1024;
+
+    explicit UndoJournal(std::size_t bytes = DEFAULT_BYTES);
+
+    void clear();
+    void record(const PlacementDelta& delta, int width);
+    /// Retire la pose la plus récente ; false si le journal est vide.
+    bool pop(PlacementDelta& out, int width);
+
+    std::size_t size() const { return count; }
+    std::size_t bytesUsed() const { return used; }
+
+private:
+    std::uint8_t paletteIndex(sf::Color c);
+    void write(const std::uint8_t* data, std::size_t n);
+    void read(std::size_t at, std::uint8_t* data, std::size_t n) const;
+    std::size_t recordSize(std::size_t at) const;
+    void dropOldest();
+
+    std::vector<std::uint8_t> ring;
+    std::size_t head = 0;               ///< Début de la pose la plus ancienne
+    std::size_t used = 0;
+    std::size_t count = 0;
+    std::vector<sf::Color> palette;     ///< Couleurs rencontrées dans les lignes effacées
+    std::vector<std::uint8_t> scratch;  ///< Pose en cours d'encodage ou de décodage
+};
+
+#endif // UNDO_JOURNAL_HPP
@@ -0,0 +1,91 @@
+#include "../includes/Autoplayer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+Autoplayer::Autoplayer(int w, int h)
+    : width(w), height(h), search(w, h)
+{}
+
+/**
+ * @brief Cherche la meilleure pose de la pièce sur la grille.
+ *
+ * @param board Grille courante (le cache de `MoveSearch` sert tant qu'elle ne change pas).
+ * @param piece Pièce à poser, à sa position actuelle.
+ */
+template <class BoardT>
+const std::vector<Key>& Autoplayer::choose(const BoardT& board, const Tetromino& piece) {
+    search.setBoard(board);
+    best.clear();
+    double bestRating = 0.0;
+    for (const auto& p : search.placements(piece)) {
+        keys = search.path(p);
+        if (std::find(keys.begin(), keys.end(), Key::SoftDrop) != keys.end()) continue;
+
+        double rating = rate(board, p.blocks);
+        if (best.empty() || rating > bestRating) {
+            std::swap(best, keys);
+            bestRating = rating;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Joue directement dans la simulation le chemin de la meilleure pose.
+ *
+ * Sans effet en attendant la pièce suivante ou après la fin de partie.
+ */
+bool Autoplayer::play(Simulation& sim, const GameSnapshot& snap) {
+    if (snap.waiting || snap.gameOver) return false;
+    sim.play(lookahead ? lookahead->choose(snap.board, snap.current, snap.next) : choose(snap.board, snap.current));
+    return true;
+}
+
+/**
+ * @param pieces Pièces de la partie : les pièces inconnues sont tirées parmi elles.
+ * @param config Profondeur, largeur, budget par coup et threads de la recherche.
+ */
+void Autoplayer::setLookahead(const PieceSet& pieces, const bot::SearchConfig& config) {
+    lookahead = std::make_unique<bot::Lookahead>(width, height, pieces, config);
+}
+
+/**
+ * @brief Note d'une pose, mesurée après la pose et l'effacement des lignes.
+ *
+ * Pondération classique : 0.76 par ligne effacée, -0.51 par case de hauteur
+ * cumulée, -0.36 par trou, -0.18 par unité d'irrégularité de la surface.
+ */
+template <class BoardT>
+double Autoplayer::rate(const BoardT& board, const Cells& blocks) {
+    const int w = board.getWidth();
+    const int h = board.getHeight();
+    const std::uint32_t full = (1u << w) - 1;
+
+    std::vector<std::uint32_t> rows(h, 0);
+    for (int y = 0; y < h; y++) rows[y] = board.getRowBits(y);
+    for (const auto& b : blocks) {
+        if (b.y >= 0) rows[b.y] |= 1u << b.x;
+    }
+
+    int lines = static_cast<int>(std::erase(rows, full));
+    rows.insert(rows.begin(), lines, 0);
+
+    int aggregate = 0, holes = 0, bumpiness = 0, previous = -1;
+    for (int x = 0; x < w; x++) {
+        int top = 0;
+        while (top < h && !(rows[top] >> x & 1u)) top++;
+        for (int y = top + 1; y < h; y++) holes += !(rows[y] >> x & 1u);
+
+        int height = h - top;
+        aggregate += height;
+        if (previous >= 0) bumpiness += std::abs(height - previous);
+        previous = height;
+    }
+    return 0.76 * lines - 0.51 * aggregate - 0.36 * holes - 0.18 * bumpiness;
+}
+
+template const std::vector<Key>& Autoplayer::choose(const Board&, const Tetromino&);
+template const std::vector<Key>& Autoplayer::choose(const StandardBoard&, const Tetromino&);
+template double Autoplayer::rate(const Board&, const Cells&);
+template double Autoplayer::rate(const StandardBoard&, const Cells&);
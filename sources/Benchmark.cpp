@@ -0,0 +1,250 @@
+#include "../includes/Benchmark.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+namespace bench {
+
+namespace {
+    /// Écart absolu toléré en plus du relatif : sous 0.05 ms, la mesure n'est que du bruit.
+    constexpr double TIME_SLACK_MS = 0.05;
+
+    /// Dépliage maximal d'un script (garde-fou contre un `repeat` imbriqué démesuré).
+    constexpr std::size_t MAX_STEPS = 1'000'000;
+
+    const std::array<std::pair<const char*, sf::Keyboard::Key>, 8> KEY_NAMES {{
+        {"Left", sf::Keyboard::Left}, {"Right", sf::Keyboard::Right},
+        {"Up", sf::Keyboard::Up}, {"Down", sf::Keyboard::Down},
+        {"Space", sf::Keyboard::Space}, {"P", sf::Keyboard::P},
+        {"R", sf::Keyboard::R}, {"Escape", sf::Keyboard::Escape},
+    }};
+
+    /// Centile au rang le plus proche sur des valeurs triées.
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        std::size_t rank = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+}
+
+long Script::frameCount() const {
+    long frames = 0;
+    for (const auto& s : steps) frames += s.frames;
+    return frames;
+}
+
+/**
+ * @brief Lit un script de banc d'essai et déplie ses blocs `repeat`.
+ *
+ * @param path Chemin du script.
+ * @param error Reçoit la cause de l'échec (fichier:ligne).
+ * @return Le script, ou rien si le fichier est illisible ou mal formé.
+ */
+std::optional<Script> Script::load(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "impossible d'ouvrir " + path;
+        return std::nullopt;
+    }
+
+    struct Block { int count; std::size_t first; int line; };
+    std::vector<Block> blocks;
+    Script script;
+    std::string text;
+
+    for (int line = 1; std::getline(in, text); line++) {
+        auto fail = [&](const std::string& why) {
+            error = path + ":" + std::to_string(line) + " : " + why;
+            return std::nullopt;
+        };
+
+        text = text.substr(0, text.find('#'));
+        std::istringstream words(text);
+        std::string command;
+        if (!(words >> command)) continue;
+
+        Step step;
+        if (command == "seed") {
+            if (!(words >> script.seed)) return fail("graine attendue");
+            continue;
+        } else if (command == "wait") {
+            if (!(words >> step.frames) || step.frames < 0) return fail("nombre d'images attendu");
+        } else if (command == "autoplay") {
+            step.kind = Step::Kind::AutoPlay;
+            if (!(words >> step.frames) || step.frames < 0) return fail("nombre d'images attendu");
+            int every = 0;
+            if (words >> every) {
+                if (every < 1) return fail("intervalle invalide");
+                step.every = every;
+            }
+        } else if (command == "key") {
+            step.kind = Step::Kind::Key;
+            std::string name;
+            words >> name;
+            auto it = std::find_if(KEY_NAMES.begin(), KEY_NAMES.end(),
+                                   [&](const auto& k) { return name == k.first; });
+            if (it == KEY_NAMES.end()) return fail("touche inconnue '" + name + "'");
+            step.key = it->second;
+        } else if (command == "click") {
+            step.kind = Step::Kind::Click;
+            std::getline(words >> std::ws, step.label);
+            while (!step.label.empty() && std::isspace(static_cast<unsigned char>(step.label.back()))) {
+                step.label.pop_back();
+            }
+            if (step.label.empty()) return fail("libelle de bouton attendu");
+        } else if (command == "repeat") {
+            int count = 0;
+            if (!(words >> count) || count < 0) return fail("nombre de repetitions attendu");
+            blocks.push_back({count, script.steps.size(), line});
+            continue;
+        } else if (command == "end") {
+            if (blocks.empty()) return fail("'end' sans 'repeat'");
+            Block b = blocks.back();
+            blocks.pop_back();
+
+            const std::size_t length = script.steps.size() - b.first;
+            if (b.count == 0) {
+                script.steps.resize(b.first);
+            } else if (length * b.count > MAX_STEPS) {
+                return fail("script trop long une fois deplie");
+            }
+            for (int k = 1; k < b.count; k++) {
+                for (std::size_t i = 0; i < length; i++) {
+                    script.steps.push_back(script.steps[b.first + i]);
+                }
+            }
+            continue;
+        } else {
+            return fail("commande inconnue '" + command + "'");
+        }
+        script.steps.push_back(std::move(step));
+    }
+
+    if (!blocks.empty()) {
+        error = path + ":" + std::to_string(blocks.back().line) + " : 'repeat' sans 'end'";
+        return std::nullopt;
+    }
+    return script;
+}
+
+void Recorder::add(Phase phase, double frameMs, std::uint32_t drawCalls) {
+    Samples& s = samples[static_cast<std::size_t>(phase)];
+    s.frameMs.push_back(frameMs);
+    s.drawCalls.push_back(drawCalls);
+}
+
+Summary Recorder::summarize() const {
+    Summary summary{};
+    for (std::size_t i = 0; i < PHASE_COUNT; i++) {
+        const Samples& s = samples[i];
+        if (s.frameMs.empty()) continue;
+
+        std::vector<double> sorted = s.frameMs;
+        std::sort(sorted.begin(), sorted.end());
+
+        PhaseStats& out = summary[i];
+        out.frames = static_cast<long>(sorted.size());
+        out.p50 = percentile(sorted, 0.50);
+        out.p95 = percentile(sorted, 0.95);
+        out.p99 = percentile(sorted, 0.99);
+        out.max = sorted.back();
+        out.drawCalls = std::accumulate(s.drawCalls.begin(), s.drawCalls.end(), 0.0) / s.drawCalls.size();
+        out.maxDrawCalls = *std::max_element(s.drawCalls.begin(), s.drawCalls.end());
+    }
+    return summary;
+}
+
+/**
+ * @brief Affiche le tableau des mesures (une ligne par catégorie d'images).
+ */
+void report(const Summary& summary, std::ostream& out) {
+    std::ios format(nullptr);
+    format.copyfmt(out);
+
+    out << "[bench] phase       images    p50 ms    p95 ms    p99 ms    max ms   draws moy/max\n";
+    for (std::size_t i = 0; i < PHASE_COUNT; i++) {
+        const PhaseStats& s = summary[i];
+        if (s.frames == 0) continue;
+        out << "[bench] " << std::left << std::setw(10) << PHASE_NAMES[i] << std::right
+            << std::setw(8) << s.frames << std::fixed << std::setprecision(3)
+            << std::setw(10) << s.p50 << std::setw(10) << s.p95
+            << std::setw(10) << s.p99 << std::setw(10) << s.max
+            << std::setprecision(1) << std::setw(10) << s.drawCalls << " / " << s.maxDrawCalls << "\n";
+    }
+    out.copyfmt(format);
+}
+
+bool save(const Summary& summary, const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    out << "# tetris --bench : phase images p50 p95 p99 max (ms) appels_moyens appels_max\n";
+    out << std::setprecision(6);
+    for (std::size_t i = 0; i < PHASE_COUNT; i++) {
+        const PhaseStats& s = summary[i];
+        if (s.frames == 0) continue;
+        out << PHASE_NAMES[i] << ' ' << s.frames << ' ' << s.p50 << ' ' << s.p95 << ' '
+            << s.p99 << ' ' << s.max << ' ' << s.drawCalls << ' ' << s.maxDrawCalls << '\n';
+    }
+    return out.good();
+}
+
+/**
+ * @brief Relit un résumé écrit par `save` ; les lignes inconnues sont ignorées.
+ */
+std::optional<Summary> loadBaseline(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return std::nullopt;
+
+    Summary summary{};
+    std::string text;
+    while (std::getline(in, text)) {
+        std::istringstream words(text.substr(0, text.find('#')));
+        std::string name;
+        PhaseStats s;
+        if (!(words >> name >> s.frames >> s.p50 >> s.p95 >> s.p99 >> s.max >> s.drawCalls >> s.maxDrawCalls)) {
+            continue;
+        }
+        for (std::size_t i = 0; i < PHASE_COUNT; i++) {
+            if (name == PHASE_NAMES[i]) summary[i] = s;
+        }
+    }
+    return summary;
+}
+
+int compare(const Summary& current, const Summary& baseline, double tolerance, std::ostream& out) {
+    std::ios format(nullptr);
+    format.copyfmt(out);
+    out << std::fixed << std::setprecision(3);
+
+    int regressions = 0;
+    auto check = [&](const char* phase, const char* metric, double now, double before, double limit) {
+        if (now <= limit) return;
+        out << "[bench] REGRESSION " << phase << ' ' << metric << " : " << now
+            << " (reference " << before << ", limite " << limit << ")\n";
+        regressions++;
+    };
+
+    for (std::size_t i = 0; i < PHASE_COUNT; i++) {
+        const PhaseStats& now = current[i];
+        const PhaseStats& before = baseline[i];
+        if (before.frames == 0) continue;
+        if (now.frames == 0) {
+            out << "[bench] " << PHASE_NAMES[i] << " : absente de cette execution, non comparee\n";
+            continue;
+        }
+
+        auto timeLimit = [&](double ms) { return ms * (1.0 + tolerance) + TIME_SLACK_MS; };
+        check(PHASE_NAMES[i], "p50", now.p50, before.p50, timeLimit(before.p50));
+        check(PHASE_NAMES[i], "p95", now.p95, before.p95, timeLimit(before.p95));
+        check(PHASE_NAMES[i], "p99", now.p99, before.p99, timeLimit(before.p99));
+        // Moyenne arrondie à l'écriture : marge d'un centième d'appel
+        check(PHASE_NAMES[i], "draws", now.drawCalls, before.drawCalls, before.drawCalls + 0.01);
+    }
+    out.copyfmt(format);
+    return regressions;
+}
+
+}
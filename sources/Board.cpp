@@ -1,6 +1,7 @@
 #include "../includes/Board.hpp"
 #include <algorithm>
 #include <ranges>
+#include <stdexcept>
 
 /**
  * @brief Constructeur de la classe Board.
@@ -10,11 +11,47 @@
  * 
  * @param w Largeur de la grille (en nombre de blocs).
  * @param h Hauteur de la grille (en nombre de blocs).
+ *
+ * @throws std::invalid_argument Si une grille de taille fixe reçoit une autre taille.
  */
-Board::Board(int w, int h)
-    : width(w), height(h),
-      grid(h, std::vector<sf::Color>(w, sf::Color::Black)) 
-{}
+template <int W, int H>
+BasicBoard<W, H>::BasicBoard(int w, int h)
+    : width(w), height(h)
+{
+    if constexpr (FIXED)
+    {
+        if (w != W || h != H) throw std::invalid_argument("BasicBoard : taille differente de la taille fixe");
+        for (auto& row : grid) row.fill(sf::Color::Black);
+    }
+    else
+    {
+        grid.assign(h, Row(w, sf::Color::Black));
+    }
+}
+
+/**
+ * @brief Construit une grille pré-remplie à partir de lignes de bits.
+ *
+ * Le bit `x` de `rows[y]` indique une case occupée, dessinée avec `color`.
+ * Les lignes absentes de `rows` restent vides.
+ *
+ * @param w Largeur de la grille (32 colonnes au plus).
+ * @param h Hauteur de la grille.
+ * @param rows Une ligne de bits par rangée, de haut en bas.
+ * @param color Couleur des cases occupées.
+ */
+template <int W, int H>
+BasicBoard<W, H>::BasicBoard(int w, int h, std::span<const std::uint32_t> rows, sf::Color color)
+    : BasicBoard(w, h)
+{
+    for (int y = 0; y < h && y < static_cast<int>(rows.size()); y++)
+    {
+        for (int x = 0; x < w && x < 32; x++)
+        {
+            if (rows[y] >> x & 1u) setCell(x, y, color);
+        }
+    }
+}
 
 /**
  * @brief Vérifie si un Tetromino entre en collision avec la grille ou les bords.
@@ -23,21 +60,57 @@ Board::Board(int w, int h)
  * @return true si une collision est détectée.
  * @return false sinon.
  */
-bool Board::checkCollision(const Tetromino& tetro) const 
+template <int W, int H>
+bool BasicBoard<W, H>::checkCollision(const Tetromino& tetro) const 
 {
     for (auto& b : tetro.getBlocks()) 
     {
         // Collision avec les bords ou le bas de la grille
-        if (b.x < 0 || b.x >= width || b.y >= height) 
+        if (b.x < 0 || b.x >= getWidth() || b.y >= getHeight()) 
             return true;
 
         // Collision avec des blocs déjà posés
-        if (b.y >= 0 && grid[b.y][b.x] != sf::Color::Black) 
+        if constexpr (FIXED)
+        {
+            if (b.y >= 0 && (occupied[b.y] >> b.x & 1u))
+                return true;
+        }
+        else if (b.y >= 0 && grid[b.y][b.x] != sf::Color::Black) 
             return true;
     }
     return false;
 }
 
+/**
+ * @brief Calcule en un seul balayage de combien de lignes un Tetromino peut descendre.
+ *
+ * Pour chaque bloc, on compte les cases libres sous lui jusqu'au premier
+ * obstacle (bloc posé ou fond) ; la distance de chute est le minimum.
+ * Remplace les appels répétés à `move(0,1)` / `checkCollision`.
+ *
+ * @param tetro Le Tetromino (supposé sans collision à sa position actuelle).
+ * @return int Nombre de lignes de chute possibles (0 si posé).
+ */
+template <int W, int H>
+int BasicBoard<W, H>::dropDistance(const Tetromino& tetro) const
+{
+    int distance = getHeight();
+    for (auto& b : tetro.getBlocks())
+    {
+        int free = 0;
+        for (int y = b.y + 1; y < getHeight() && free < distance; y++, free++)
+        {
+            if constexpr (FIXED)
+            {
+                if (y >= 0 && (occupied[y] >> b.x & 1u)) break;
+            }
+            else if (y >= 0 && grid[y][b.x] != sf::Color::Black) break;
+        }
+        distance = std::min(distance, free);
+    }
+    return distance;
+}
+
 /**
  * @brief Fusionne un Tetromino avec la grille.
  * 
@@ -45,32 +118,67 @@ bool Board::checkCollision(const Tetromino& tetro) const
  * 
  * @param tetro Le Tetromino à fusionner.
  */
-void Board::mergeTetromino(const Tetromino& tetro) 
+template <int W, int H>
+void BasicBoard<W, H>::mergeTetromino(const Tetromino& tetro) 
 {
     for (auto& b : tetro.getBlocks()) 
     {
-        if (b.y >= 0 && b.y < height) 
+        if (b.y >= 0 && b.y < getHeight()) 
         {
-            grid[b.y][b.x] = tetro.getColor();
+            setCell(b.x, b.y, tetro.getColor());
         }
     }
 }
 
+/**
+ * @brief Hauteur de la pile : nombre de lignes entre le bas et le bloc posé le plus haut.
+ *
+ * @return int 0 si la grille est vide, `height` si un bloc touche le haut.
+ */
+template <int W, int H>
+int BasicBoard<W, H>::getStackHeight() const
+{
+    for (int i = 0; i < getHeight(); i++)
+    {
+        if constexpr (FIXED)
+        {
+            if (occupied[i] != 0) return H - i;
+        }
+        else
+        {
+            auto filled = [](const sf::Color& c) { return c != sf::Color::Black; };
+            if (std::ranges::any_of(grid[i], filled))
+            {
+                return height - i;
+            }
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Détecte les lignes complètes à effacer.
  * 
  * Parcourt la grille et ajoute les indices des lignes totalement remplies
  * à la liste `linesToClear`.
  */
-void Board::detectLinesToClear() 
+template <int W, int H>
+void BasicBoard<W, H>::detectLinesToClear() 
 {
     linesToClear.clear();
-    for (int i = 0; i < height; i++) 
+    for (int i = 0; i < getHeight(); i++) 
     {   
-        auto checkColor = [](const sf::Color& c) { return c != sf::Color::Black; };
-        if (std::ranges::all_of(grid[i], checkColor)) 
+        if constexpr (FIXED)
         {
-            linesToClear.push_back(i);
+            if (occupied[i] == FULL_ROW) linesToClear.push_back(i);
+        }
+        else
+        {
+            auto checkColor = [](const sf::Color& c) { return c != sf::Color::Black; };
+            if (std::ranges::all_of(grid[i], checkColor)) 
+            {
+                linesToClear.push_back(i);
+            }
         }
     }
 }
@@ -79,58 +187,113 @@ void Board::detectLinesToClear()
  * @brief Efface les lignes complètes détectées et compresse la grille.
  * 
  * Les lignes complètes sont supprimées et remplacées par des lignes vides en haut de la grille.
+ * En taille fixe, les lignes restantes descendent sur place, sans allocation.
  */
-void Board::performClearLines() 
+template <int W, int H>
+void BasicBoard<W, H>::performClearLines() 
 {
     // Trier les lignes par ordre décroissant pour éviter les problèmes d'indices
     std::sort(linesToClear.rbegin(), linesToClear.rend());
 
-    int linesCleared = linesToClear.size();
-    
-    std::vector<std::vector<sf::Color>> newGrid;
-
-    // Ajouter les lignes vides en haut
-    for (int i = 0; i < linesCleared; i++) 
+    if constexpr (FIXED)
     {
-        newGrid.push_back(std::vector<sf::Color>(width, sf::Color::Black));
-    }
-    
-    // Copier les lignes restantes (non effacées)
-    for (int i = 0; i < height; i++) 
-    {
-        bool shouldClear = false;
-        for (const int& line : linesToClear) 
+        auto cleared = linesToClear.begin();
+        int write = H - 1;
+        for (int read = H - 1; read >= 0; read--)
         {
-            if (i == line) 
+            if (cleared != linesToClear.end() && *cleared == read)
+            {
+                ++cleared;
+                continue;
+            }
+            if (write != read)
             {
-                shouldClear = true;
-                break;
+                grid[write] = grid[read];
+                occupied[write] = occupied[read];
             }
+            write--;
         }
-        
-        if (!shouldClear) 
+        for (; write >= 0; write--)
         {
-            newGrid.push_back(grid[i]);
+            grid[write].fill(sf::Color::Black);
+            occupied[write] = 0;
         }
     }
+    else
+    {
+        int linesCleared = linesToClear.size();
+    
+        std::vector<std::vector<sf::Color>> newGrid;
+
+        // Ajouter les lignes vides en haut
+        for (int i = 0; i < linesCleared; i++) 
+        {
+            newGrid.push_back(std::vector<sf::Color>(width, sf::Color::Black));
+        }
     
-    grid = std::move(newGrid);
+        // Copier les lignes restantes (non effacées)
+        for (int i = 0; i < height; i++) 
+        {
+            bool shouldClear = false;
+            for (const int& line : linesToClear) 
+            {
+                if (i == line) 
+                {
+                    shouldClear = true;
+                    break;
+                }
+            }
+        
+            if (!shouldClear) 
+            {
+                newGrid.push_back(grid[i]);
+            }
+        }
+    
+        grid = std::move(newGrid);
+    }
     linesToClear.clear();
 }
 
+/**
+ * @brief Remet une ligne effacée à sa place (annulation d'un effacement).
+ *
+ * La ligne du haut, vide, est retirée et les lignes au-dessus de `y` remontent
+ * d'un cran, sans allocation. Pour annuler un effacement de plusieurs lignes,
+ * les réinsérer de la plus basse à la plus haute.
+ *
+ * @param y Indice de la ligne avant son effacement.
+ * @param row Contenu de la ligne (`width` couleurs).
+ */
+template <int W, int H>
+void BasicBoard<W, H>::reinsertLine(int y, std::span<const sf::Color> row)
+{
+    std::rotate(grid.begin(), grid.begin() + 1, grid.begin() + y + 1);
+    if constexpr (FIXED)
+    {
+        std::rotate(occupied.begin(), occupied.begin() + 1, occupied.begin() + y + 1);
+        for (int x = 0; x < W; x++) setCell(x, y, row[x]);
+    }
+    else
+    {
+        std::copy(row.begin(), row.end(), grid[y].begin());
+    }
+}
+
 /**
  * @brief Dessine tous les blocs présents dans la grille.
  * 
  * @param window La fenêtre SFML où dessiner.
  * @param tileSize La taille (en pixels) de chaque bloc.
  */
-void Board::draw(sf::RenderWindow& window, int tileSize) 
+template <int W, int H>
+void BasicBoard<W, H>::draw(GameWindow& window, int tileSize) const 
 {
     sf::RectangleShape block(sf::Vector2f(tileSize - 1, tileSize - 1));
 
-    for (int i = 0; i < height; i++) 
+    for (int i = 0; i < getHeight(); i++) 
     {
-        for (int j = 0; j < width; j++) 
+        for (int j = 0; j < getWidth(); j++) 
         {
             if (grid[i][j] == sf::Color::Black) continue;
             block.setPosition(j * tileSize, i * tileSize);
@@ -146,8 +309,10 @@ void Board::draw(sf::RenderWindow& window, int tileSize)
  * @param window La fenêtre SFML où dessiner.
  * @param tileSize La taille d’un bloc (en pixels).
  */
-void Board::drawGrid(sf::RenderWindow& window, int tileSize) 
+template <int W, int H>
+void BasicBoard<W, H>::drawGrid(GameWindow& window, int tileSize) const 
 {
+    const int width = getWidth(), height = getHeight();
     sf::VertexArray lines(sf::Lines);
     sf::Color gridColor(50, 50, 50, 100);
     
@@ -167,30 +332,37 @@ void Board::drawGrid(sf::RenderWindow& window, int tileSize)
 }
 
 /**
- * @brief Dessine une animation d'explosion sur les lignes à effacer.
+ * @brief Dessine une animation d'explosion sur des lignes qui viennent d'être effacées.
  * 
- * Les lignes clignotent alternativement en rouge et jaune avant leur suppression.
+ * Les lignes clignotent alternativement en rouge et jaune et s'estompent,
+ * par-dessus la partie qui continue.
  * 
  * @param window La fenêtre SFML où dessiner.
  * @param tileSize La taille des blocs.
- * @param animTime Le temps écoulé (utilisé pour alterner les couleurs).
+ * @param rows Les lignes effacées.
+ * @param progress Avancement de l'animation, de 0 à 1.
  */
-void Board::drawExplosion(sf::RenderWindow& window, int tileSize, float animTime) 
+template <int W, int H>
+void BasicBoard<W, H>::drawExplosion(GameWindow& window, int tileSize, std::span<const int> rows, float progress) const 
 {
-    if (linesToClear.empty()) return;
+    if (rows.empty()) return;
 
-    sf::Color flash = (static_cast<int>(animTime * 10) % 2 == 0)
+    sf::Color flash = (static_cast<int>(progress * 3) % 2 == 0)
         ? sf::Color::Red : sf::Color::Yellow;
+    flash.a = static_cast<sf::Uint8>(220 * (1.f - progress));
 
     sf::RectangleShape block(sf::Vector2f(tileSize - 1, tileSize - 1));
     block.setFillColor(flash);
 
-    for (int line : linesToClear) 
+    for (int line : rows) 
     {
-        for (int j = 0; j < width; j++) 
+        for (int j = 0; j < getWidth(); j++) 
         {
             block.setPosition(j * tileSize, line * tileSize);
             window.draw(block);
         }
     }
 }
+
+template class BasicBoard<>;
+template class BasicBoard<10, 20>;
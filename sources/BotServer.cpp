@@ -0,0 +1,384 @@
+#include "../includes/BotServer.hpp"
+#include <algorithm>
+#include <charconv>
+#include <random>
+
+namespace bot {
+
+namespace {
+    /// Parties créées au plus par commande `new`.
+    constexpr long MAX_NEW_GAMES = 100000;
+    /// Ticks au plus par commande `step`.
+    constexpr long MAX_STEP_TICKS = 36000;
+    /// Temps de recherche par coup de `think` : par défaut et au plus (ms).
+    constexpr double DEFAULT_THINK_MS = 5.0;
+    constexpr double MAX_THINK_MS = 10000.0;
+
+    constexpr std::string_view HELP =
+        "ok commandes : new [n] [graine] | reset <parties> [graine] | free <parties> | state <parties> | "
+        "moves <parties> | place <parties> <pose> | think <parties> [ms] | input <parties> <LRUHT> | "
+        "step <parties> <ticks> | "
+        "pieces | help | quit ; parties : n, a-b ou *";
+
+    /// Retire et renvoie le prochain mot de `s` (vide à la fin).
+    std::string_view nextWord(std::string_view& s) {
+        std::size_t start = s.find_first_not_of(" \t\r");
+        if (start == std::string_view::npos) {
+            s = {};
+            return {};
+        }
+        std::size_t end = s.find_first_of(" \t\r", start);
+        if (end == std::string_view::npos) end = s.size();
+        std::string_view word = s.substr(start, end - start);
+        s.remove_prefix(end);
+        return word;
+    }
+
+    template <typename T>
+    bool parseNumber(std::string_view word, T& value) {
+        auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), value);
+        return ec == std::errc() && end == word.data() + word.size();
+    }
+
+    template <typename T>
+    void appendNumber(std::string& out, T value, int base = 10) {
+        char buffer[24];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value, base);
+        out.append(buffer, end);
+    }
+
+    void appendCells(std::string& out, const Cells& cells) {
+        for (std::size_t i = 0; i < cells.size(); i++) {
+            if (i > 0) out += '/';
+            appendNumber(out, cells[i].x);
+            out += ',';
+            appendNumber(out, cells[i].y);
+        }
+    }
+}
+
+/**
+ * @param width Largeur des plateaux (32 colonnes au plus : lignes en hexadécimal).
+ * @param height Hauteur des plateaux.
+ * @param pieces Pièces tirées dans toutes les parties (doit survivre au serveur).
+ */
+Server::Server(int w, int h, const PieceSet& set)
+    : width(w), height(h), pieces(set), snap(w, h), search(w, h)
+{}
+
+std::size_t Server::gameCount() const {
+    return std::count_if(games.begin(), games.end(), [](const Slot& s) { return s.sim != nullptr; });
+}
+
+bool Server::handleLine(std::string_view line, std::string& out) {
+    std::string_view rest = line;
+    std::string_view first = nextWord(rest);
+    if (first == "quit") return false;
+
+    bool firstResult = true;
+    while (!line.empty()) {
+        std::size_t end = line.find(';');
+        std::string_view command = line.substr(0, end);
+        line = end == std::string_view::npos ? std::string_view{} : line.substr(end + 1);
+
+        std::string_view probe = command;
+        if (nextWord(probe).empty()) continue;  // commande vide (";;" ou ligne blanche)
+
+        if (!firstResult) out += "; ";
+        firstResult = false;
+        execute(command, out);
+    }
+    out += '\n';
+    return true;
+}
+
+/**
+ * @brief Exécute une commande ; ajoute un résultat par partie visée, séparés par `;`.
+ */
+void Server::execute(std::string_view command, std::string& out) {
+    std::string_view args = command;
+    std::string_view name = nextWord(args);
+
+    if (name == "new") return newGames(args, out);
+    if (name == "help") {
+        out += HELP;
+        return;
+    }
+    if (name == "pieces") {
+        out += "ok";
+        for (std::size_t i = 0; i < pieces.size(); i++) {
+            out += ' ';
+            out += pieces[i].name;
+        }
+        return;
+    }
+
+    std::string error;
+    if (!select(nextWord(args), ids, error)) {
+        out += "err " + error;
+        return;
+    }
+
+    // Paramètre commun à toutes les parties visées, lu une fois
+    std::string_view param = nextWord(args);
+    long number = 0;
+    double ms = 0.0;
+    if (name == "place" || name == "step") {
+        if (!parseNumber(param, number) || number < 0 || (name == "step" && number > MAX_STEP_TICKS)) {
+            out += "err nombre invalide '" + std::string(param) + "'";
+            return;
+        }
+    } else if (name == "think") {
+        if (param.empty()) {
+            ms = DEFAULT_THINK_MS;
+        } else if (!parseNumber(param, ms) || !(ms >= 0.0 && ms <= MAX_THINK_MS)) {
+            out += "err duree invalide '" + std::string(param) + "'";
+            return;
+        }
+    } else if (name == "reset" && !param.empty()) {
+        std::uint32_t seed = 0;
+        if (!parseNumber(param, seed)) {
+            out += "err graine invalide '" + std::string(param) + "'";
+            return;
+        }
+    } else if (name != "state" && name != "moves" && name != "free" && name != "input" && name != "reset") {
+        out += "err commande inconnue '" + std::string(name) + "'";
+        return;
+    }
+
+    for (std::size_t k = 0; k < ids.size(); k++) {
+        if (k > 0) out += "; ";
+        std::uint32_t id = ids[k];
+        Simulation& sim = *games[id].sim;
+
+        if (name == "state") state(id, out);
+        else if (name == "moves") moves(id, out);
+        else if (name == "place") place(id, number, out);
+        else if (name == "think") think(id, ms, out);
+        else if (name == "input") input(id, param, out);
+        else if (name == "step") {
+            sim.writeSnapshot(snap);
+            int before = snap.lines;
+            for (long t = 0; t < number; t++) sim.tick();
+            sim.clearEvents();
+            outcome(id, before, out);
+        } else if (name == "reset") {
+            if (!param.empty()) parseNumber(param, games[id].seed);
+            sim.reseed(games[id].seed);
+            out += "ok ";
+            appendNumber(out, id);
+        } else if (name == "free") {
+            games[id].sim.reset();
+            out += "ok ";
+            appendNumber(out, id);
+        }
+    }
+}
+
+/**
+ * @brief Traduit `n`, `a-b` ou `*` en numéros de parties existantes.
+ */
+bool Server::select(std::string_view selector, std::vector<std::uint32_t>& out, std::string& error) const {
+    out.clear();
+    if (selector.empty()) {
+        error = "partie attendue";
+        return false;
+    }
+    if (selector == "*") {
+        for (std::uint32_t i = 0; i < games.size(); i++) {
+            if (games[i].sim) out.push_back(i);
+        }
+        return true;
+    }
+
+    std::uint32_t first = 0, last = 0;
+    std::size_t dash = selector.find('-');
+    bool ok = dash == std::string_view::npos
+        ? parseNumber(selector, first) && (last = first, true)
+        : parseNumber(selector.substr(0, dash), first) && parseNumber(selector.substr(dash + 1), last);
+    if (!ok || first > last) {
+        error = "parties invalides '" + std::string(selector) + "'";
+        return false;
+    }
+    for (std::uint32_t i = first; i <= last; i++) {
+        if (i >= games.size() || !games[i].sim) {
+            error = "partie inconnue " + std::to_string(i);
+            return false;
+        }
+        out.push_back(i);
+    }
+    return true;
+}
+
+/**
+ * @brief `new [n] [graine]` : crée `n` parties numérotées à la suite, déjà en marche.
+ */
+void Server::newGames(std::string_view args, std::string& out) {
+    long count = 1;
+    std::uint32_t seed = std::random_device{}();
+    std::string_view word = nextWord(args);
+    if (!word.empty() && (!parseNumber(word, count) || count < 1 || count > MAX_NEW_GAMES)) {
+        out += "err nombre de parties invalide '" + std::string(word) + "'";
+        return;
+    }
+    word = nextWord(args);
+    if (!word.empty() && !parseNumber(word, seed)) {
+        out += "err graine invalide '" + std::string(word) + "'";
+        return;
+    }
+
+    std::uint32_t first = static_cast<std::uint32_t>(games.size());
+    for (long i = 0; i < count; i++) {
+        Slot slot;
+        slot.seed = seed + static_cast<std::uint32_t>(i);
+        slot.sim = std::make_unique<Simulation>(width, height, slot.seed);
+        slot.sim->setPieceSet(pieces);
+        slot.sim->apply({Command::Resume});
+        games.push_back(std::move(slot));
+    }
+    out += "ok ";
+    appendNumber(out, first);
+    out += '-';
+    appendNumber(out, first + count - 1);
+}
+
+/**
+ * @brief `state` : score, lignes, niveau, fin de partie, pièces et grille
+ * (une ligne de bits par rangée, de haut en bas, en hexadécimal ; bit x = colonne x).
+ */
+void Server::state(std::uint32_t id, std::string& out) {
+    games[id].sim->writeSnapshot(snap);
+    out += "ok ";
+    appendNumber(out, id);
+    out += " score=";
+    appendNumber(out, snap.score);
+    out += " lines=";
+    appendNumber(out, snap.lines);
+    out += " level=";
+    appendNumber(out, snap.level);
+    out += snap.gameOver ? " over=1" : " over=0";
+    out += " piece=" + snap.current.getShape().name;
+    out += " next=" + snap.next.getShape().name;
+    out += " rows=";
+    for (int y = 0; y < height; y++) {
+        if (y > 0) out += ',';
+        appendNumber(out, snap.board.getRowBits(y), 16);
+    }
+}
+
+/**
+ * @brief `moves` : cases de chaque pose atteignable par la pièce courante ;
+ * la `i`-ième est la pose `i` de `place`.
+ */
+void Server::moves(std::uint32_t id, std::string& out) {
+    games[id].sim->writeSnapshot(snap);
+    out += "ok ";
+    appendNumber(out, id);
+    if (snap.gameOver) return;
+
+    search.setBoard(snap.board);
+    for (const auto& p : search.placements(snap.current)) {
+        out += ' ';
+        appendCells(out, p.blocks);
+    }
+}
+
+/**
+ * @brief `place` : joue le chemin minimal vers la pose `index` de `moves`, puis la chute.
+ */
+void Server::place(std::uint32_t id, long index, std::string& out) {
+    Simulation& sim = *games[id].sim;
+    sim.writeSnapshot(snap);
+    if (snap.gameOver) {
+        out += "err partie " + std::to_string(id) + " terminee";
+        return;
+    }
+
+    search.setBoard(snap.board);
+    const auto& placements = search.placements(snap.current);
+    if (index >= static_cast<long>(placements.size())) {
+        out += "err pose " + std::to_string(index) + " hors limites (" + std::to_string(placements.size()) + ")";
+        return;
+    }
+
+    int before = snap.lines;
+    sim.play(search.path(placements[index]));
+    settle(sim);
+    outcome(id, before, out);
+}
+
+/**
+ * @brief `think` : joue le coup choisi par la recherche avec anticipation en `budgetMs` ms au plus,
+ * puis ajoute la profondeur atteinte et le nombre de grilles évaluées.
+ */
+void Server::think(std::uint32_t id, double budgetMs, std::string& out) {
+    Simulation& sim = *games[id].sim;
+    sim.writeSnapshot(snap);
+    if (snap.gameOver) {
+        out += "err partie " + std::to_string(id) + " terminee";
+        return;
+    }
+
+    if (!lookahead) lookahead = std::make_unique<bot::Lookahead>(width, height, pieces);
+    lookahead->setBudget(budgetMs);
+    int before = snap.lines;
+    sim.play(lookahead->choose(snap.board, snap.current, snap.next));
+    settle(sim);
+    outcome(id, before, out);
+
+    const bot::SearchStats& stats = lookahead->stats();
+    out += " depth=";
+    appendNumber(out, stats.depth);
+    out += " nodes=";
+    appendNumber(out, stats.nodes);
+}
+
+/**
+ * @brief `input` : touches brutes. L, R : déplacement ; U : rotation ; H : chute ; T : un tick.
+ */
+void Server::input(std::uint32_t id, std::string_view keys, std::string& out) {
+    // Suite vérifiée en entier avant de jouer : une erreur ne laisse pas la partie à moitié jouée
+    if (std::size_t bad = keys.find_first_not_of("LRUHT"); bad != std::string_view::npos) {
+        out += "err touche inconnue '";
+        out += keys[bad];
+        out += "'";
+        return;
+    }
+
+    Simulation& sim = *games[id].sim;
+    sim.writeSnapshot(snap);
+    int before = snap.lines;
+
+    for (char k : keys) {
+        switch (k) {
+            case 'L': sim.apply({Command::MoveLeft}); break;
+            case 'R': sim.apply({Command::MoveRight}); break;
+            case 'U': sim.apply({Command::Rotate}); break;
+            case 'H': sim.apply({Command::HardDrop}); settle(sim); break;
+            case 'T': sim.tick(); break;
+        }
+    }
+    sim.clearEvents();
+    outcome(id, before, out);
+}
+
+/**
+ * @brief Attend l'apparition de la pièce suivante (délais d'apparition et d'effacement).
+ */
+void Server::settle(Simulation& sim) {
+    while (sim.isWaiting() && sim.isRunning()) sim.tick();
+    sim.clearEvents();
+}
+
+void Server::outcome(std::uint32_t id, int linesBefore, std::string& out) {
+    games[id].sim->writeSnapshot(snap);
+    out += "ok ";
+    appendNumber(out, id);
+    out += " lines=";
+    appendNumber(out, snap.lines - linesBefore);
+    out += " score=";
+    appendNumber(out, snap.score);
+    out += snap.gameOver ? " over=1" : " over=0";
+}
+
+}
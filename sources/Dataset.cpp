@@ -0,0 +1,217 @@
+#include "../includes/Dataset.hpp"
+#include "../includes/Autoplayer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace dataset {
+
+namespace {
+    /// Lignes par lot (un `write` par lot, environ 290 Kio).
+    constexpr std::size_t BATCH = 4096;
+
+    struct Shared {
+        std::atomic<std::uint32_t> nextGame{0};
+        std::atomic<bool> done{false};
+    };
+
+    /// Parties d'un thread, jusqu'à la limite du fichier ou l'arrêt demandé.
+    template <class BoardT>
+    void produce(unsigned index, const Config& config, const PieceSet& pieces, Writer& writer,
+                 Shared& shared, const std::atomic<bool>& stop) {
+        const auto seed = static_cast<std::uint32_t>(config.seed + index);
+        BasicSimulation<BoardT> sim(config.width, config.height, seed);
+        sim.setPieceSet(pieces);
+        sim.setFinesse(false);
+        BasicSnapshot<BoardT> snap(config.width, config.height);
+        MoveSearch search(config.width, config.height);
+        std::mt19937 rng(seed ^ 0x9E3779B9u);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+        std::vector<Record> batch;
+        batch.reserve(BATCH);
+        std::vector<std::size_t> playable;
+        std::vector<Key> keys;
+
+        std::uint32_t game = shared.nextGame.fetch_add(1, std::memory_order_relaxed);
+        std::uint32_t move = 0;
+        sim.apply({Command::Reset, game});
+        sim.apply({Command::Resume});
+
+        bool pending = false;               // Dernière ligne en attente de son résultat
+        int scoreBefore = 0, linesBefore = 0;
+        auto flush = [&]() {
+            if (!writer.append(batch, config.samples)) shared.done = true;
+            batch.clear();
+        };
+
+        while (!stop.load(std::memory_order_relaxed) && !shared.done.load(std::memory_order_relaxed)) {
+            sim.writeSnapshot(snap);
+            if (pending) {
+                Record& r = batch.back();
+                r.reward = static_cast<std::uint32_t>(snap.score - scoreBefore);
+                r.lines = static_cast<std::uint8_t>(snap.lines - linesBefore);
+                if (snap.gameOver) r.flags |= GameOver;
+                pending = false;
+                if (batch.size() == BATCH) flush();
+            }
+
+            if (snap.gameOver) {
+                game = shared.nextGame.fetch_add(1, std::memory_order_relaxed);
+                move = 0;
+                sim.apply({Command::Reset, game});
+                sim.apply({Command::Resume});
+                continue;
+            }
+
+            // Poses jouables d'un coup : les chemins avec descente rapide sont écartés, comme pour Autoplayer
+            search.setBoard(snap.board);
+            const auto& placements = search.placements(snap.current);
+            playable.clear();
+            for (std::size_t i = 0; i < placements.size(); i++) {
+                keys = search.path(placements[i]);
+                if (std::find(keys.begin(), keys.end(), Key::SoftDrop) == keys.end()) playable.push_back(i);
+            }
+            if (playable.empty()) {
+                sim.play({Key::HardDrop});
+                while (sim.isWaiting() && sim.isRunning()) sim.tick();
+                sim.clearEvents();
+                continue;
+            }
+
+            std::size_t choice = 0;
+            bool explored = coin(rng) < config.explore;
+            if (explored) {
+                choice = std::uniform_int_distribution<std::size_t>(0, playable.size() - 1)(rng);
+            } else {
+                double best = 0.0;
+                for (std::size_t i = 0; i < playable.size(); i++) {
+                    double rating = Autoplayer::rate(snap.board, placements[playable[i]].blocks);
+                    if (i == 0 || rating > best) {
+                        best = rating;
+                        choice = i;
+                    }
+                }
+            }
+            const Placement& p = placements[playable[choice]];
+
+            Record& r = batch.emplace_back();
+            for (int y = 0; y < config.height; y++) r.rows[y] = static_cast<std::uint16_t>(snap.board.getRowBits(y));
+            r.game = game;
+            r.move = move++;
+            r.piece = snap.current.getId();
+            r.next = snap.next.getId();
+            r.rotation = static_cast<std::uint8_t>(p.rotation);
+            int minX = p.blocks[0].x, minY = p.blocks[0].y;
+            for (const auto& b : p.blocks) {
+                minX = std::min(minX, b.x);
+                minY = std::min(minY, b.y);
+            }
+            r.x = static_cast<std::int8_t>(minX);
+            r.y = static_cast<std::int8_t>(minY);
+            r.flags = explored ? Explored : 0;
+            r.choice = static_cast<std::uint8_t>(std::min<std::size_t>(choice, 255));
+            r.choices = static_cast<std::uint8_t>(std::min<std::size_t>(playable.size(), 255));
+
+            scoreBefore = snap.score;
+            linesBefore = snap.lines;
+            pending = true;
+            sim.play(search.path(p));
+            while (sim.isWaiting() && sim.isRunning()) sim.tick();
+            sim.clearEvents();
+        }
+
+        // Ligne dont le résultat n'est pas connu : écartée plutôt qu'écrite incomplète
+        if (pending) batch.pop_back();
+        if (!batch.empty()) flush();
+    }
+}
+
+/**
+ * @param header En-tête complet (voir `makeHeader`) ; les noms des pièces le suivent.
+ */
+Writer::Writer(const std::string& path, const FileHeader& header, const PieceSet& pieces)
+    : file(path, std::ios::binary | std::ios::trunc), headerSize(header.headerSize)
+{
+    if (!file) return;
+    std::vector<char> bytes(header.headerSize, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    for (std::size_t i = 0; i < pieces.size(); i++) {
+        const std::string& name = pieces[i].name;
+        std::memcpy(bytes.data() + sizeof(header) + i * NAME_SIZE, name.data(), std::min(name.size(), NAME_SIZE));
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool Writer::append(std::span<const Record> batch, std::uint64_t limit) {
+    std::lock_guard<std::mutex> guard(lock);
+    std::uint64_t count = written.load(std::memory_order_relaxed);
+    if (count >= limit || !file) return false;
+
+    std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(batch.size(), limit - count));
+    file.write(reinterpret_cast<const char*>(batch.data()), static_cast<std::streamsize>(n * sizeof(Record)));
+    written.store(count + n, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < n; i++) {
+        if (batch[i].flags & GameOver) ended.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (count + n >= limit) file.flush();
+    return count + n < limit && static_cast<bool>(file);
+}
+
+std::uint64_t Writer::bytes() const {
+    return headerSize + records() * sizeof(Record);
+}
+
+/**
+ * @throws std::invalid_argument Si le plateau dépasse `MAX_COLUMNS` x `MAX_ROWS`
+ * ou si le jeu a plus de 255 pièces.
+ */
+FileHeader makeHeader(const Config& config, const PieceSet& pieces) {
+    if (config.width < 4 || config.width > MAX_COLUMNS || config.height < 4 || config.height > MAX_ROWS) {
+        throw std::invalid_argument("dataset : plateau limite a 16 x 24");
+    }
+    if (pieces.size() >= NO_PIECE) throw std::invalid_argument("dataset : 254 pieces au plus");
+
+    FileHeader header;
+    std::size_t size = sizeof(FileHeader) + pieces.size() * NAME_SIZE;
+    header.headerSize = static_cast<std::uint16_t>((size + 63) / 64 * 64);
+    header.recordSize = sizeof(Record);
+    header.width = static_cast<std::uint8_t>(config.width);
+    header.height = static_cast<std::uint8_t>(config.height);
+    header.pieceCount = static_cast<std::uint16_t>(pieces.size());
+    header.seed = config.seed;
+    header.explorePermille = static_cast<std::uint32_t>(std::clamp(config.explore, 0.0, 1.0) * 1000.0 + 0.5);
+    return header;
+}
+
+Stats run(const Config& config, const PieceSet& pieces, Writer& writer, const std::atomic<bool>& stop) {
+    makeHeader(config, pieces); // mêmes limites que le fichier
+
+    Stats stats;
+    stats.threads = std::max(1u, config.threads ? config.threads : std::thread::hardware_concurrency());
+    Shared shared;
+
+    // Grille 10 x 20 fixée à la compilation pour le jeu standard, taille à l'exécution sinon
+    const bool standard = config.width == 10 && config.height == 20;
+    auto play = [&](unsigned i) {
+        if (standard) produce<StandardBoard>(i, config, pieces, writer, shared, stop);
+        else produce<Board>(i, config, pieces, writer, shared, stop);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::jthread> workers;
+    for (unsigned i = 1; i < stats.threads; i++) workers.emplace_back(play, i);
+    play(0);
+    workers.clear();
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.samples = writer.records();
+    stats.games = writer.games();
+    stats.bytes = writer.bytes();
+    return stats;
+}
+
+}
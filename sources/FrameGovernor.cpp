@@ -0,0 +1,96 @@
+#include "../includes/FrameGovernor.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+    /// Poids de la dernière image dans la moyenne lissée (environ 5 images).
+    constexpr double SMOOTHING = 0.2;
+}
+
+FrameGovernor::FrameGovernor(double budgetMs) : budgetMs(std::max(budgetMs, 0.0)) {}
+
+/**
+ * @brief Change le budget ; 0 rétablit tous les effets et n'en retire plus.
+ */
+void FrameGovernor::setBudget(double ms) {
+    budgetMs = std::max(ms, 0.0);
+    if (!enabled()) {
+        current = Level::Full;
+        budgetState = Budget::Headroom;
+    }
+    overFrames = 0;
+    headroomSeconds = 0.f;
+}
+
+/**
+ * @brief Compte une image et décide du niveau des suivantes.
+ *
+ * Une image n'est comptée hors budget pour la descente que si elle l'est
+ * elle-même et que la moyenne l'est aussi : la moyenne, en retard après une
+ * descente, ne fait pas retirer un second effet à elle seule.
+ */
+bool FrameGovernor::frame(double workMs, float dt) {
+    frames++;
+    worstMs = std::max(worstMs, workMs);
+    secondsAt[static_cast<std::size_t>(current)] += dt;
+
+    // Panneau lent : une mise à jour tous les 1/SLOW_HUD_HZ s
+    hudSeconds += dt;
+    hudDue = hudSeconds >= 1.f / SLOW_HUD_HZ;
+    if (hudDue) hudSeconds = 0.f;
+
+    if (!enabled()) return false;
+
+    if (workMs > budgetMs) framesOver++;
+    average = frames == 1 ? workMs : average + SMOOTHING * (workMs - average);
+
+    if (average > OVER * budgetMs) budgetState = Budget::Over;
+    else if (average < HEADROOM * budgetMs) budgetState = Budget::Headroom;
+    else budgetState = Budget::Tight;
+
+    bool over = budgetState == Budget::Over && workMs > OVER * budgetMs;
+    overFrames = over ? overFrames + 1 : 0;
+    if (workMs > SPIKE * budgetMs || overFrames >= DEGRADE_FRAMES) {
+        if (current == Level::SlowHud) return false;
+        change(+1);
+        return true;
+    }
+
+    headroomSeconds = budgetState == Budget::Headroom ? headroomSeconds + dt : 0.f;
+    if (headroomSeconds >= RESTORE_SECONDS && current != Level::Full) {
+        change(-1);
+        return true;
+    }
+    return false;
+}
+
+void FrameGovernor::change(int delta) {
+    current = static_cast<Level>(static_cast<int>(current) + delta);
+    if (delta > 0) degrades++;
+    else restores++;
+    overFrames = 0;
+    headroomSeconds = 0.f;
+    hudDue = true;
+}
+
+/**
+ * @brief Affiche le budget, les images hors budget et le temps passé à chaque niveau.
+ *
+ * @param out Flux de sortie (ex. `std::clog`).
+ */
+void FrameGovernor::report(std::ostream& out) const {
+    if (frames == 0) return;
+    double total = 0.0;
+    for (double s : secondsAt) total += s;
+
+    out << std::fixed << std::setprecision(2);
+    out << "[budget] " << budgetMs << " ms par image : " << framesOver << " image(s) hors budget sur " << frames
+        << ", pire " << worstMs << " ms ; " << degrades << " descente(s), " << restores << " remontee(s)\n";
+    for (std::size_t i = 0; i < secondsAt.size(); i++) {
+        if (secondsAt[i] <= 0.0) continue;
+        out << "[budget] " << std::left << std::setw(14) << toString(static_cast<Level>(i)) << std::right
+            << std::setw(9) << secondsAt[i] << " s" << std::setw(8) << (total > 0 ? 100.0 * secondsAt[i] / total : 0.0)
+            << " %\n";
+    }
+    out << std::flush;
+}
@@ -0,0 +1,53 @@
+#include "../includes/FrameProfiler.hpp"
+#include <iomanip>
+
+/**
+ * @brief Démarre les mesures (instant zéro).
+ */
+FrameProfiler::FrameProfiler()
+    : lastWall(std::chrono::steady_clock::now()), lastCpu(std::clock())
+{}
+
+/**
+ * @brief Attribue le temps écoulé depuis le dernier appel à l'état précédent.
+ *
+ * @param current État actif à partir de maintenant.
+ */
+void FrameProfiler::tick(GameState current) {
+    auto wall = std::chrono::steady_clock::now();
+    std::clock_t cpu = std::clock();
+
+    Bucket& b = buckets[index(lastState)];
+    b.wallSeconds += std::chrono::duration<double>(wall - lastWall).count();
+    b.cpuSeconds += static_cast<double>(cpu - lastCpu) / CLOCKS_PER_SEC;
+    b.iterations++;
+
+    lastWall = wall;
+    lastCpu = cpu;
+    lastState = current;
+}
+
+/**
+ * @brief Affiche, pour chaque état visité, le temps passé, l'usage CPU et le débit d'images.
+ *
+ * @param out Flux de sortie (ex. `std::clog`).
+ */
+void FrameProfiler::report(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2);
+    out << "[profil] etat        temps(s)   cpu(s)   cpu(%)   tours   images  images/s\n";
+    for (std::size_t i = 0; i < buckets.size(); i++) {
+        const Bucket& b = buckets[i];
+        if (b.iterations == 0) continue;
+
+        double cpuPercent = b.wallSeconds > 0 ? 100.0 * b.cpuSeconds / b.wallSeconds : 0.0;
+        double fps = b.wallSeconds > 0 ? b.frames / b.wallSeconds : 0.0;
+        out << "[profil] " << std::left << std::setw(10) << toString(static_cast<GameState>(i))
+            << std::right << std::setw(10) << b.wallSeconds
+            << std::setw(9) << b.cpuSeconds
+            << std::setw(9) << cpuPercent
+            << std::setw(8) << b.iterations
+            << std::setw(9) << b.frames
+            << std::setw(10) << fps << '\n';
+    }
+    out << std::flush;
+}
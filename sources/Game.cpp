@@ -1,45 +1,216 @@
 #include "../includes/Game.hpp"
-#include <cstdlib>
+#include "../includes/Gravity.hpp"
+#include "../includes/Resources.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <ctime>
 #include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+    /// Tailles de caractères utilisées par l'interface (18 à 50 px).
+    constexpr std::array<unsigned, 8> PREBAKED_SIZES {18, 20, 22, 24, 25, 30, 40, 50};
+
+    /// Attente maximale d'un événement sur un écran inactif avant de reboucler.
+    const sf::Time IDLE_TIMEOUT = sf::milliseconds(250);
+    /// Intervalle de sommeil entre deux consultations de la file d'événements.
+    const sf::Time IDLE_POLL_INTERVAL = sf::milliseconds(10);
+
+    /// Survol inconnu : force le recalcul des couleurs au changement d'écran.
+    constexpr int HOVER_UNKNOWN = -2;
+
+    /// Retour arrière maintenu : délai avant le retour continu, puis une pose annulée par intervalle.
+    constexpr float REWIND_DELAY = 0.35f;
+    constexpr float REWIND_INTERVAL = 0.05f;
+
+    /// Temps accordé à chaque recherche de l'aide au perfect clear.
+    constexpr double HINT_BUDGET_MS = 250.0;
+
+    const sf::Color BUTTON_COLOR(100, 100, 100);
+    const sf::Color BUTTON_HOVER_COLOR(150, 150, 150);
+
+    sf::Keyboard::Key toKeyboard(Key k) {
+        switch (k) {
+            case Key::Left:     return sf::Keyboard::Left;
+            case Key::Right:    return sf::Keyboard::Right;
+            case Key::Rotate:   return sf::Keyboard::Up;
+            case Key::SoftDrop: return sf::Keyboard::Down;
+            case Key::HardDrop: return sf::Keyboard::Space;
+        }
+        return sf::Keyboard::Unknown;
+    }
+}
 
 /**
  * @brief Constructeur de la classe Game.
  *
- * Initialise la fenêtre, le plateau de jeu, charge la police d'écriture,
- * génère les deux premiers Tetrominos (courant et suivant) et configure
- * les boutons du menu.
+ * Charge la police intégrée à l'exécutable, lance le pré-rendu des glyphes
+ * en arrière-plan pendant la création de la fenêtre, prépare la simulation
+ * (démarrée par `run()`) et configure les boutons du menu.
+ * Les boutons de pause ne sont construits qu'à la première pause.
  *
  * @param width Largeur du plateau (en nombre de cases).
  * @param height Hauteur du plateau (en nombre de cases).
  * @param t Taille d'une case (en pixels).
  *
- * @throws std::runtime_error Si la police ne peut pas être chargée.
+ * @throws std::runtime_error Si la police intégrée ne peut pas être chargée.
  */
 Game::Game(int width, int height, int t)
-    : window(sf::VideoMode(width*t + 200, height*t), "Tetris SFML"),
-      board(width, height), tileSize(t), timer(0), delay(0.5f),
-      clearing(false), clearTimer(0.f), gameOver(false),
-      state(GameState::MENU)
+    : font(loadFont()),
+      glyphPrebake(std::async(std::launch::async, [this]() { prebakeGlyphs(); })),
+      window(sf::VideoMode(width*t + 200, height*t), "Tetris SFML"),
+      boardWidth(width), boardHeight(height), tileSize(t),
+      simulation(width, height, static_cast<std::uint32_t>(time(nullptr))),
+      state(GameState::MENU), renderedState(GameState::MENU)
 {
-    srand(time(nullptr));
-    if (!font.loadFromFile("/usr/share/fonts/truetype/noto/NotoSans-Regular.ttf")) {
-        throw std::runtime_error("Impossible de charger la police Noto !");
+    trace.mark("fenetre");
+
+    loadBestScore();
+    trace.mark("simulation et meilleur score");
+
+    // La police ne doit plus être partagée avec le thread de pré-rendu
+    glyphPrebake.get();
+    trace.mark("glyphes pre-rendus");
+
+    setupMenuButtons();
+    updateHover(window.mapPixelToCoords(sf::Mouse::getPosition(window)));
+    trace.mark("boutons du menu");
+
+    // Panneau : police, taille, couleur et position fixes, seul le texte change
+    float infoX = boardWidth * tileSize + 20.f;
+    const std::array<std::tuple<sf::Text*, unsigned, sf::Color, float>, 7> hud = {{
+        {&hudScore, 20, sf::Color::White, 20.f},
+        {&hudBest, 18, sf::Color::Yellow, 50.f},
+        {&hudLevel, 18, sf::Color::Cyan, 80.f},
+        {&hudFinesse, 18, sf::Color::Green, 170.f + tileSize * 5},
+        {&hudMode, 18, sf::Color::White, 200.f + tileSize * 5},
+        {&hudBudget, 14, sf::Color(160, 160, 160), boardHeight * tileSize - 40.f},
+        {&hudHint, 16, sf::Color::Magenta, 300.f + tileSize * 5},
+    }};
+    for (auto [text, size, color, y] : hud) {
+        text->setFont(font);
+        text->setCharacterSize(size);
+        text->setFillColor(color);
+        text->setPosition(infoX, y);
+    }
+}
+
+/**
+ * @brief Ouvre un paquet de puzzles (projeté en mémoire, décodé à la demande).
+ *
+ * @param path Chemin du paquet.
+ * @param first Indice du premier puzzle proposé.
+ * @return false si le paquet est illisible, vide, d'une autre taille de plateau
+ *         ou si `first` est au-delà de son dernier puzzle.
+ */
+bool Game::setPuzzlePack(const std::string& path, std::uint32_t first) {
+    auto pack = std::make_unique<puzzle::Pack>(path);
+    if (!pack->isValid() || pack->size() == 0 ||
+        pack->getWidth() != boardWidth || pack->getHeight() != boardHeight) {
+        std::cerr << "Paquet de puzzles invalide : " << path << std::endl;
+        return false;
     }
 
-    current = std::make_unique<Tetromino>(TetrominoType(rand()%7), width/2);
-    next = std::make_unique<Tetromino>(TetrominoType(rand()%7), width/2);
+    if (first >= pack->size()) {
+        std::cerr << "Puzzle " << first + 1 << " absent de " << path << " (1 a " << pack->size() << ")" << std::endl;
+        return false;
+    }
 
+    puzzleIndex = first;
+    puzzlePack = std::move(pack);
     setupMenuButtons();
-    setupPauseButtons();
+    hoveredButton = -2;
+    screenDirty = true;
+    return true;
+}
 
-    loadBestScore();
+/**
+ * @brief Remplace les tétrominos par un jeu de pièces lu dans un fichier.
+ *
+ * À appeler avant `run()` : la simulation ne doit pas encore tourner.
+ * Les puzzles gardent leurs tétrominos.
+ *
+ * @param path Chemin du fichier de pièces (format décrit dans PieceSet.hpp).
+ * @return false si le fichier est illisible ou invalide (les tétrominos sont conservés).
+ */
+bool Game::setPieceSet(const std::string& path) {
+    std::string error;
+    auto set = PieceSet::load(path, error);
+    if (!set) {
+        std::cerr << "Jeu de pieces invalide : " << error << std::endl;
+        return false;
+    }
+
+    pieceSet = std::make_unique<PieceSet>(std::move(*set));
+    simulation.setPieceSet(*pieceSet);
+    return true;
+}
+
+/**
+ * @brief Crée le flux d'état en mémoire partagée et le confie à la simulation.
+ *
+ * À appeler avant `run()` : l'écriture se fait sur le thread de simulation,
+ * jamais sur celui de l'affichage.
+ *
+ * @param name Nom POSIX du segment (ex. "/tetris-feed").
+ * @return false si le segment ne peut être créé (le jeu tourne sans flux).
+ */
+bool Game::setStateFeed(const std::string& name) {
+    auto writer = std::make_unique<feed::Writer>(name, boardWidth, boardHeight);
+    if (!writer->isOpen()) {
+        std::cerr << "Flux d'etat " << name << " indisponible : " << writer->error() << std::endl;
+        return false;
+    }
+
+    stateFeed = std::move(writer);
+    simulation.setStateFeed(stateFeed.get());
+    return true;
+}
+
+/**
+ * @brief Charge la police compilée dans l'exécutable.
+ *
+ * @return sf::Font La police prête à l'emploi.
+ *
+ * @throws std::runtime_error Si les données intégrées sont invalides.
+ */
+sf::Font Game::loadFont() {
+    sf::Font f;
+    if (!f.loadFromMemory(resources::defaultFontData, resources::defaultFontSize)) {
+        throw std::runtime_error("Impossible de charger la police integree !");
+    }
+    trace.mark("police integree");
+    return f;
+}
+
+/**
+ * @brief Pré-rend les caractères ASCII imprimables dans la texture de la police.
+ *
+ * Exécutée sur un thread secondaire : chaque taille utilisée par l'interface
+ * est rastérisée d'avance, ce qui évite les à-coups lors du premier affichage
+ * d'un texte.
+ *
+ * @warning La police ne doit pas être utilisée par un autre thread tant que
+ * `glyphPrebake` n'est pas terminé.
+ */
+void Game::prebakeGlyphs() {
+    sf::Context context; // contexte OpenGL propre au thread pour mettre à jour la texture
+    for (unsigned size : PREBAKED_SIZES) {
+        for (sf::Uint32 c = 32; c < 127; c++) {
+            font.getGlyph(c, size, false);
+        }
+    }
 }
 
 /**
  * @brief Gère les clics sur les boutons du menu.
  *
- * @param mousePos Position actuelle de la souris dans la fenêtre.
+ * @param mousePos Position du clic dans la fenêtre.
  */
 void Game::handleMenuClick(const sf::Vector2f& mousePos) {
     for (auto& btn : menuButtons) {
@@ -51,9 +222,9 @@ void Game::handleMenuClick(const sf::Vector2f& mousePos) {
 }
 
 /**
- * @brief Gère les clics sur les boutons du menu.
+ * @brief Gère les clics sur les boutons du menu pause.
  *
- * @param mousePos Position actuelle de la souris dans la fenêtre.
+ * @param mousePos Position du clic dans la fenêtre.
  */
 void Game::handlePauseClick(const sf::Vector2f& mousePos) {
     for (auto& btn : pauseButtons) {
@@ -65,188 +236,425 @@ void Game::handlePauseClick(const sf::Vector2f& mousePos) {
 }
 
 /**
- * @brief Gère tous les événements de la fenêtre (clavier et souris).
+ * @brief Traite tous les événements en attente de la fenêtre.
+ *
+ * @see Game::handleEvent()
+ */
+void Game::processEvents() {
+    sf::Event e;
+    while (window.pollEvent(e)) {
+        handleEvent(e);
+    }
+}
+
+/**
+ * @brief Gère un événement de la fenêtre (clavier et souris).
  *
  * - Ferme la fenêtre si l'événement est Closed.
+ * - Met à jour le survol des boutons sur MouseMoved.
  * - Gère les clics sur le menu.
  * - Retour au menu avec ESC depuis Aide ou À propos.
  * - Met le jeu en pause ou le reprend avec P.
- * - Déplace, fait tourner ou fait descendre le Tetromino courant.
- * - Effectue le "Hard Drop" avec la touche Espace.
+ * - Transmet à la simulation les déplacements, rotations, descentes
+ *   et le "Hard Drop" (touche Espace).
+ * - Mode entraînement : Retour arrière annule la dernière pose, y compris
+ *   depuis l'écran de fin (maintenu : retour continu, voir `update()`).
+ *
+ * @param e L'événement à traiter.
  */
-void Game::processEvents() {
-    sf::Event e;
-    while (window.pollEvent(e)) {
-        if (e.type == sf::Event::Closed) window.close();
+void Game::handleEvent(const sf::Event& e) {
+    if (e.type == sf::Event::Closed) window.close();
 
-        // --- Gestion du Game Over ---
-        if (state == GameState::GAME_OVER) {
-            if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::R) {
-                resetGame();
-            }
-            continue; // On ne fait rien d'autre si on est en Game Over
+    // --- Fenêtre exposée de nouveau : le dernier rendu peut être perdu ---
+    if (e.type == sf::Event::Resized || e.type == sf::Event::GainedFocus) {
+        screenDirty = true;
+    }
+
+    // --- Survol des boutons (uniquement quand la souris bouge) ---
+    if (e.type == sf::Event::MouseMoved) {
+        if (updateHover(window.mapPixelToCoords({e.mouseMove.x, e.mouseMove.y}))) {
+            screenDirty = true;
         }
+    }
 
-        // --- Gestion du Menu ---
-        if (state == GameState::MENU) {
-            if (e.type == sf::Event::MouseButtonPressed &&
-                e.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-                handleMenuClick(mousePos);
-            }
-            continue;
+    // --- Gestion du Game Over ---
+    if (state == GameState::GAME_OVER) {
+        if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::R) {
+            // Puzzle réussi : on passe au suivant ; sinon on le rejoue
+            if (puzzleMode && puzzleResult == 1) puzzleIndex = (puzzleIndex + 1) % puzzlePack->size();
+            resetGame();
+        }
+        // Entraînement : on revient avant la pose fatale
+        if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::BackSpace &&
+            practiceMode && simulation.snapshot().undoDepth > 0) {
+            sendCommand(Command::Undo);
+            heldKeys[sf::Keyboard::BackSpace] = true;
+            rewindTime = 0.f;
+            state = GameState::PLAYING;
         }
+        return; // On ne fait rien d'autre si on est en Game Over
+    }
 
-        // --- Aide et A propos ---
-        if ((state == GameState::HELP || state == GameState::ABOUT) &&
-            e.type == sf::Event::KeyPressed &&
-            e.key.code == sf::Keyboard::Escape) {
-            state = GameState::MENU;
-            continue;
+    // --- Gestion du Menu ---
+    if (state == GameState::MENU) {
+        if (e.type == sf::Event::MouseButtonPressed &&
+            e.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2f mousePos = window.mapPixelToCoords({e.mouseButton.x, e.mouseButton.y});
+            handleMenuClick(mousePos);
         }
+        return;
+    }
 
-        // --- Pause ---
-        if (state == GameState::PAUSED) {
-            // Gestion des clics sur les boutons de pause
-            if (e.type == sf::Event::MouseButtonPressed &&
-                e.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-                handlePauseClick(mousePos);
-            }
+    // --- Aide et A propos ---
+    if ((state == GameState::HELP || state == GameState::ABOUT) &&
+        e.type == sf::Event::KeyPressed &&
+        e.key.code == sf::Keyboard::Escape) {
+        state = GameState::MENU;
+        return;
+    }
 
-            // Reprise rapide avec P
-            if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::P) {
-                state = GameState::PLAYING;
-            }
+    // --- Pause ---
+    if (state == GameState::PAUSED) {
+        // Gestion des clics sur les boutons de pause
+        if (e.type == sf::Event::MouseButtonPressed &&
+            e.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2f mousePos = window.mapPixelToCoords({e.mouseButton.x, e.mouseButton.y});
+            handlePauseClick(mousePos);
+        }
 
-            continue; // Ne pas traiter la logique du jeu si on est en pause
+        // Reprise rapide avec P
+        if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::P) {
+            state = GameState::PLAYING;
         }
 
-        // --- Touche Pause depuis le jeu ---
-        if (state == GameState::PLAYING) {
-            if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::P) {
-                state = GameState::PAUSED;
-                continue;
-            }
+        return; // Ne pas traiter la logique du jeu si on est en pause
+    }
+
+    // --- Touche Pause depuis le jeu ---
+    if (state == GameState::PLAYING) {
+        if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::P) {
+            state = GameState::PAUSED;
+            return;
         }
+        if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::H) {
+            hintMode = !hintMode;
+            return;
+        }
+    }
 
-        // --- Ne pas continuer si Game Over pendant le jeu ---
-        if (gameOver) continue;
+    // --- Actions du joueur : transmises à la simulation ---
+    if (e.type == sf::Event::KeyReleased && e.key.code == sf::Keyboard::Down) {
+        sendCommand(Command::SoftDropRelease);
+    }
 
-        // --- Gestion des mouvements et du Hard Drop ---
-        if (!clearing && e.type == sf::Event::KeyPressed) {
-            if (e.key.code == sf::Keyboard::Left) {
-                current->move(-1,0);
-                if (board.checkCollision(*current)) current->move(1,0);
-            }
-            else if (e.key.code == sf::Keyboard::Right) {
-                current->move(1,0);
-                if (board.checkCollision(*current)) current->move(-1,0);
-            }
-            else if (e.key.code == sf::Keyboard::Up) {
-                auto backup = current->getBlocks();
-                current->rotate();
-                if (board.checkCollision(*current)) current->setBlocks(backup);
-            }
-            else if (e.key.code == sf::Keyboard::Down) delay = 0.05f;
-            else if (e.key.code == sf::Keyboard::Space) {
-                while (!board.checkCollision(*current)) current->move(0,1);
-                current->move(0,-1);
-
-                board.mergeTetromino(*current);
-                board.detectLinesToClear();
-
-                if (board.isClearing()) {
-                    clearing = true;
-                    clearTimer = 0;
-                } else {
-                    current = std::move(next);
-                    next = std::make_unique<Tetromino>(TetrominoType(rand()%7), board.getWidth()/2);
-                    if (board.checkCollision(*current)) {
-                        gameOver = true;
-                        state = GameState::GAME_OVER;
-                    }
+    bool knownKey = e.key.code >= 0 && e.key.code < sf::Keyboard::KeyCount;
+    if (e.type == sf::Event::KeyReleased && knownKey) {
+        heldKeys[e.key.code] = false;
+    }
+
+    if (e.type == sf::Event::KeyPressed) {
+        bool repeat = knownKey && heldKeys[e.key.code];
+        if (knownKey) heldKeys[e.key.code] = true;
+
+        switch (e.key.code) {
+            case sf::Keyboard::Left:  sendCommand(Command::MoveLeft, repeat); break;
+            case sf::Keyboard::Right: sendCommand(Command::MoveRight, repeat); break;
+            case sf::Keyboard::Up:    sendCommand(Command::Rotate); break;
+            case sf::Keyboard::Down:  sendCommand(Command::SoftDropPress, repeat); break;
+            case sf::Keyboard::Space: sendCommand(Command::HardDrop); break;
+            case sf::Keyboard::BackSpace:
+                if (practiceMode && !repeat) {
+                    sendCommand(Command::Undo);
+                    rewindTime = 0.f;
                 }
-                timer = 0;
-            }
+                break;
+            default: break;
         }
     }
 }
 
 /**
- * @brief Calcule la position du "Ghost Piece" (ombre du Tetromino).
+ * @brief Indique si l'écran courant est statique (menu, aide, à propos, pause).
+ *
+ * Ces écrans ne changent qu'en réponse à un événement : ils ne sont redessinés
+ * que lorsque le survol, l'état ou la fenêtre l'exigent.
+ */
+bool Game::isIdleScreen() const {
+    return state == GameState::MENU || state == GameState::HELP ||
+           state == GameState::ABOUT || state == GameState::PAUSED;
+}
+
+/**
+ * @brief Attend un événement pendant au plus `timeout`.
+ *
+ * SFML 2 ne propose pas de `waitEvent` avec délai : la file est consultée
+ * puis le thread dort par courtes tranches, ce qui garde l'usage CPU proche de zéro.
+ *
+ * @param e Reçoit l'événement.
+ * @param timeout Durée d'attente maximale.
+ * @return true si un événement a été reçu, false si le délai a expiré.
+ */
+bool Game::waitEventFor(sf::Event& e, sf::Time timeout) {
+    sf::Clock waited;
+    while (window.isOpen()) {
+        if (window.pollEvent(e)) return true;
+        if (waited.getElapsedTime() >= timeout) return false;
+        sf::sleep(IDLE_POLL_INTERVAL);
+    }
+    return false;
+}
+
+/**
+ * @brief Un tour de boucle pour un écran inactif.
+ *
+ * Bloque jusqu'au prochain événement (ou l'expiration du délai), le traite,
+ * puis ne redessine que si l'état, le survol ou la fenêtre ont changé.
+ *
+ * @return true si une image a été affichée.
+ */
+bool Game::runIdleScreen() {
+    if (state == renderedState && !screenDirty) {
+        sf::Event e;
+        if (!waitEventFor(e, IDLE_TIMEOUT)) return false;
+        handleEvent(e);
+        processEvents();
+    }
+
+    // Retour au jeu : le rendu se fait dans la boucle normale
+    if (!window.isOpen() || !isIdleScreen()) return false;
+
+    if (state != renderedState) {
+        // Nouvel écran : la position de la souris n'est lue qu'une fois
+        hoveredButton = HOVER_UNKNOWN;
+        updateHover(window.mapPixelToCoords(sf::Mouse::getPosition(window)));
+        screenDirty = true;
+    }
+
+    if (!screenDirty) return false;
+    render();
+    window.display();
+    return true;
+}
+
+/**
+ * @brief Retourne les boutons de l'écran courant (menu ou pause), ou nullptr.
  *
- * Le Ghost Piece est affiché en transparence pour indiquer où le Tetromino
- * courant atterrira s'il est lâché directement.
+ * Les boutons de pause sont construits ici au premier besoin.
+ */
+std::vector<Button>* Game::activeButtons() {
+    if (state == GameState::MENU) return &menuButtons;
+    if (state == GameState::PAUSED) {
+        if (pauseButtons.empty()) setupPauseButtons();
+        return &pauseButtons;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Met à jour le bouton survolé et sa couleur.
  *
- * @return Tetromino Copie du Tetromino courant positionné en bas.
+ * @param mousePos Position de la souris dans la fenêtre.
+ * @return true si le survol a changé (l'écran doit être redessiné).
  */
-Tetromino Game::computeGhost() const {
-    Tetromino ghost = *current;
-    ghost.setColor(sf::Color(200,200,200,120));
-    while (!board.checkCollision(ghost)) ghost.move(0,1);
-    ghost.move(0,-1);
-    return ghost;
+bool Game::updateHover(const sf::Vector2f& mousePos) {
+    std::vector<Button>* buttons = activeButtons();
+    if (!buttons) return false;
+
+    int hovered = -1;
+    for (size_t i = 0; i < buttons->size(); i++) {
+        if ((*buttons)[i].isMouseOver(mousePos)) {
+            hovered = static_cast<int>(i);
+            break;
+        }
+    }
+    if (hovered == hoveredButton) return false;
+
+    hoveredButton = hovered;
+    for (size_t i = 0; i < buttons->size(); i++) {
+        (*buttons)[i].shape.setFillColor(static_cast<int>(i) == hovered ? BUTTON_HOVER_COLOR : BUTTON_COLOR);
+    }
+    return true;
 }
 
 /**
- * @brief Met à jour la logique du jeu (mouvement automatique, fusion des Tetrominos, lignes à effacer).
+ * @brief Met à jour l'affichage à partir des événements publiés par la simulation.
+ *
+ * La logique du jeu tourne sur le thread de simulation ; ici on ne fait que
+ * suivre la télémétrie, le meilleur score et la fin de partie.
  *
  * @param dt Temps écoulé depuis la dernière frame (en secondes).
  */
 void Game::update(float dt) {
-    if (state != GameState::PLAYING || gameOver) return;
-
-    if (clearing) {
-        clearTimer += dt;
-        if (clearTimer > 0.3f) {
-            int cleared = board.getLinesToClear().size(); // nombre de lignes supprimées
-            board.performClearLines();
-
-            // ✅ Mise à jour du score et du niveau
-            if (cleared > 0) {
-                score += cleared * 100;        // 100 points par ligne
-                level = 1 + score / 1000;      // +1 niveau tous les 1000 points
-                if (score > bestScore) bestScore = score;
-
-                // ✅ Ajuste la vitesse du jeu en fonction du niveau
-                delay = std::max(0.1f, 0.5f - (level - 1) * 0.05f);
-            }
+    simulation.refresh();
 
-            clearing = false;
-            clearTimer = 0;
-            current = std::move(next);
-            next = std::make_unique<Tetromino>(TetrominoType(rand()%7), board.getWidth()/2);
-            if (board.checkCollision(*current)) {
-                gameOver = true;
-                state = GameState::GAME_OVER;
-            }
+    if (state == GameState::PLAYING) {
+        if (!puzzleMode && !practiceMode) {
+            if (!gameTelemetry.isActive()) gameTelemetry.begin();
+            gameTelemetry.advance(dt);
+        }
+        particles.update(dt);
+
+        // Retour arrière maintenu : retour continu, une pose à la fois
+        if (practiceMode && heldKeys[sf::Keyboard::BackSpace]) {
+            rewindTime += dt;
+            for (; rewindTime >= REWIND_DELAY; rewindTime -= REWIND_INTERVAL) sendCommand(Command::Undo);
         }
-        return;
     }
 
-    timer += dt;
-    if (timer > delay) {
-        current->move(0,1);
-
-        if (board.checkCollision(*current)) {
-            current->move(0,-1);
-            board.mergeTetromino(*current);
-            board.detectLinesToClear();
-
-            if (board.isClearing()) {
-                clearing = true;
-                clearTimer = 0;
-            } else {
-                current = std::move(next);
-                next = std::make_unique<Tetromino>(TetrominoType(rand()%7), board.getWidth()/2);
-                if (board.checkCollision(*current)) {
-                    gameOver = true;
-                    state = GameState::GAME_OVER;
+    GameEvent e;
+    while (simulation.pollEvent(e)) {
+        if (e.gameId != gameId) continue; // partie précédente
+
+        switch (e.type) {
+            case GameEvent::Type::PiecePlaced:  gameTelemetry.onPiecePlaced(e.value); break;
+            case GameEvent::Type::LinesCleared:
+                gameTelemetry.onLinesCleared(e.value);
+                if (governor.drawExplosions()) particles.emitLineClear(static_cast<std::uint32_t>(e.extra), boardWidth, tileSize);
+                break;
+            case GameEvent::Type::PuzzleEnded:
+                puzzleResult = e.value;
+                break;
+            case GameEvent::Type::Finesse:
+                if (e.value > e.extra) {
+                    finesseFaults++;
+                    finesseExtraKeys += e.value - e.extra;
                 }
-            }
+                break;
+            case GameEvent::Type::HardDropped:
+                if (governor.drawExplosions()) {
+                    particles.emitHardDrop(e.extra & 0xFF, (e.extra >> 8) & 0xFF, e.extra >> 16, e.value, tileSize);
+                }
+                break;
+            case GameEvent::Type::LevelChanged:
+                gameTelemetry.onLevelChanged(e.value);
+                if (governor.drawExplosions()) particles.emitLevelUp(boardWidth, boardHeight, tileSize);
+                break;
+            case GameEvent::Type::GameOver:
+                state = GameState::GAME_OVER;
+                finishTelemetry(e.value, e.extra);
+                break;
+            case GameEvent::Type::Undone:
+                // Les particules de la pose annulée n'ont plus rien sous elles
+                gameTelemetry.onUndone(e.value, e.extra != 0);
+                particles.clear();
+                break;
+        }
+    }
+
+    const GameSnapshot& snap = simulation.snapshot();
+    if (!puzzleMode && !practiceMode && snap.gameId == gameId && snap.score > bestScore) bestScore = snap.score;
+    if (hintMode && state == GameState::PLAYING) updateHint();
+}
+
+/**
+ * @brief Aide au perfect clear : relance la recherche quand la grille ou la pièce change.
+ *
+ * La recherche tourne sur un thread à part, avec un budget de `HINT_BUDGET_MS` ;
+ * une recherche devenue inutile est interrompue et son résultat ignoré. Les pièces
+ * connues sont la pièce courante et la suivante, ou toute la suite restante d'un puzzle.
+ */
+void Game::updateHint() {
+    const GameSnapshot& snap = simulation.snapshot();
+    if (snap.gameId != gameId || snap.waiting) return;
+
+    std::vector<PieceId> sequence;
+    if (snap.piecesLeft >= 0) {
+        std::size_t played = puzzlePieces.size() - std::min<std::size_t>(snap.piecesLeft, puzzlePieces.size());
+        sequence.assign(puzzlePieces.begin() + played, puzzlePieces.end());
+    } else {
+        sequence = {snap.current.getId(), snap.next.getId()};
+    }
+
+    // Clé : lignes de bits de la grille, puis la suite de pièces
+    std::vector<std::uint32_t> key;
+    key.reserve(boardHeight + sequence.size());
+    for (int y = 0; y < boardHeight; y++) key.push_back(snap.board.getRowBits(y));
+    key.insert(key.end(), sequence.begin(), sequence.end());
+
+    if (clearSearch.valid()) {
+        if (clearSearch.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            clearHint = clearSearch.get();
+            hintKey = std::move(searchKey);
+        } else {
+            if (key != searchKey) clearSolver->cancel();
+            hintCurrent = false;
+            return;
         }
-        timer = 0;
+    }
+    hintCurrent = key == hintKey;
+    if (hintCurrent) return;
+
+    // Les puzzles gardent leurs tétrominos
+    const PieceSet& pieces = snap.piecesLeft < 0 && pieceSet ? *pieceSet : PieceSet::standard();
+    if (!clearSolver || clearPieces != &pieces) {
+        bot::ClearConfig config;
+        config.budgetMs = HINT_BUDGET_MS;
+        try {
+            clearSolver = std::make_unique<bot::PerfectClear>(boardWidth, boardHeight, pieces, config);
+        } catch (const std::invalid_argument& err) {
+            std::cerr << err.what() << std::endl;
+            hintMode = false;
+            return;
+        }
+        clearPieces = &pieces;
+    }
+    searchKey = std::move(key);
+    clearSearch = std::async(std::launch::async, [this, board = snap.board, sequence = std::move(sequence)]() {
+        return clearSolver->solve(board, sequence);
+    });
+}
+
+/**
+ * @brief Contour de la prochaine pose de la solution trouvée par l'aide.
+ */
+void Game::drawHint() {
+    if (!hintCurrent || !clearHint.found || clearHint.placements.empty()) return;
+
+    sf::RectangleShape cell(sf::Vector2f(tileSize - 5.f, tileSize - 5.f));
+    cell.setFillColor(sf::Color::Transparent);
+    cell.setOutlineColor(sf::Color::Magenta);
+    cell.setOutlineThickness(2.f);
+    for (const auto& b : clearHint.placements.front()) {
+        cell.setPosition(b.x * tileSize + 2.f, b.y * tileSize + 2.f);
+        window.draw(cell);
+    }
+}
+
+/**
+ * @brief Met la simulation en marche en jeu, et en pause sur tous les autres écrans.
+ */
+void Game::syncSimulation() {
+    bool shouldRun = state == GameState::PLAYING;
+    if (shouldRun != simulationRunning) {
+        sendCommand(shouldRun ? Command::Resume : Command::Pause);
+        simulationRunning = shouldRun;
+    }
+}
+
+/**
+ * @brief Envoie une commande à la simulation pour la partie en cours.
+ *
+ * @param repeat Vrai pour une répétition automatique (touche maintenue).
+ */
+void Game::sendCommand(Command type, bool repeat) {
+    simulation.send({type, gameId, repeat});
+}
+
+/**
+ * @brief Termine l'enregistrement de la partie en cours et l'ajoute au fichier de télémétrie.
+ *
+ * Sans effet si aucune partie n'est enregistrée ou si la télémétrie est désactivée.
+ *
+ * @param finalScore Score final de la partie.
+ * @param finalLevel Niveau final de la partie.
+ *
+ * @warning Si le fichier n'est pas accessible en écriture, la sauvegarde échoue silencieusement.
+ */
+void Game::finishTelemetry(int finalScore, int finalLevel) {
+    if (!gameTelemetry.isActive()) return;
+    auto record = gameTelemetry.finish(finalScore, finalLevel);
+    if (!telemetryPath.empty()) {
+        telemetry::appendSegment(telemetryPath, {record});
     }
 }
 
@@ -263,20 +671,15 @@ void Game::update(float dt) {
  *   pour qu'elle soit centrée dans le cadre, puis dessine chaque bloc.
  *
  * @note
- * - La fonction retourne immédiatement si aucun Tetromino suivant n'est défini (`next == nullptr`).
+ * - La pièce est lue dans le dernier état publié par la simulation.
  * - Les coordonnées des blocs sont recalculées pour qu'ils s'affichent proprement
- *   dans un espace restreint de 4x5 cases.
- *
- * @warning
- * La fonction suppose que `next` est une pièce valide (pas de vérification approfondie
- * sur l'intégrité des données).
+ *   dans un espace restreint de 4x5 cases (centrées d'après la boîte englobante,
+ *   pour toute taille de pièce).
  *
  * @see Game::render() Pour l'endroit où cette fonction est appelée.
  */
 void Game::drawNextPiece() {
-    if (!next) return;
-
-    float panelX = board.getWidth() * tileSize + 20.f;
+    float panelX = boardWidth * tileSize + 20.f;
     float panelY = 150.f;
 
     // Titre
@@ -294,25 +697,30 @@ void Game::drawNextPiece() {
     window.draw(box);
 
     // Copie de la pièce suivante pour la dessiner dans le cadre
-    Tetromino preview = *next;
+    Tetromino preview = simulation.snapshot().next;
 
     // On récupère ses blocs pour les repositionner
     auto blocks = preview.getBlocks();
 
-    // Trouver les minX et minY pour "normaliser" les coordonnées
+    // Boîte englobante, pour centrer la pièce quelle que soit sa taille
     int minX = blocks[0].x, minY = blocks[0].y;
+    int maxX = minX, maxY = minY;
     for (auto &b : blocks) {
-        if (b.x < minX) minX = b.x;
-        if (b.y < minY) minY = b.y;
+        minX = std::min(minX, b.x);
+        minY = std::min(minY, b.y);
+        maxX = std::max(maxX, b.x);
+        maxY = std::max(maxY, b.y);
     }
+    float originX = panelX + (box.getSize().x - (maxX - minX + 1) * tileSize) / 2.f;
+    float originY = panelY + (box.getSize().y - (maxY - minY + 1) * tileSize) / 2.f;
 
     // Décaler et dessiner manuellement les blocs
     sf::RectangleShape rect(sf::Vector2f(tileSize - 1, tileSize - 1));
     rect.setFillColor(preview.getColor());
 
     for (auto &b : blocks) {
-        float drawX = panelX + ((b.x - minX) + 1) * tileSize;
-        float drawY = panelY + ((b.y - minY) + 1) * tileSize;
+        float drawX = originX + (b.x - minX) * tileSize;
+        float drawY = originY + (b.y - minY) * tileSize;
         rect.setPosition(drawX, drawY);
         window.draw(rect);
     }
@@ -330,25 +738,59 @@ void Game::drawNextPiece() {
  * - Le meilleur score (Best) est affiché en jaune.
  * - Le niveau actuel est affiché en cyan.
  *
- * @note Les informations se positionnent en fonction de la largeur du plateau (`board.getWidth()`).
+ * @note Les informations se positionnent en fonction de la largeur du plateau (`boardWidth`).
  */
 void Game::drawScore() {
-    float infoX = board.getWidth() * tileSize + 20.f;
+    if (governor.refreshHud()) updateHud();
+
+    window.draw(hudScore);
+    window.draw(hudBest);
+    window.draw(hudLevel);
+    window.draw(hudFinesse);  // Sous le cadre de la pièce suivante
+    if (!hudMode.getString().isEmpty()) window.draw(hudMode);
+    if (profiling) window.draw(hudBudget);
+    if (hintMode) window.draw(hudHint);
+}
 
-    sf::Text scoreText("Score: " + std::to_string(score), font, 20);
-    scoreText.setFillColor(sf::Color::White);
-    scoreText.setPosition(infoX, 20);
-    window.draw(scoreText);
+/**
+ * @brief Recalcule les textes du panneau à partir du dernier état publié.
+ *
+ * Appelé à chaque image, sauf quand le budget des images impose un panneau lent.
+ */
+void Game::updateHud() {
+    const GameSnapshot& snap = simulation.snapshot();
+
+    hudScore.setString("Score: " + std::to_string(snap.score));
+    hudBest.setString("Best: " + std::to_string(bestScore));
+    hudLevel.setString("Level: " + std::to_string(snap.level));
+    hudFinesse.setString("Finesse: " + std::to_string(finesseFaults) + " (+" + std::to_string(finesseExtraKeys) + ")");
+    hudFinesse.setFillColor(finesseFaults ? sf::Color(255,165,0) : sf::Color::Green);
+
+    if (snap.piecesLeft >= 0) {
+        hudMode.setString("Puzzle " + std::to_string(puzzleIndex + 1) + "/" +
+                          std::to_string(puzzlePack->size()) + "\n" +
+                          "Lignes: " + std::to_string(snap.lines) + "/" + std::to_string(snap.goalLines) + "\n" +
+                          "Pieces: " + std::to_string(snap.piecesLeft));
+    } else if (snap.undoDepth >= 0) {
+        hudMode.setString("Entrainement\n"
+                          "Annulables: " + std::to_string(snap.undoDepth) + "\n"
+                          "Retour arriere :\nannuler la pose");
+    } else {
+        hudMode.setString("");
+    }
 
-    sf::Text bestText("Best: " + std::to_string(bestScore), font, 18);
-    bestText.setFillColor(sf::Color::Yellow);
-    bestText.setPosition(infoX, 50);
-    window.draw(bestText);
+    if (hintMode) {
+        if (!hintCurrent) hudHint.setString("Perfect clear: ...");
+        else if (clearHint.found) hudHint.setString("Perfect clear: " + std::to_string(clearHint.placements.size()) + " pieces");
+        else hudHint.setString(clearHint.timedOut ? "Perfect clear: ?" : "Perfect clear: non");
+    }
 
-    sf::Text levelText("Level: " + std::to_string(level), font, 18);
-    levelText.setFillColor(sf::Color::Cyan);
-    levelText.setPosition(infoX, 80);
-    window.draw(levelText);
+    if (profiling) {
+        char line[64];
+        std::snprintf(line, sizeof(line), "Budget: %.1f/%.1f ms (%s)", governor.averageMs(), governor.budget(),
+                      toString(governor.state()));
+        hudBudget.setString(std::string(line) + "\nEffets: " + toString(governor.level()));
+    }
 }
 
 
@@ -356,10 +798,17 @@ void Game::drawScore() {
  * @brief Dessine tous les éléments en fonction de l'état du jeu.
  *
  * - Menu, Aide, À propos
- * - Plateau de jeu, Tetrominos, lignes effacées
+ * - Plateau de jeu, Tetrominos, lignes effacées (dernier état publié par la simulation)
  * - Écran de pause ou de fin
+ *
+ * L'image n'est pas présentée ici : l'appelant appelle `window.display()`,
+ * après avoir mesuré le temps de travail (l'attente de la synchronisation
+ * verticale n'en fait pas partie).
  */
 void Game::render() {
+    renderedState = state;
+    screenDirty = false;
+
     window.clear(sf::Color::Black);
 
     if (state == GameState::MENU) {
@@ -372,37 +821,40 @@ void Game::render() {
         drawAbout();
     }
     else if (state == GameState::PLAYING || state == GameState::GAME_OVER || state == GameState::PAUSED) {
-        board.drawGrid(window, tileSize);
-        board.draw(window, tileSize);
-
-        if (!clearing) {
-            auto ghost = computeGhost();
-            ghost.draw(window, tileSize);
-            current->draw(window, tileSize);
-        } else {
-            board.drawExplosion(window, tileSize, clearTimer);
+        const GameSnapshot& snap = simulation.snapshot();
+        if (governor.drawGrid()) snap.board.drawGrid(window, tileSize);
+        snap.board.draw(window, tileSize);
+
+        if (!snap.waiting) {
+            if (governor.drawGhost()) snap.ghost.draw(window, tileSize);
+            snap.current.draw(window, tileSize);
+            if (hintMode) drawHint();
         }
+        if (snap.clearing && governor.drawExplosions()) snap.board.drawExplosion(window, tileSize, snap.clearedRows, snap.clearPhase);
+        particles.draw(window);
 
-        if (next) {
-            Tetromino next_display = *next;
-            next_display.move(board.getWidth() + 2, 2);
+        if (snap.piecesLeft < 0 || snap.piecesLeft > 1) {
+            Tetromino next_display = snap.next;
+            next_display.move(boardWidth + 2, 2);
             next_display.draw(window, tileSize);
         }
 
-        if (gameOver) {
+        if (state == GameState::GAME_OVER) {
             // Efface tout avec un fond noir
             window.clear(sf::Color::Black);
 
-            // === Titre Game Over ===
-            sf::Text gameOverText("=== GAME OVER ===", font, 50);
-            gameOverText.setFillColor(sf::Color::Red);
+            // === Titre Game Over (ou résultat du puzzle) ===
+            std::string title = "=== GAME OVER ===";
+            if (puzzleMode) title = puzzleResult == 1 ? "PUZZLE REUSSI" : "PUZZLE ECHOUE";
+            sf::Text gameOverText(title, font, 50);
+            gameOverText.setFillColor(puzzleMode && puzzleResult == 1 ? sf::Color::Green : sf::Color::Red);
             sf::FloatRect bounds = gameOverText.getLocalBounds();
             gameOverText.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
             gameOverText.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f - 80);
             window.draw(gameOverText);
 
             // === Affichage du Score ===
-            sf::Text scoreText("Score : " + std::to_string(score), font, 30);
+            sf::Text scoreText("Score : " + std::to_string(snap.score), font, 30);
             scoreText.setFillColor(sf::Color::Yellow);
             bounds = scoreText.getLocalBounds();
             scoreText.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
@@ -418,14 +870,15 @@ void Game::render() {
             window.draw(bestText);
 
             // === Instructions pour rejouer ===
-            sf::Text infoText("Appuyez sur R pour rejouer", font, 22);
+            std::string info = "Appuyez sur R pour rejouer";
+            if (puzzleMode && puzzleResult == 1) info = "Appuyez sur R pour le puzzle suivant";
+            if (practiceMode && snap.undoDepth > 0) info = "R : rejouer    Retour arriere : annuler";
+            sf::Text infoText(info, font, 22);
             infoText.setFillColor(sf::Color::White);
             bounds = infoText.getLocalBounds();
             infoText.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
             infoText.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f + 80);
             window.draw(infoText);
-
-            window.display();
             return; // Empêche d'afficher le reste du jeu
         }
 
@@ -438,8 +891,6 @@ void Game::render() {
         drawScore();
         drawNextPiece();
     }
-
-    window.display();
 }
 
 
@@ -450,26 +901,38 @@ void Game::render() {
  * ou lorsque l’on souhaite recommencer une nouvelle partie.
  *
  * @details
- * - Réinitialise la grille (`Board`).
- * - Réinitialise le score, le niveau, le timer et les états (`clearing`, `gameOver`, etc.).
- * - Génère un nouveau Tetromino courant et un prochain Tetromino aléatoire.
+ * - Enregistre la télémétrie de la partie abandonnée, le cas échéant.
+ * - Demande à la simulation une nouvelle partie, sous un nouveau numéro : les états
+ *   et événements encore en transit de l'ancienne partie sont ignorés.
  *
  * @note Le meilleur score n’est pas remis à zéro (il est conservé entre les parties).
  */
 void Game::resetGame() {
-    board = Board(board.getWidth(), board.getHeight());
-
-    score = 0;
-    level = 1;
-    timer = 0;
-    delay = 0.5f;
-    clearing = false;
-    clearTimer = 0;
-    gameOver = false;
+    const GameSnapshot& snap = simulation.snapshot();
+    finishTelemetry(snap.score, snap.level); // partie abandonnée en cours de route
+
+    gameId++;
+    particles.clear();
+    puzzleResult = -1;
+
+    std::optional<puzzle::Puzzle> next;
+    puzzlePieces.clear();
+    if (puzzleMode) {
+        next = puzzlePack->load(puzzleIndex);
+        if (!next) {
+            std::cerr << "Puzzle " << puzzleIndex << " illisible : retour au jeu normal" << std::endl;
+            puzzleMode = false;
+        }
+    }
+    if (next) {
+        for (TetrominoType t : next->pieces) puzzlePieces.push_back(static_cast<PieceId>(t));
+    }
+    simulation.setPuzzle(std::move(next));
+    simulation.setPractice(practiceMode);
+    finesseFaults = 0;
+    finesseExtraKeys = 0;
+    sendCommand(Command::Reset);
     state = GameState::PLAYING;
-
-    current = std::make_unique<Tetromino>(TetrominoType(rand()%7), board.getWidth()/2);
-    next = std::make_unique<Tetromino>(TetrominoType(rand()%7), board.getWidth()/2);
 }
 
 
@@ -497,6 +960,7 @@ void Game::loadBestScore() {
  * @warning Si le fichier n’est pas accessible en écriture, la sauvegarde échoue silencieusement.
  */
 void Game::saveBestScore() {
+    int score = simulation.snapshot().score;
     if (score > bestScore) {
         bestScore = score;
         std::ofstream file("scores.txt");
@@ -521,14 +985,8 @@ void Game::drawMenu() {
 
     window.draw(title);
 
-    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+    // Les couleurs de survol sont tenues à jour par updateHover()
     for (auto& btn : menuButtons) {
-        if (btn.isMouseOver(mousePos)) {
-            btn.shape.setFillColor(sf::Color(150, 150, 150));
-        } else {
-            btn.shape.setFillColor(sf::Color(100, 100, 100));
-        }
-
         window.draw(btn.shape);
         window.draw(btn.text);
     }
@@ -543,7 +1001,9 @@ void Game::drawHelp() {
         "Fleche Gauche/Droite : Deplacer\n"
         "Fleche Haut : Rotation\n"
         "Fleche Bas : Descente rapide\n"
-        "Espace : Hard drop\n\n"
+        "Espace : Hard drop\n"
+        "Retour arriere : Annuler (entrainement)\n"
+        "H : Aide au perfect clear\n\n"
         "ESC : Retour au menu", font, 18);
     help.setFillColor(sf::Color::Yellow);
 
@@ -583,7 +1043,7 @@ void Game::drawPause() {
     window.draw(overlay);
 
     // === Titre "PAUSE" centré uniquement dans la grille ===
-    float gridWidth = board.getWidth() * tileSize;
+    float gridWidth = boardWidth * tileSize;
     sf::Text pauseTitle("=== PAUSE ===", font, 40);
     pauseTitle.setFillColor(sf::Color::Yellow);
     sf::FloatRect titleBounds = pauseTitle.getLocalBounds();
@@ -591,14 +1051,10 @@ void Game::drawPause() {
     pauseTitle.setPosition(gridWidth / 2.f, 100.f); // à ~100px du haut de la grille
     window.draw(pauseTitle);
 
-    // === Boutons ===
-    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+    // === Boutons (construits à la première pause) ===
+    if (pauseButtons.empty()) setupPauseButtons();
+
     for (auto &btn : pauseButtons) {
-        if (btn.isMouseOver(mousePos)) {
-            btn.shape.setFillColor(sf::Color(150, 150, 150));
-        } else {
-            btn.shape.setFillColor(sf::Color(100, 100, 100));
-        }
         window.draw(btn.shape);
         window.draw(btn.text);
     }
@@ -606,45 +1062,11 @@ void Game::drawPause() {
 
 
 /**
- * @brief Met à jour le score, le niveau et la vitesse du jeu après l'effacement de lignes.
- *
- * Cette fonction applique un système de points basé sur le nombre de lignes effacées en une seule fois,
- * met à jour le nombre total de lignes effacées et augmente progressivement le niveau et la vitesse du jeu.
- *
- * @param linesCleared Nombre de lignes effacées simultanément (valeur attendue entre 0 et 4).
- *
- * @details
- * - Barème des points attribués :
- *   - 0 ligne : 0 point
- *   - 1 ligne : 100 points
- *   - 2 lignes : 300 points
- *   - 3 lignes : 500 points
- *   - 4 lignes : 800 points (Tetris)
- * - Tous les 10 lignes effacées (`totalLinesCleared / 10 >= level`), le niveau augmente de 1.
- * - La vitesse de descente (`delay`) diminue progressivement (multipliée par 0.95 à chaque niveau),
- *   mais ne descend jamais en dessous de **0.1 seconde**.
- *
- * @note Cette fonction ne sauvegarde pas le score maximum, elle ne fait qu’actualiser l’état actuel de la partie.
- *
- * @warning Assurez-vous que `linesCleared` est compris entre 0 et 4 pour éviter tout accès hors limites dans `comboPoints`.
- */
-void Game::updateScore(int linesCleared) {
-    static const std::array<int,5> comboPoints = {0,100,300,500,800};
-    score += comboPoints[linesCleared];
-
-    totalLinesCleared += linesCleared;
-    if (totalLinesCleared / 10 >= level) {
-        level++;
-        delay = std::max(0.1f, delay * 0.95f); // accélération progressive
-    }
-}
-
-
-/**
- * @brief Configure les boutons du menu (Jouer, Aide, À propos, Quitter).
+ * @brief Configure les boutons du menu (Jouer, Entraînement, Aide, À propos, Quitter).
  */
 void Game::setupMenuButtons() {
-    std::vector<std::string> labels = {"Jouer", "Aide", "A propos", "Quitter"};
+    std::vector<std::string> labels = {"Jouer", "Entrainement", "Aide", "A propos", "Quitter"};
+    if (puzzlePack) labels.insert(labels.begin() + 2, "Puzzles");
 
     float width = 200.f;
     float height = 50.f;
@@ -663,7 +1085,7 @@ void Game::setupMenuButtons() {
         float posY = startY + i * spacing;
 
         btn.shape.setPosition(posX, posY);
-        btn.shape.setFillColor(sf::Color(100, 100, 100));
+        btn.shape.setFillColor(BUTTON_COLOR);
         btn.shape.setOutlineColor(sf::Color::White);
         btn.shape.setOutlineThickness(2);
 
@@ -680,7 +1102,26 @@ void Game::setupMenuButtons() {
 
         // Actions
         if (labels[i] == "Jouer") {
-            btn.onClick = [this]() { state = GameState::PLAYING; };
+            btn.onClick = [this]() {
+                if (puzzleMode || practiceMode) {
+                    puzzleMode = false;
+                    practiceMode = false;
+                    resetGame();
+                }
+                state = GameState::PLAYING;
+            };
+        } else if (labels[i] == "Entrainement") {
+            btn.onClick = [this]() {
+                puzzleMode = false;
+                practiceMode = true;
+                resetGame();
+            };
+        } else if (labels[i] == "Puzzles") {
+            btn.onClick = [this]() {
+                puzzleMode = true;
+                practiceMode = false;
+                resetGame();
+            };
         } else if (labels[i] == "Aide") {
             btn.onClick = [this]() { state = GameState::HELP; };
         } else if (labels[i] == "A propos") {
@@ -703,8 +1144,8 @@ void Game::setupPauseButtons() {
     float height = 50.f;
     float spacing = 70.f;
 
-    float gridWidth = board.getWidth() * tileSize;
-    float gridHeight = board.getHeight() * tileSize;
+    float gridWidth = boardWidth * tileSize;
+    float gridHeight = boardHeight * tileSize;
 
     float totalHeight = labels.size() * height + (labels.size() - 1) * (spacing - height);
     float startY = (gridHeight - totalHeight) / 2.f;
@@ -719,7 +1160,7 @@ void Game::setupPauseButtons() {
         float posY = startY + i * spacing;
 
         btn.shape.setPosition(posX, posY);
-        btn.shape.setFillColor(sf::Color(100, 100, 100));
+        btn.shape.setFillColor(BUTTON_COLOR);
         btn.shape.setOutlineColor(sf::Color::White);
         btn.shape.setOutlineThickness(2);
 
@@ -752,17 +1193,210 @@ void Game::setupPauseButtons() {
 }
 
 /**
- * @brief Boucle principale du jeu.
+ * @brief Boucle principale du thread d'affichage.
  *
- * Gère les événements, met à jour la logique et dessine à chaque frame.
+ * Démarre le thread de simulation, puis à chaque tour : transmet les événements,
+ * récupère le dernier état publié et le dessine. Sur les écrans inactifs
+ * (menu, aide, à propos, pause), attend les événements et ne redessine que si
+ * nécessaire ; la simulation y est en pause.
  */
 void Game::run() {
+    simulation.start();
+
     sf::Clock clock;
     while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
-        processEvents();
-        update(dt);
-        if (state == GameState::PLAYING) delay = 0.5f;
-        render();
+        if (profiling) profiler.tick(state);
+
+        bool rendered = false;
+        if (isIdleScreen()) {
+            rendered = runIdleScreen();
+            syncSimulation();
+            clock.restart(); // le temps passé hors jeu n'est pas compté dans la télémétrie
+        } else {
+            float dt = clock.restart().asSeconds();
+            perfLog.start();
+            processEvents();
+            syncSimulation();
+            perfLog.lap("events");
+            update(dt);
+            perfLog.lap("update");
+            render();
+            perfLog.lap("render");
+            perfLog.nextFrame();
+            rendered = true;
+
+            // Budget : effets retirés ou rendus pour les images suivantes. Le temps
+            // est lu avant display(), qui attend la synchronisation verticale
+            if (governor.frame(clock.getElapsedTime().asSeconds() * 1000.0, dt) && profiling) {
+                std::clog << "[budget] " << toString(governor.level()) << " (moyenne "
+                          << governor.averageMs() << " ms)" << std::endl;
+            }
+            window.display();
+        }
+
+        if (rendered) {
+            if (profiling) profiler.frameRendered();
+            if (!firstFrameShown) {
+                firstFrameShown = true;
+                trace.mark("premiere image");
+                trace.report(std::clog);
+            }
+        }
+    }
+
+    simulation.stop();
+
+    // Fenêtre fermée en pleine partie
+    const GameSnapshot& snap = simulation.snapshot();
+    finishTelemetry(snap.score, snap.level);
+
+    if (profiling) {
+        profiler.tick(state);
+        profiler.report(std::clog);
+        governor.report(std::clog);
+        simulation.refresh();
+        simulation.snapshot().timings.report(std::clog);
+        simulation.snapshot().reportDeadTime(std::clog);
+    }
+    perfLog.report(std::clog);
+}
+
+/**
+ * @brief Joue un script de banc d'essai : événements injectés, images mesurées.
+ *
+ * Les événements passent par `handleEvent()` et les images par `update()` puis
+ * `render()`, comme en jeu. La télémétrie est désactivée et la synchronisation
+ * verticale coupée pour mesurer le rendu lui-même.
+ */
+bool Game::runBenchmark(const bench::Script& script, bench::Recorder& recorder) {
+    telemetryPath.clear();
+    governor.setBudget(0.0); // mesures comparables : tous les effets, toujours
+    window.setVerticalSyncEnabled(false);
+    window.setFramerateLimit(0);
+    simulation.reseed(script.seed);
+    simulation.refresh();
+
+    Autoplayer bot(boardWidth, boardHeight);
+    for (const auto& step : script.steps) {
+        switch (step.kind) {
+            case bench::Step::Kind::Key:
+                benchKey(step.key, true);
+                benchKey(step.key, false);
+                break;
+            case bench::Step::Kind::Click:
+                if (!benchClick(step.label)) {
+                    std::cerr << "[bench] bouton introuvable : " << step.label << std::endl;
+                }
+                break;
+            case bench::Step::Kind::Wait:
+                for (int i = 0; i < step.frames && window.isOpen(); i++) benchFrame(recorder);
+                break;
+            case bench::Step::Kind::AutoPlay:
+                for (int i = 0; i < step.frames && window.isOpen(); i++) {
+                    if (i % step.every == 0) benchAutoMove(bot);
+                    benchFrame(recorder);
+                }
+                break;
+        }
+        if (!window.isOpen()) return false;
+    }
+    perfLog.report(std::clog);
+    return true;
+}
+
+/**
+ * @brief Une image du banc d'essai : un pas de simulation puis une image mesurée.
+ *
+ * Le pas de simulation n'est pas chronométré (en jeu, il tourne sur son propre thread).
+ */
+void Game::benchFrame(bench::Recorder& recorder) {
+    // Seule la fermeture est prise en compte : le clavier ou la souris fausseraient le script
+    sf::Event e;
+    while (window.pollEvent(e)) {
+        if (e.type == sf::Event::Closed) window.close();
+    }
+
+    syncSimulation();
+    simulation.step();
+
+    auto start = std::chrono::steady_clock::now();
+    window.resetDrawCalls();
+    perfLog.start();
+    update(gravity::TICK_SECONDS);
+    perfLog.lap("update");
+
+    bench::Phase phase = bench::Phase::Menu;
+    if (state == GameState::GAME_OVER) phase = bench::Phase::GameOver;
+    else if (state == GameState::PLAYING) {
+        phase = simulation.snapshot().clearing ? bench::Phase::Clearing : bench::Phase::Playing;
+    }
+
+    render();
+    window.display(); // synchronisation verticale coupée : la présentation fait partie de la mesure
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    perfLog.lap("render");
+    perfLog.nextFrame();
+    recorder.add(phase, ms, window.getDrawCalls());
+}
+
+/**
+ * @brief Injecte un appui (ou un relâchement) de touche dans `handleEvent()`.
+ */
+void Game::benchKey(sf::Keyboard::Key key, bool pressed) {
+    sf::Event e{};
+    e.type = pressed ? sf::Event::KeyPressed : sf::Event::KeyReleased;
+    e.key.code = key;
+    handleEvent(e);
+}
+
+/**
+ * @brief Survole puis clique le bouton de l'écran courant portant ce libellé.
+ *
+ * @return false si aucun bouton ne porte ce libellé.
+ */
+bool Game::benchClick(const std::string& label) {
+    std::vector<Button>* buttons = activeButtons();
+    if (!buttons) return false;
+
+    for (const auto& btn : *buttons) {
+        if (btn.text.getString() != label) continue;
+
+        sf::FloatRect r = btn.shape.getGlobalBounds();
+        sf::Vector2i pixel = window.mapCoordsToPixel({r.left + r.width / 2.f, r.top + r.height / 2.f});
+
+        sf::Event e{};
+        e.type = sf::Event::MouseMoved;
+        e.mouseMove.x = pixel.x;
+        e.mouseMove.y = pixel.y;
+        handleEvent(e);
+
+        e.type = sf::Event::MouseButtonPressed;
+        e.mouseButton.button = sf::Mouse::Left;
+        e.mouseButton.x = pixel.x;
+        e.mouseButton.y = pixel.y;
+        handleEvent(e); // peut reconstruire les boutons : `btn` n'est plus utilisé
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Joueur automatique du banc d'essai : tape le chemin vers la meilleure pose.
+ *
+ * La pose vient d'`Autoplayer` (sans descente lente, car tout le chemin est tapé
+ * dans la même image) ; les touches répétées sont maintenues comme au clavier.
+ */
+void Game::benchAutoMove(Autoplayer& bot) {
+    const GameSnapshot& snap = simulation.snapshot();
+    if (state != GameState::PLAYING || snap.gameId != gameId || snap.waiting || snap.gameOver) return;
+
+    perfLog.start();
+    const std::vector<Key>& bestPath = bot.choose(snap.board, snap.current);
+    perfLog.lap("search");
+    for (std::size_t i = 0; i < bestPath.size(); i++) {
+        sf::Keyboard::Key key = toKeyboard(bestPath[i]);
+        benchKey(key, true);
+        bool held = bestPath[i] != Key::Rotate && i + 1 < bestPath.size() && bestPath[i + 1] == bestPath[i];
+        if (!held) benchKey(key, false);
     }
 }
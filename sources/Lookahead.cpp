@@ -0,0 +1,322 @@
+#include "../includes/Lookahead.hpp"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace bot {
+
+namespace {
+    // Poids de Autoplayer::rate
+    constexpr double LINE_WEIGHT = 0.76;
+    constexpr double HEIGHT_WEIGHT = -0.51;
+    constexpr double HOLE_WEIGHT = -0.36;
+    constexpr double BUMP_WEIGHT = -0.18;
+
+    /// Valeur d'une pièce qui n'a plus la place d'apparaître.
+    constexpr double DEAD = -1e9;
+
+    /// Espérances gardées par thread (16 octets chacune).
+    constexpr std::size_t CACHE_ENTRIES = 1u << 14;
+
+    using Clock = std::chrono::steady_clock;
+}
+
+/**
+ * @param width Largeur du plateau (32 colonnes au plus).
+ * @param height Hauteur du plateau (32 lignes au plus).
+ * @param pieces Pièces tirées au hasard dans la partie.
+ * @param c Réglages ; `threads` est fixé ici pour toute la vie de la recherche.
+ */
+Lookahead::Lookahead(int w, int h, const PieceSet& pieces, SearchConfig c)
+    : width(w), height(h), fullRow(w >= 32 ? ~0u : (1u << w) - 1), config(c), search(w, h),
+      threadCount(std::max(1u, c.threads ? c.threads : std::thread::hardware_concurrency())),
+      workers(threadCount), passStart(threadCount), passDone(threadCount)
+{
+    if (w > 32 || h > MAX_ROWS) throw std::invalid_argument("Lookahead : plateau limite a 32 x 32");
+    config.depth = std::max(0, config.depth);
+    config.beam = std::max(1, config.beam);
+
+    // Orientations distinctes de chaque pièce (le O n'en a qu'une, le I deux)
+    for (std::size_t i = 0; i < pieces.size(); i++) {
+        const PieceShape& shape = pieces[i];
+        std::vector<Orientation> list;
+        for (int r = 0; r < shape.rotations; r++) {
+            int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+            for (const auto& o : shape.offsets[r]) {
+                minX = std::min(minX, o.x);
+                minY = std::min(minY, o.y);
+                maxX = std::max(maxX, o.x);
+                maxY = std::max(maxY, o.y);
+            }
+            Orientation o;
+            o.span = maxY - minY + 1;
+            o.columns = maxX - minX + 1;
+            for (const auto& cell : shape.offsets[r]) o.masks[cell.y - minY] |= 1u << (cell.x - minX);
+
+            bool seen = std::any_of(list.begin(), list.end(), [&](const Orientation& other) {
+                return other.span == o.span && other.masks == o.masks;
+            });
+            if (!seen) list.push_back(o);
+        }
+        orientations.push_back(std::move(list));
+    }
+
+    for (auto& worker : workers) {
+        worker.cache.resize(CACHE_ENTRIES);
+        worker.levels.resize(config.depth + 1);
+        for (auto& level : worker.levels) level.reserve(4 * width);
+    }
+    for (unsigned t = 1; t < threadCount; t++) threads.emplace_back([this, t]() { workerLoop(workers[t]); });
+}
+
+Lookahead::~Lookahead() {
+    stopping = true;
+    passStart.arrive_and_wait();
+    for (auto& t : threads) t.join();
+}
+
+/**
+ * @brief Cherche la meilleure pose, profondeur après profondeur, dans le budget de temps.
+ *
+ * La profondeur 0 (pièce courante et suivante) est toujours terminée, même
+ * budget dépassé : il y a toujours un choix. `stats()` décrit ensuite la recherche.
+ *
+ * @param board Grille courante.
+ * @param current Pièce à poser, à sa position actuelle.
+ * @param next Pièce suivante (connue).
+ */
+template <class BoardT>
+const std::vector<Key>& Lookahead::choose(const BoardT& board, const Tetromino& current, const Tetromino& next) {
+    const auto start = Clock::now();
+    deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(config.budgetMs));
+    for (auto& w : workers) {
+        w.nodes = 0;
+        w.hits = 0;
+    }
+
+    Field base;
+    for (int y = 0; y < height; y++) base.rows[y] = board.getRowBits(y);
+
+    // Poses de départ : toutes celles de MoveSearch jouables d'un coup, les `beam` meilleures gardées
+    roots.clear();
+    search.setBoard(board);
+    for (const auto& p : search.placements(current)) {
+        auto keys = search.path(p);
+        if (std::find(keys.begin(), keys.end(), Key::SoftDrop) != keys.end()) continue;
+
+        Root& r = roots.emplace_back();
+        r.placement = p;
+        r.child.field = base;
+        for (const auto& b : p.blocks) {
+            if (b.y >= 0) r.child.field.rows[b.y] |= 1u << b.x;
+        }
+        r.child.lines = clearFull(r.child.field);
+        r.child.rating = LINE_WEIGHT * r.child.lines + rateShape(r.child.field);
+    }
+
+    best.clear();
+    last = {};
+    if (roots.empty()) return best;
+
+    std::sort(roots.begin(), roots.end(), [](const Root& a, const Root& b) { return a.child.rating > b.child.rating; });
+    if (roots.size() > static_cast<std::size_t>(config.beam)) roots.erase(roots.begin() + config.beam, roots.end());
+
+    nextPiece = next.getId();
+    std::size_t chosen = 0;
+    for (int depth = 0; depth <= config.depth; depth++) {
+        passDepth = depth;
+        timed = depth > 0 && config.budgetMs > 0.0;
+        stopped = false;
+        nextRoot = 0;
+
+        // Les barrières ordonnent les accès : les workers ne lisent `roots` qu'entre les deux
+        passStart.arrive_and_wait();
+        searchRoots(workers[0]);
+        passDone.arrive_and_wait();
+        if (stopped) break;
+
+        // Meilleure pose de cette passe, comparée à toutes (y compris la première)
+        std::size_t passBest = 0;
+        for (std::size_t i = 1; i < roots.size(); i++) {
+            if (roots[i].value > roots[passBest].value) passBest = i;
+        }
+        chosen = passBest;
+        last.depth = depth;
+        if (config.budgetMs > 0.0 && Clock::now() >= deadline) break;
+    }
+
+    for (const auto& w : workers) {
+        last.nodes += w.nodes;
+        last.cacheHits += w.hits;
+    }
+    last.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    best = search.path(roots[chosen].placement);
+    return best;
+}
+
+template const std::vector<Key>& Lookahead::choose(const Board&, const Tetromino&, const Tetromino&);
+template const std::vector<Key>& Lookahead::choose(const StandardBoard&, const Tetromino&, const Tetromino&);
+
+void Lookahead::workerLoop(Worker& w) {
+    while (true) {
+        passStart.arrive_and_wait();
+        if (stopping) return;
+        searchRoots(w);
+        passDone.arrive_and_wait();
+    }
+}
+
+/**
+ * @brief Prend les poses de départ une à une jusqu'à épuisement (partagé par tous les threads).
+ */
+void Lookahead::searchRoots(Worker& w) {
+    for (std::size_t i; (i = nextRoot.fetch_add(1, std::memory_order_relaxed)) < roots.size();) {
+        Root& r = roots[i];
+        double value = maxNode(w, r.child.field, nextPiece, passDepth, 0);
+        if (stopped.load(std::memory_order_relaxed)) return;
+        r.value = LINE_WEIGHT * r.child.lines + value;
+    }
+}
+
+/**
+ * @brief Meilleure valeur d'une pièce connue : ses `beam` meilleures poses, puis
+ * l'espérance sur les `unknown` pièces suivantes.
+ */
+double Lookahead::maxNode(Worker& w, const Field& field, PieceId piece, int unknown, int level) {
+    if (timeUp(w)) return 0.0;
+
+    auto& children = w.levels[level];
+    expand(w, field, piece, children);
+    if (children.empty()) return DEAD;
+
+    auto better = [](const Child& a, const Child& b) { return a.rating > b.rating; };
+    if (unknown == 0) return std::min_element(children.begin(), children.end(), better)->rating;
+
+    std::size_t keep = std::min(children.size(), static_cast<std::size_t>(config.beam));
+    std::partial_sort(children.begin(), children.begin() + keep, children.end(), better);
+
+    double bestValue = DEAD;
+    for (std::size_t i = 0; i < keep; i++) {
+        double value = LINE_WEIGHT * children[i].lines + chanceNode(w, children[i].field, unknown, level + 1);
+        if (stopped.load(std::memory_order_relaxed)) return 0.0;
+        bestValue = std::max(bestValue, value);
+    }
+    return bestValue;
+}
+
+/**
+ * @brief Espérance sur la pièce suivante inconnue (toutes équiprobables), mise en cache.
+ */
+double Lookahead::chanceNode(Worker& w, const Field& field, int unknown, int level) {
+    std::uint64_t key = static_cast<std::uint64_t>(unknown);
+    for (int y = 0; y < height; y++) {
+        key = (key ^ field.rows[y]) * 0x9E3779B97F4A7C15ull;
+        key ^= key >> 29;
+    }
+    key |= 1;   // 0 : case vide
+
+    CacheEntry& slot = w.cache[key & (CACHE_ENTRIES - 1)];
+    if (slot.key == key) {
+        w.hits++;
+        return slot.value;
+    }
+
+    double sum = 0.0;
+    for (std::size_t p = 0; p < orientations.size(); p++) {
+        sum += maxNode(w, field, static_cast<PieceId>(p), unknown - 1, level);
+        if (stopped.load(std::memory_order_relaxed)) return 0.0;
+    }
+    double value = sum / orientations.size();
+    slot = {key, value};
+    return value;
+}
+
+/**
+ * @brief Toutes les chutes droites de `piece` sur `field`, évaluées.
+ *
+ * Une orientation qui n'a pas la place en haut de la grille est ignorée.
+ */
+void Lookahead::expand(Worker& w, const Field& field, PieceId piece, std::vector<Child>& out) {
+    out.clear();
+    int surface = 0;
+    while (surface < height && field.rows[surface] == 0) surface++;
+
+    for (const auto& o : orientations[piece]) {
+        for (int left = 0; left + o.columns <= width; left++) {
+            auto collides = [&](int top) {
+                for (int i = 0; i < o.span; i++) {
+                    if (top + i >= height || (field.rows[top + i] & (o.masks[i] << left))) return true;
+                }
+                return false;
+            };
+            // Au-dessus de la surface, les lignes sont vides : la chute commence juste au-dessus
+            int top = std::max(0, surface - o.span);
+            if (collides(top)) continue;
+            while (!collides(top + 1)) top++;
+
+            Child& c = out.emplace_back();
+            c.field = field;
+            for (int i = 0; i < o.span; i++) c.field.rows[top + i] |= o.masks[i] << left;
+            c.lines = clearFull(c.field);
+            c.rating = LINE_WEIGHT * c.lines + rateShape(c.field);
+        }
+    }
+    w.nodes += out.size();
+}
+
+/**
+ * @brief Évaluation de `Autoplayer::rate` sans les lignes : hauteur cumulée, trous, irrégularité.
+ */
+double Lookahead::rateShape(const Field& field) const {
+    std::array<int, MAX_ROWS> heights{};
+    std::uint32_t seen = 0;
+    int aggregate = 0, holes = 0;
+    for (int y = 0; y < height; y++) {
+        std::uint32_t row = field.rows[y];
+        std::uint32_t tops = row & ~seen;
+        holes += std::popcount(seen & ~row);
+        aggregate += (height - y) * std::popcount(tops);
+        for (; tops; tops &= tops - 1) heights[std::countr_zero(tops)] = height - y;
+        seen |= row;
+    }
+
+    int bumpiness = 0;
+    for (int x = 1; x < width; x++) bumpiness += std::abs(heights[x] - heights[x - 1]);
+    return HEIGHT_WEIGHT * aggregate + HOLE_WEIGHT * holes + BUMP_WEIGHT * bumpiness;
+}
+
+/**
+ * @brief Retire les lignes pleines et tasse la grille.
+ *
+ * @return Nombre de lignes retirées.
+ */
+int Lookahead::clearFull(Field& field) const {
+    int write = height - 1, lines = 0;
+    for (int y = height - 1; y >= 0; y--) {
+        if (field.rows[y] == fullRow) {
+            lines++;
+            continue;
+        }
+        field.rows[write--] = field.rows[y];
+    }
+    for (; write >= 0; write--) field.rows[write] = 0;
+    return lines;
+}
+
+/**
+ * @brief Passe abandonnée ? L'horloge n'est lue que toutes les 64 expansions.
+ */
+bool Lookahead::timeUp(Worker& w) {
+    if (!timed) return false;
+    if (stopped.load(std::memory_order_relaxed)) return true;
+    if ((++w.checks & 63) == 0 && Clock::now() >= deadline) {
+        stopped = true;
+        return true;
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,70 @@
+#include "../includes/MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Projette le fichier en mémoire en lecture seule.
+ *
+ * @param path Chemin du fichier. En cas d'échec, `isOpen()` retourne false.
+ * @param access Ordre de lecture prévu (lecture anticipée ou non).
+ */
+MappedFile::MappedFile(const std::string& path, Access access) {
+#ifdef _WIN32
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS,
+                                nullptr);
+    if (file == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER fileSize{};
+    if (::GetFileSizeEx(file, &fileSize)) {
+        length = static_cast<std::size_t>(fileSize.QuadPart);
+        if (length == 0) {
+            opened = true;
+        } else {
+            mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                bytes = static_cast<const unsigned char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                opened = bytes != nullptr;
+            }
+        }
+    }
+    ::CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0) {
+        length = static_cast<std::size_t>(st.st_size);
+        if (length == 0) {
+            opened = true;
+        } else {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                ::madvise(p, length, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+                bytes = static_cast<const unsigned char*>(p);
+                opened = true;
+            }
+        }
+    }
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (bytes) ::UnmapViewOfFile(bytes);
+    if (mapping) ::CloseHandle(mapping);
+#else
+    if (bytes) ::munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+}
@@ -0,0 +1,256 @@
+#include "../includes/MoveSearch.hpp"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace {
+    constexpr std::uint8_t UNREACHED = 0xFF;
+
+    enum Held { NONE = 0, LEFT = 1, RIGHT = 2, DOWN = 3 };
+
+    bool cellLess(const sf::Vector2i& a, const sf::Vector2i& b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    }
+}
+
+/**
+ * @brief Prépare une recherche pour un plateau de taille donnée.
+ *
+ * @throws std::invalid_argument Si le plateau est plus large que 64 colonnes.
+ */
+MoveSearch::MoveSearch(int w, int h) : width(w), height(h), rows(h, 0) {
+    if (w > 64) throw std::invalid_argument("MoveSearch : plateau limite a 64 colonnes");
+    setPad(MIN_PAD);
+}
+
+/**
+ * @brief Change la marge autour du plateau ; les graphes en cache sont invalidés.
+ */
+void MoveSearch::setPad(int p) {
+    pad = p;
+    stateCount = (width + 2*pad) * (height + 2*pad) * 4 * HELD_KINDS;
+    for (auto& g : graphs) g.valid = false;
+}
+
+/**
+ * @brief Copie la grille sous forme de lignes de bits.
+ *
+ * Les 32 premières colonnes viennent de `getRowBits` (sans lecture des cases
+ * pour une grille de taille fixe) ; au-delà, les cases sont lues une à une.
+ * Les graphes en cache restent valables si aucune case n'a changé.
+ */
+template <class BoardT>
+void MoveSearch::setBoard(const BoardT& board) {
+    bool changed = false;
+    for (int y = 0; y < height; y++) {
+        std::uint64_t bits = board.getRowBits(y);
+        for (int x = 32; x < width; x++) {
+            if (board.getCell(x, y) != sf::Color::Black) bits |= 1ull << x;
+        }
+        if (bits != rows[y]) {
+            rows[y] = bits;
+            changed = true;
+        }
+    }
+    if (changed) {
+        for (auto& g : graphs) g.valid = false;
+    }
+}
+
+template void MoveSearch::setBoard(const Board&);
+template void MoveSearch::setBoard(const StandardBoard&);
+
+std::uint32_t MoveSearch::index(int px, int py, int r, int held) const {
+    int cell = (py + pad) * (width + 2*pad) + (px + pad);
+    return static_cast<std::uint32_t>((cell * 4 + r) * HELD_KINDS + held);
+}
+
+void MoveSearch::decode(std::uint32_t s, int& px, int& py, int& r, int& held) const {
+    held = s % HELD_KINDS;
+    s /= HELD_KINDS;
+    r = s % 4;
+    s /= 4;
+    px = static_cast<int>(s % (width + 2*pad)) - pad;
+    py = static_cast<int>(s / (width + 2*pad)) - pad;
+}
+
+/**
+ * @brief Même règle que `Board::checkCollision`, sur les lignes de bits.
+ */
+bool MoveSearch::collides(const Graph& g, int px, int py, int r) const {
+    if (py < -pad) return true; // hors de l'espace d'états (jamais atteint en jeu)
+    for (const auto& o : g.shapes[r]) {
+        int x = px + o.x;
+        int y = py + o.y;
+        if (x < 0 || x >= width || y >= height) return true;
+        if (y >= 0 && (rows[y] >> x) & 1) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Parcours 0-1 de tous les états atteignables, puis regroupement des poses.
+ */
+void MoveSearch::build(Graph& g, const Tetromino& start) {
+    searches++;
+    g.valid = true;
+    g.shape = &start.getShape();
+    g.start = start.getBlocks();
+    g.placements.clear();
+
+    // Orientations lues dans les tables de la forme, à partir de celle de la pièce de départ
+    const sf::Vector2i pivot = g.start[g.shape->pivot];
+    for (int r = 0; r < 4; r++) g.shapes[r] = g.shape->offsets[(start.getRotation() + r) % 4];
+    g.rotations = g.shape->rotations;
+
+    // Table des positions bloquées, calculée une fois : le parcours ne fait plus que des lectures
+    const int positions = stateCount / HELD_KINDS;
+    blocked.resize(positions);
+    for (int pos = 0; pos < positions; pos++) {
+        int px, py, r, held;
+        decode(pos * HELD_KINDS, px, py, r, held);
+        blocked[pos] = collides(g, px, py, r);
+    }
+    auto isBlocked = [&](int px, int py, int r) { return blocked[index(px, py, r, NONE) / HELD_KINDS] != 0; };
+
+    g.dist.assign(stateCount, UNREACHED);
+    g.parent.resize(stateCount);
+    g.via.resize(stateCount);
+    if (collides(g, pivot.x, pivot.y, 0)) return;
+
+    std::uint32_t root = index(pivot.x, pivot.y, 0, NONE);
+    g.dist[root] = 0;
+    g.parent[root] = -1;
+
+    frontier.clear();
+    nextFrontier.clear();
+    frontier.push_back(root);
+
+    // Les appuis coûtent 1 (file suivante), les touches maintenues 0 (même file)
+    for (int d = 0; !frontier.empty() && d < UNREACHED - 1; d++) {
+        for (std::size_t i = 0; i < frontier.size(); i++) {
+            std::uint32_t s = frontier[i];
+            if (g.dist[s] != d) continue; // amélioré depuis
+
+            int px, py, r, held;
+            decode(s, px, py, r, held);
+
+            auto relax = [&](int nx, int ny, int nr, int nheld, Key key) {
+                if (isBlocked(nx, ny, nr)) return;
+                int cost = (key != Key::Rotate && nheld == held) ? 0 : 1;
+                std::uint32_t t = index(nx, ny, nr, nheld);
+                if (d + cost >= g.dist[t]) return;
+                g.dist[t] = static_cast<std::uint8_t>(d + cost);
+                g.parent[t] = static_cast<std::int32_t>(s);
+                g.via[t] = key;
+                (cost == 0 ? frontier : nextFrontier).push_back(t);
+            };
+
+            relax(px - 1, py, r, LEFT, Key::Left);
+            relax(px + 1, py, r, RIGHT, Key::Right);
+            relax(px, py + 1, r, DOWN, Key::SoftDrop);
+            if (g.rotations > 1) relax(px, py, (r + 1) % 4, NONE, Key::Rotate); // relâche la touche maintenue
+        }
+        frontier.swap(nextFrontier);
+        nextFrontier.clear();
+    }
+
+    // Chute instantanée depuis chaque position atteinte : meilleur coût par pose
+    bestAt.assign(positions, INT_MAX);
+    bestFrom.resize(positions);
+
+    for (int pos = 0; pos < positions; pos++) {
+        int best = INT_MAX;
+        std::uint32_t from = 0;
+        for (int held = 0; held < HELD_KINDS; held++) {
+            std::uint32_t s = pos * HELD_KINDS + held;
+            if (g.dist[s] < best) { best = g.dist[s]; from = s; }
+        }
+        if (best == UNREACHED) continue;
+
+        int px, py, r, held;
+        decode(from, px, py, r, held);
+        while (!isBlocked(px, py + 1, r)) py++;
+
+        int landed = index(px, py, r, NONE) / HELD_KINDS;
+        if (best + 1 < bestAt[landed]) {
+            bestAt[landed] = best + 1;
+            bestFrom[landed] = from;
+        }
+    }
+
+    for (int pos = 0; pos < positions; pos++) {
+        if (bestAt[pos] == INT_MAX) continue;
+        int px, py, r, held;
+        decode(pos * HELD_KINDS, px, py, r, held);
+
+        Placement p;
+        p.blocks = g.shapes[r];
+        for (auto& b : p.blocks) b += sf::Vector2i(px, py);
+        std::sort(p.blocks.begin(), p.blocks.end(), cellLess);
+        p.rotation = r;
+        p.keys = bestAt[pos];
+        p.piece = start.getId();
+        p.from = bestFrom[pos];
+        g.placements.push_back(p);
+    }
+
+    // Plusieurs rotations peuvent occuper les mêmes cases (I, S, Z) : garder la moins chère
+    auto sameCells = [](const Placement& a, const Placement& b) { return a.blocks == b.blocks; };
+    std::sort(g.placements.begin(), g.placements.end(), [](const Placement& a, const Placement& b) {
+        if (a.blocks != b.blocks) {
+            return std::lexicographical_compare(a.blocks.begin(), a.blocks.end(),
+                                                b.blocks.begin(), b.blocks.end(), cellLess);
+        }
+        return a.keys < b.keys;
+    });
+    g.placements.erase(std::unique(g.placements.begin(), g.placements.end(), sameCells), g.placements.end());
+}
+
+/**
+ * @brief Poses atteignables de la pièce `start`, calculées une fois par grille.
+ *
+ * @param start Pièce de départ (type, position et orientation).
+ * @return Liste valable jusqu'au prochain changement de grille.
+ */
+const std::vector<Placement>& MoveSearch::placements(const Tetromino& start) {
+    const PieceShape& shape = start.getShape();
+    if (shape.reach > pad) setPad(shape.reach);
+    if (shape.id >= graphs.size()) graphs.resize(shape.id + 1);
+
+    Graph& g = graphs[shape.id];
+    if (g.valid && g.shape == &shape && g.start == start.getBlocks()) {
+        cacheHits++;
+    } else {
+        build(g, start);
+    }
+    return g.placements;
+}
+
+/**
+ * @brief Nombre minimal d'appuis pour poser `start` sur les cases `blocks`.
+ *
+ * @return int -1 si cette pose n'est pas atteignable.
+ */
+int MoveSearch::keysFor(const Tetromino& start, const Cells& blocks) {
+    auto cells = blocks;
+    std::sort(cells.begin(), cells.end(), cellLess);
+    for (const auto& p : placements(start)) {
+        if (p.blocks == cells) return p.keys;
+    }
+    return -1;
+}
+
+/**
+ * @brief Reconstruit la suite de touches menant à une pose, chute comprise.
+ */
+std::vector<Key> MoveSearch::path(const Placement& p) const {
+    const Graph& g = graphs[p.piece];
+    std::vector<Key> keys;
+    for (std::int32_t s = static_cast<std::int32_t>(p.from); g.parent[s] != -1; s = g.parent[s]) {
+        keys.push_back(g.via[s]);
+    }
+    std::reverse(keys.begin(), keys.end());
+    keys.push_back(Key::HardDrop);
+    return keys;
+}
@@ -0,0 +1,178 @@
+#include "../includes/ParticleSystem.hpp"
+#include <array>
+
+namespace {
+    constexpr float GRAVITY = 900.f;        ///< Pixels / s²
+
+    const std::array<sf::Color, 3> CLEAR_COLORS {{
+        sf::Color::Red, sf::Color::Yellow, sf::Color::White
+    }};
+
+    const std::array<sf::Color, 3> LEVEL_COLORS {{
+        sf::Color::Cyan, sf::Color::Magenta, sf::Color(255,215,0)
+    }};
+}
+
+/**
+ * @brief Réserve toute la mémoire du système (particules et sommets).
+ *
+ * @param capacity Nombre maximal de particules vivantes ; au-delà, les
+ * nouvelles particules sont ignorées.
+ */
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : capacity(capacity),
+      x(capacity), y(capacity), vx(capacity), vy(capacity),
+      life(capacity), invLifetime(capacity), halfSize(capacity), color(capacity),
+      vertices(sf::Quads, capacity * 4)
+{
+    vertices.resize(0); // garde la capacité réservée
+}
+
+/**
+ * @brief Générateur xorshift32 : suffisant pour des effets, sans état partagé.
+ */
+float ParticleSystem::random() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState >> 8) * (1.f / 16777216.f);
+}
+
+void ParticleSystem::spawn(float px, float py, float pvx, float pvy, float lifetime, float size, sf::Color c) {
+    if (count == capacity) return;
+    std::size_t i = count++;
+    x[i] = px;
+    y[i] = py;
+    vx[i] = pvx;
+    vy[i] = pvy;
+    life[i] = lifetime;
+    invLifetime[i] = 1.f / lifetime;
+    halfSize[i] = size * 0.5f;
+    color[i] = c;
+}
+
+/**
+ * @brief Intègre toutes les particules puis retire celles qui sont éteintes.
+ *
+ * La première boucle est sans branche sur des tableaux contigus (vectorisable) ;
+ * le retrait remplace chaque particule morte par la dernière (pas de décalage).
+ *
+ * @param dt Temps écoulé depuis la dernière image (s).
+ */
+void ParticleSystem::update(float dt) {
+    const std::size_t n = count;
+    float* px = x.data();
+    float* py = y.data();
+    float* pvx = vx.data();
+    float* pvy = vy.data();
+    float* plife = life.data();
+    const float g = GRAVITY * dt;
+
+    for (std::size_t i = 0; i < n; i++) {
+        pvy[i] += g;
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+        plife[i] -= dt;
+    }
+
+    std::size_t i = 0;
+    while (i < count) {
+        if (life[i] > 0.f) { i++; continue; }
+        std::size_t last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        life[i] = life[last];
+        invLifetime[i] = invLifetime[last];
+        halfSize[i] = halfSize[last];
+        color[i] = color[last];
+    }
+}
+
+/**
+ * @brief Construit un quadrilatère par particule et les dessine en un seul appel.
+ *
+ * L'opacité décroît avec le temps de vie restant.
+ */
+void ParticleSystem::draw(GameWindow& target) {
+    if (count == 0) return;
+
+    vertices.resize(count * 4);
+    sf::Vertex* v = &vertices[0];
+
+    for (std::size_t i = 0; i < count; i++, v += 4) {
+        float s = halfSize[i];
+        sf::Color c = color[i];
+        c.a = static_cast<sf::Uint8>(255.f * life[i] * invLifetime[i]);
+
+        v[0].position = sf::Vector2f(x[i] - s, y[i] - s);
+        v[1].position = sf::Vector2f(x[i] + s, y[i] - s);
+        v[2].position = sf::Vector2f(x[i] + s, y[i] + s);
+        v[3].position = sf::Vector2f(x[i] - s, y[i] + s);
+        v[0].color = v[1].color = v[2].color = v[3].color = c;
+    }
+
+    target.draw(vertices);
+}
+
+/**
+ * @brief Éclats projetés depuis chaque case des lignes effacées.
+ */
+void ParticleSystem::emitLineClear(std::uint32_t rowMask, int boardWidth, int tileSize) {
+    constexpr int PER_CELL = 24;
+
+    for (int row = 0; row < 32; row++) {
+        if (!(rowMask & (1u << row))) continue;
+        for (int col = 0; col < boardWidth; col++) {
+            for (int k = 0; k < PER_CELL; k++) {
+                float px = (col + random()) * tileSize;
+                float py = (row + random()) * tileSize;
+                float pvx = (random() - 0.5f) * 600.f;
+                float pvy = -random() * 450.f;
+                spawn(px, py, pvx, pvy, 0.6f + random() * 0.6f, 2.f + random() * 3.f,
+                      CLEAR_COLORS[k % CLEAR_COLORS.size()]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Poussière à l'impact d'une chute instantanée et traînée au-dessus.
+ *
+ * @param minX, maxX Colonnes occupées par la pièce.
+ * @param bottomY Ligne du bloc le plus bas après la chute.
+ * @param distance Nombre de lignes parcourues.
+ */
+void ParticleSystem::emitHardDrop(int minX, int maxX, int bottomY, int distance, int tileSize) {
+    const sf::Color dust(200, 200, 200);
+
+    for (int col = minX; col <= maxX; col++) {
+        for (int k = 0; k < 12; k++) {
+            float px = (col + random()) * tileSize;
+            float py = (bottomY + 1) * tileSize;
+            spawn(px, py, (random() - 0.5f) * 300.f, -random() * 200.f,
+                  0.3f + random() * 0.3f, 2.f + random() * 2.f, dust);
+        }
+        for (int k = 0; k < distance * 2; k++) {
+            float px = (col + random()) * tileSize;
+            float py = (bottomY - random() * distance) * tileSize;
+            spawn(px, py, 0.f, -GRAVITY * 0.3f, 0.25f, 1.5f, dust);
+        }
+    }
+}
+
+/**
+ * @brief Gerbe de particules colorées depuis le bas du plateau.
+ */
+void ParticleSystem::emitLevelUp(int boardWidth, int boardHeight, int tileSize) {
+    constexpr int COUNT = 2000;
+    const float baseY = static_cast<float>(boardHeight * tileSize);
+
+    for (int k = 0; k < COUNT; k++) {
+        float px = random() * boardWidth * tileSize;
+        spawn(px, baseY, (random() - 0.5f) * 250.f, -500.f - random() * 500.f,
+              1.f + random() * 0.8f, 2.f + random() * 3.f,
+              LEVEL_COLORS[k % LEVEL_COLORS.size()]);
+    }
+}
@@ -0,0 +1,224 @@
+#include "../includes/PerfCounters.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace perf {
+
+    namespace {
+        constexpr std::array<const char*, EVENT_COUNT> COLUMNS = {
+            "cycles", "instructions", "cache_misses", "branch_misses"
+        };
+
+        std::uint64_t nowNs() {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+#if defined(__linux__)
+        constexpr std::array<std::uint64_t, EVENT_COUNT> HARDWARE_EVENTS = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES,
+        };
+
+        /// Ouvre un compteur du thread appelant, sur n'importe quel cœur ; -1 si refusé.
+        int openEvent(std::uint64_t config, int group) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config;
+            attr.disabled = group < 0 ? 1 : 0;     // le groupe démarre d'un bloc, par son meneur
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+    }
+
+    Reading& Reading::operator+=(const Reading& other) {
+        for (std::size_t i = 0; i < EVENT_COUNT; i++) values[i] += other.values[i];
+        ns += other.ns;
+        return *this;
+    }
+
+    Reading operator-(const Reading& a, const Reading& b) {
+        Reading r;
+        for (std::size_t i = 0; i < EVENT_COUNT; i++) {
+            r.values[i] = a.values[i] >= b.values[i] ? a.values[i] - b.values[i] : 0;
+        }
+        r.ns = a.ns - b.ns;
+        return r;
+    }
+
+    /**
+     * @brief Ouvre le groupe de compteurs du thread appelant et le démarre.
+     *
+     * Le premier compteur accepté mène le groupe ; les refus suivants sont ignorés.
+     */
+    Counters::Counters() {
+        fds.fill(-1);
+#if defined(__linux__)
+        for (std::size_t i = 0; i < EVENT_COUNT; i++) {
+            fds[i] = openEvent(HARDWARE_EVENTS[i], leader);
+            if (fds[i] < 0) {
+                if (failure.empty()) failure = std::strerror(errno);
+                continue;
+            }
+            if (leader < 0) leader = fds[i];
+            opened++;
+        }
+        if (leader >= 0) {
+            failure.clear();
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#else
+        failure = "perf_event_open n'existe que sous Linux";
+#endif
+    }
+
+    Counters::~Counters() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    /**
+     * @brief Lit tout le groupe d'un seul appel système.
+     *
+     * @return Valeurs cumulées depuis l'ouverture (zéro pour les compteurs absents).
+     */
+    Reading Counters::read() const {
+        Reading r;
+#if defined(__linux__)
+        if (leader >= 0) {
+            // nr, temps activé, temps programmé, puis une valeur par compteur du groupe
+            std::array<std::uint64_t, 3 + EVENT_COUNT> raw{};
+            if (::read(leader, raw.data(), sizeof(raw)) > 0 && raw[0] == static_cast<std::uint64_t>(opened)) {
+                const std::uint64_t enabled = raw[1], running = raw[2];
+                std::size_t slot = 3;
+                for (std::size_t i = 0; i < EVENT_COUNT; i++) {
+                    if (fds[i] < 0) continue;
+                    std::uint64_t v = raw[slot++];
+                    if (running > 0 && running < enabled) {
+                        v = static_cast<std::uint64_t>(static_cast<long double>(v) * enabled / running);
+                    }
+                    r.values[i] = v;
+                }
+            }
+        }
+#endif
+        r.ns = nowNs();
+        return r;
+    }
+
+    Counters& threadCounters() {
+        thread_local Counters counters;
+        return counters;
+    }
+
+    /**
+     * @brief Crée le fichier CSV et ouvre les compteurs du thread appelant.
+     *
+     * Sans compteurs matériels, le journal ne contient que le temps réel.
+     */
+    bool Log::open(const std::string& path) {
+        file.open(path, std::ios::trunc);
+        if (!file) return false;
+
+        const Counters& counters = threadCounters();
+        if (!counters.available()) {
+            std::cerr << "[perf] compteurs materiels indisponibles (" << counters.error()
+                      << ") : seul le temps reel sera mesure" << std::endl;
+        }
+        file << "image,phase";
+        for (std::size_t i = 0; i < EVENT_COUNT; i++) {
+            present[i] = counters.has(static_cast<Event>(i));
+            file << ',' << COLUMNS[i];
+        }
+        file << ",ns\n";
+
+        enabled = true;
+        mark = counters.read();
+        return true;
+    }
+
+    /**
+     * @brief Écrit la différence depuis `start()` (ou le `lap()` précédent).
+     *
+     * Le nouveau point de départ est lu après l'écriture : celle-ci n'est comptée nulle part.
+     */
+    void Log::lap(std::string_view phase) {
+        if (!enabled) return;
+        add(phase, threadCounters().read() - mark);
+        mark = threadCounters().read();
+    }
+
+    void Log::add(std::string_view phase, const Reading& delta) {
+        if (!enabled) return;
+
+        file << frame << ',' << phase;
+        for (std::size_t i = 0; i < EVENT_COUNT; i++) {
+            file << ',';
+            if (present[i]) file << delta.values[i];
+        }
+        file << ',' << delta.ns << '\n';
+
+        Total* total = nullptr;
+        for (auto& t : totals) {
+            if (t.phase == phase) total = &t;
+        }
+        if (!total) total = &totals.emplace_back(Total{std::string(phase), {}, 0});
+        total->sum += delta;
+        total->rows++;
+    }
+
+    void Log::report(std::ostream& stream) const {
+        if (!enabled) return;
+
+        // Mis en forme à part : le format de `stream` (fixed, précision) reste celui de l'appelant
+        std::ostringstream out;
+
+        // Un rapport sans le compteur nécessaire affiche un tiret
+        auto cell = [&](int w, bool known, double value) {
+            if (known) out << std::setw(w) << value;
+            else out << std::setw(w) << '-';
+        };
+        auto has = [&](Event e) { return present[static_cast<std::size_t>(e)]; };
+        const bool instr = has(Event::Instructions);
+
+        out << std::fixed << std::setprecision(2);
+        out << "[perf] phase       lignes    ms/ligne   Minstr/ligne      IPC  cache/kinstr  branch/kinstr\n";
+        for (const auto& t : totals) {
+            const Reading& s = t.sum;
+            const double rows = static_cast<double>(t.rows);
+            const double instructions = static_cast<double>(s[Event::Instructions]);
+            auto perKilo = [&](Event e) { return instructions > 0 ? 1000.0 * s[e] / instructions : 0.0; };
+
+            out << "[perf] " << std::left << std::setw(10) << t.phase << std::right
+                << std::setw(8) << t.rows
+                << std::setw(12) << s.ns / 1e6 / rows;
+            cell(15, instr, instructions / 1e6 / rows);
+            cell(9, instr && has(Event::Cycles), s[Event::Cycles] ? instructions / s[Event::Cycles] : 0.0);
+            cell(14, instr && has(Event::CacheMisses), perKilo(Event::CacheMisses));
+            cell(15, instr && has(Event::BranchMisses), perKilo(Event::BranchMisses));
+            out << '\n';
+        }
+        stream << out.str() << std::flush;
+    }
+}
@@ -0,0 +1,328 @@
+#include "../includes/PerfectClear.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+namespace bot {
+
+namespace {
+    /// Bit du pivot en colonne x : x + OFFSET (les pièces débordent d'au plus MAX_CELLS - 1 cases).
+    constexpr int OFFSET = 16;
+    /// Échecs mémorisés par thread avant de vider le cache.
+    constexpr std::size_t MEMO_LIMIT = 1u << 20;
+
+    using Clock = std::chrono::steady_clock;
+}
+
+struct PerfectClear::Worker {
+    struct Key {
+        Field rows;
+        std::uint8_t height;
+        std::uint8_t depth;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = 0x9E3779B97F4A7C15ull ^ (static_cast<std::uint64_t>(k.height) << 8 | k.depth);
+            for (int i = 0; i < k.height; i++) {
+                h = (h ^ k.rows[i]) * 0xFF51AFD7ED558CCDull;
+                h ^= h >> 29;
+            }
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    std::unordered_set<Key, KeyHash> failed;
+    std::vector<std::vector<Drop>> drops;   ///< Poses candidates, par profondeur
+    std::vector<Drop> path;                 ///< Poses de la branche en cours
+    std::vector<Drop> solution;
+    int root = 0;
+    bool found = false;
+    std::uint64_t nodes = 0;
+    std::uint64_t memoHits = 0;
+    std::uint64_t pruned = 0;
+    Clock::time_point deadline;
+    bool limited = false;
+};
+
+PerfectClear::PerfectClear(int w, int h, const PieceSet& set, ClearConfig c)
+    : width(w), boardHeight(h), pieces(set), config(c), fullRow((1u << w) - 1)
+{
+    if (w > MAX_WIDTH) throw std::invalid_argument("PerfectClear : plateau limite a 16 colonnes");
+    config.maxHeight = std::clamp(config.maxHeight, 1, std::min(MAX_HEIGHT, h));
+    config.maxPieces = std::max(0, config.maxPieces);
+}
+
+/**
+ * @brief Poses d'une pièce entièrement contenues dans les `height` lignes du bas.
+ *
+ * Positions calculées ligne de pivot par ligne de pivot, du ciel vers le sol :
+ * un masque de colonnes atteignables par rotation, complété par les déplacements
+ * latéraux et les rotations sur place, puis propagé à la ligne du dessous.
+ */
+void PerfectClear::placements(const Field& field, int height, PieceId id, std::vector<Drop>& out) const {
+    out.clear();
+    const PieceShape& shape = pieces[id];
+    const int rotations = shape.rotations > 1 ? 4 : 1;
+    const int reach = shape.reach;
+    const std::uint64_t walls = ~(static_cast<std::uint64_t>(fullRow) << OFFSET);
+    const std::uint64_t range = ((1ull << (width + 2 * reach)) - 1) << (OFFSET - reach);
+
+    // Cases pleines de la ligne i (sol sous la ligne 0, ciel vide au-dessus de la zone)
+    auto solid = [&](int i) -> std::uint64_t {
+        if (i < 0) return ~0ull;
+        return walls | (i < height ? static_cast<std::uint64_t>(field[i]) << OFFSET : 0);
+    };
+    // Colonnes de pivot où la rotation r est bloquée, pivot sur la ligne pi
+    auto blocked = [&](int r, int pi) {
+        std::uint64_t m = 0;
+        for (const auto& o : shape.offsets[r]) {
+            std::uint64_t row = solid(pi - o.y);
+            m |= o.x >= 0 ? row >> o.x : row << -o.x;
+        }
+        return m;
+    };
+
+    const int top = height + reach;         // Toutes les rotations dans le ciel
+    const int bottom = -reach;
+    std::array<std::uint64_t, 4> current{}, below{};
+    for (int r = 0; r < rotations; r++) current[r] = range & ~blocked(r, top);
+
+    for (int pi = top; pi >= bottom; pi--) {
+        std::array<std::uint64_t, 4> open{};
+        for (int r = 0; r < rotations; r++) {
+            open[r] = range & ~blocked(r, pi);
+            if (pi < top) current[r] = below[r] & open[r];
+        }
+
+        // Déplacements latéraux et rotations sur la ligne, jusqu'à stabilité
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (int r = 0; r < rotations; r++) {
+                std::uint64_t m = current[r];
+                for (std::uint64_t grown = m; ; m = grown) {
+                    grown = (m | m << 1 | m >> 1) & open[r];
+                    if (grown == m) break;
+                }
+                int n = (r + 1) % rotations;
+                std::uint64_t turned = m & open[n];
+                if (m != current[r] || (turned & ~current[n])) changed = true;
+                current[r] = m;
+                if (rotations > 1) current[n] |= turned;
+            }
+        }
+
+        // Positions posées : bloquées une ligne plus bas
+        for (int r = 0; r < rotations; r++) {
+            std::uint64_t resting = current[r] & blocked(r, pi - 1);
+            while (resting) {
+                int px = std::countr_zero(resting) - OFFSET;
+                resting &= resting - 1;
+
+                Drop d;
+                bool inside = true;
+                for (const auto& o : shape.offsets[r]) {
+                    int i = pi - o.y;
+                    if (i >= height) { inside = false; break; }
+                    d.cells[i] |= 1u << (px + o.x);
+                    d.top = std::max(d.top, i + 1);
+                }
+                if (!inside) continue;
+                // Plusieurs rotations peuvent occuper les mêmes cases (I, S, Z)
+                if (std::none_of(out.begin(), out.end(), [&](const Drop& e) { return e.cells == d.cells; })) {
+                    out.push_back(d);
+                }
+            }
+            below[r] = current[r];
+        }
+    }
+}
+
+/**
+ * @brief Coupure : chaque groupe de colonnes liées par des cases vides doit pouvoir
+ * être rempli par des pièces entières (pièces de même taille seulement).
+ */
+bool PerfectClear::viable(const Field& field, int height) const {
+    if (uniformCells == 0) return true;
+    std::uint32_t links = 0;
+    std::array<int, MAX_WIDTH> empty{};
+    for (int i = 0; i < height; i++) {
+        std::uint32_t holes = ~field[i] & fullRow;
+        links |= holes & (holes >> 1);
+        for (; holes; holes &= holes - 1) empty[std::countr_zero(holes)]++;
+    }
+    int group = 0;
+    for (int x = 0; x < width; x++) {
+        group += empty[x];
+        if (!(links >> x & 1u)) {
+            if (group % uniformCells != 0) return false;
+            group = 0;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Recherche en profondeur depuis la pièce `depth` de la suite.
+ */
+bool PerfectClear::search(Worker& w, const Field& field, int height, std::size_t depth) const {
+    if (height == 0) return true;
+    if (depth >= used) return false;
+    if (cancelled.load(std::memory_order_relaxed) || expired.load(std::memory_order_relaxed)) return false;
+    if (bestRoot.load(std::memory_order_relaxed) < w.root) return false;
+
+    Worker::Key key{field, static_cast<std::uint8_t>(height), static_cast<std::uint8_t>(depth)};
+    if (w.failed.contains(key)) {
+        w.memoHits++;
+        return false;
+    }
+    if (++w.nodes % 256 == 0 && w.limited && Clock::now() > w.deadline) {
+        expired = true;
+        return false;
+    }
+
+    auto& candidates = w.drops[depth];
+    placements(field, height, sequence[depth], candidates);
+    for (std::size_t c = 0; c < candidates.size(); c++) {
+        const Drop& d = w.drops[depth][c];
+        Field next{};
+        int rows = 0;
+        for (int i = 0; i < height; i++) {
+            std::uint32_t row = field[i] | d.cells[i];
+            if (row != fullRow) next[rows++] = row;
+        }
+        if (!viable(next, rows)) {
+            w.pruned++;
+            continue;
+        }
+        w.path[depth] = d;
+        if (search(w, next, rows, depth + 1)) return true;
+    }
+
+    if (!cancelled.load(std::memory_order_relaxed) && !expired.load(std::memory_order_relaxed) &&
+        bestRoot.load(std::memory_order_relaxed) >= w.root) {
+        if (w.failed.size() >= MEMO_LIMIT) w.failed.clear();
+        w.failed.insert(key);
+    }
+    return false;
+}
+
+template <class BoardT>
+ClearResult PerfectClear::solve(const BoardT& board, std::span<const PieceId> seq) {
+    auto start = Clock::now();
+    ClearResult result;
+    cancelled = false;
+    expired = false;
+
+    // Grille en lignes de bits, celle du bas en premier ; hauteur de la pile
+    std::vector<std::uint32_t> rows(boardHeight, 0);
+    int filled = 0, stack = 0;
+    for (int i = 0; i < boardHeight; i++) {
+        rows[i] = board.getRowBits(boardHeight - 1 - i);
+        filled += std::popcount(rows[i]);
+        if (rows[i]) stack = i + 1;
+    }
+
+    sequence = seq.first(std::min<std::size_t>(seq.size(), config.maxPieces));
+    uniformCells = sequence.empty() ? 0 : static_cast<int>(pieces[sequence[0]].cells.size());
+    for (PieceId id : sequence) {
+        if (static_cast<int>(pieces[id].cells.size()) != uniformCells) uniformCells = 0;
+    }
+
+    const unsigned threadCount = std::max(1u, config.threads ? config.threads : std::thread::hardware_concurrency());
+    std::vector<Worker> workers(threadCount);
+    for (auto& w : workers) {
+        w.drops.resize(sequence.size());
+        w.path.resize(sequence.size());
+        w.limited = config.budgetMs > 0.0;
+        w.deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(config.budgetMs));
+    }
+
+    // Chaque hauteur impose le nombre de pièces : leurs cases remplissent exactement la zone
+    for (int height = std::max(stack, 1); height <= config.maxHeight && !result.found; height++) {
+        int needed = height * width - filled;
+        int cells = 0;
+        used = 0;
+        while (used < sequence.size() && cells < needed) cells += static_cast<int>(pieces[sequence[used++]].cells.size());
+        if (cells < needed) break;      // Pas assez de pièces, ni pour les hauteurs suivantes
+        if (cells != needed) continue;
+
+        Field field{};
+        std::copy(rows.begin(), rows.begin() + height, field.begin());
+        if (!viable(field, height)) {
+            result.pruned++;
+            continue;
+        }
+
+        // Poses de la première pièce, réparties entre les threads
+        std::vector<Drop> roots;
+        placements(field, height, sequence[0], roots);
+        result.nodes++;
+        bestRoot = INT_MAX;
+        std::atomic<int> nextRoot{0};
+        auto run = [&](Worker& w) {
+            w.found = false;
+            for (int j; (j = nextRoot.fetch_add(1)) < static_cast<int>(roots.size());) {
+                if (j > bestRoot.load() || cancelled || expired) break;
+                w.root = j;
+                Field next{};
+                int left = 0;
+                for (int i = 0; i < height; i++) {
+                    std::uint32_t row = field[i] | roots[j].cells[i];
+                    if (row != fullRow) next[left++] = row;
+                }
+                if (!viable(next, left)) {
+                    w.pruned++;
+                    continue;
+                }
+                w.path[0] = roots[j];
+                if (search(w, next, left, 1)) {
+                    int best = bestRoot.load();
+                    while (j < best && !bestRoot.compare_exchange_weak(best, j)) {}
+                    w.found = true;
+                    w.solution.assign(w.path.begin(), w.path.begin() + used);
+                    break;
+                }
+            }
+        };
+        {
+            std::vector<std::jthread> threads;
+            for (unsigned t = 1; t < threadCount; t++) threads.emplace_back(run, std::ref(workers[t]));
+            run(workers[0]);
+        }
+
+        for (auto& w : workers) {
+            if (!w.found || w.root != bestRoot.load()) continue;
+            result.found = true;
+            result.height = height;
+            for (const Drop& d : w.solution) {
+                Cells blocks;
+                for (int i = 0; i < d.top; i++) {
+                    for (std::uint32_t bits = d.cells[i]; bits; bits &= bits - 1) {
+                        blocks.push_back({std::countr_zero(bits), boardHeight - 1 - i});
+                    }
+                }
+                result.placements.push_back(blocks);
+            }
+        }
+        for (auto& w : workers) w.failed.clear();  // Autre hauteur, autres pièces : le cache ne sert plus
+    }
+
+    for (const auto& w : workers) {
+        result.nodes += w.nodes;
+        result.memoHits += w.memoHits;
+        result.pruned += w.pruned;
+    }
+    result.timedOut = !result.found && (expired.load() || cancelled.load());
+    result.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+template ClearResult PerfectClear::solve(const Board&, std::span<const PieceId>);
+template ClearResult PerfectClear::solve(const StandardBoard&, std::span<const PieceId>);
+
+}
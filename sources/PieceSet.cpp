@@ -0,0 +1,149 @@
+#include "../includes/PieceSet.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Les 7 tétrominos (I, O, T, S, Z, J, L) dans le format des fichiers de pièces.
+     *
+     * Cases et pivots identiques aux formes historiques (grille 2x4, pivot = deuxième case).
+     */
+    constexpr std::string_view STANDARD_PIECES =
+        "I  0,255,255    1,0 *1,1 1,2 1,3\n"
+        "O  255,255,0    0,1 1,1 0,2 1,2\n"
+        "T  255,0,255    1,1 *1,2 0,2 0,3\n"
+        "S  0,255,0      1,1 *0,2 1,2 0,3\n"
+        "Z  255,0,0      0,1 *0,2 1,2 1,3\n"
+        "J  0,0,255      0,1 *1,1 1,2 1,3\n"
+        "L  255,165,0    1,1 *1,2 0,2 1,3\n";
+
+    /// Coordonnée maximale d'une case dans un fichier de pièces.
+    constexpr int MAX_COORD = 15;
+
+    bool parseColor(const std::string& text, sf::Color& out) {
+        int r, g, b;
+        char c1, c2;
+        std::istringstream in(text);
+        if (!(in >> r >> c1 >> g >> c2 >> b) || c1 != ',' || c2 != ',' || !in.eof()) return false;
+        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) return false;
+        out = sf::Color(r, g, b);
+        return true;
+    }
+
+    bool parseCell(const std::string& text, sf::Vector2i& out) {
+        char comma;
+        std::istringstream in(text);
+        if (!(in >> out.x >> comma >> out.y) || comma != ',' || !in.eof()) return false;
+        return out.x >= 0 && out.x <= MAX_COORD && out.y >= 0 && out.y <= MAX_COORD;
+    }
+
+    /// Précalcule les quatre orientations et la portée de la pièce.
+    void buildRotations(PieceShape& s) {
+        const sf::Vector2i pivot = s.cells[s.pivot];
+        s.offsets[0].clear();
+        for (const auto& c : s.cells) s.offsets[0].push_back(c - pivot);
+
+        // Même règle que l'ancien Tetromino::rotate : (dx, dy) -> (-dy, dx)
+        for (int r = 1; r < 4; r++) {
+            s.offsets[r].clear();
+            for (const auto& o : s.offsets[r - 1]) s.offsets[r].push_back(sf::Vector2i(-o.y, o.x));
+        }
+
+        s.reach = 0;
+        for (const auto& o : s.offsets[0]) s.reach = std::max({s.reach, std::abs(o.x), std::abs(o.y)});
+    }
+}
+
+/**
+ * @brief Jeu standard, construit une fois à partir de `STANDARD_PIECES`.
+ */
+const PieceSet& PieceSet::standard() {
+    static const PieceSet set = [] {
+        std::string error;
+        auto parsed = parse(STANDARD_PIECES, "standard", error);
+        if (!parsed) throw std::logic_error("Jeu de pieces standard invalide : " + error);
+        return *parsed;
+    }();
+    return set;
+}
+
+/**
+ * @brief Lit un fichier de pièces.
+ *
+ * @param path Chemin du fichier.
+ * @param error Reçoit la cause de l'échec.
+ */
+std::optional<PieceSet> PieceSet::load(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "impossible d'ouvrir " + path;
+        return std::nullopt;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    return parse(text.str(), path, error);
+}
+
+/**
+ * @brief Analyse un jeu de pièces et précalcule leurs rotations.
+ *
+ * Refuse les pièces vides, de plus de `MAX_CELLS` cases, aux cases en double
+ * ou à plusieurs pivots, et les jeux vides ou de plus de 255 pièces.
+ *
+ * @param text Contenu au format décrit dans PieceSet.hpp.
+ * @param source Nom utilisé dans les messages d'erreur.
+ * @param error Reçoit la cause de l'échec (source:ligne).
+ */
+std::optional<PieceSet> PieceSet::parse(std::string_view text, const std::string& source, std::string& error) {
+    PieceSet set;
+    std::istringstream in{std::string(text)};
+    std::string line;
+
+    for (int number = 1; std::getline(in, line); number++) {
+        auto fail = [&](const std::string& why) {
+            error = source + ":" + std::to_string(number) + " : " + why;
+            return std::nullopt;
+        };
+
+        std::istringstream words(line.substr(0, line.find('#')));
+        PieceShape shape;
+        std::string color;
+        if (!(words >> shape.name)) continue;
+        if (!(words >> color) || !parseColor(color, shape.color)) return fail("couleur R,G,B attendue");
+
+        int pivot = -1;
+        for (std::string cell; words >> cell;) {
+            bool isPivot = cell[0] == '*';
+            sf::Vector2i c;
+            if (!parseCell(isPivot ? cell.substr(1) : cell, c)) return fail("case invalide '" + cell + "'");
+            if (shape.cells.size() == MAX_CELLS) {
+                return fail("plus de " + std::to_string(MAX_CELLS) + " cases");
+            }
+            if (std::find(shape.cells.begin(), shape.cells.end(), c) != shape.cells.end()) {
+                return fail("case en double '" + cell + "'");
+            }
+            if (isPivot) {
+                if (pivot >= 0) return fail("plusieurs pivots");
+                pivot = static_cast<int>(shape.cells.size());
+            }
+            shape.cells.push_back(c);
+        }
+        if (shape.cells.empty()) return fail("piece sans case");
+        if (set.shapes.size() == 255) return fail("plus de 255 pieces");
+
+        shape.id = static_cast<PieceId>(set.shapes.size());
+        shape.pivot = std::max(pivot, 0);
+        shape.rotations = pivot >= 0 ? 4 : 1;
+        buildRotations(shape);
+        set.shapes.push_back(std::move(shape));
+    }
+
+    if (set.shapes.empty()) {
+        error = source + " : aucune piece";
+        return std::nullopt;
+    }
+    return set;
+}
@@ -0,0 +1,118 @@
+#include "../includes/PuzzlePack.hpp"
+#include <algorithm>
+
+namespace puzzle {
+
+namespace {
+    int rowBytes(int width) { return (width + 7) / 8; }
+}
+
+/**
+ * @brief Projette le paquet et vérifie son en-tête et les bornes de l'index.
+ *
+ * Les enregistrements ne sont vérifiés qu'à leur lecture (`load`).
+ *
+ * @param path Chemin du paquet. En cas d'échec, `isValid()` retourne false.
+ */
+Pack::Pack(const std::string& path) : file(path, MappedFile::Access::Random) {
+    if (!file.isOpen() || file.size() < sizeof(PackHeader)) return;
+
+    const PackHeader& h = header();
+    if (h.magic != PACK_MAGIC || h.version != FORMAT_VERSION) return;
+    if (h.width < 4 || h.width > MAX_WIDTH || h.height < 4) return;
+    if (h.indexOffset % 8 != 0 || h.indexOffset > file.size()) return;
+    if (h.count > (file.size() - h.indexOffset) / sizeof(IndexEntry)) return;
+
+    valid = true;
+}
+
+/**
+ * @brief Décode le puzzle `i` en une grille et une suite de pièces.
+ *
+ * Seules les pages de l'index et de l'enregistrement concernés sont lues.
+ */
+std::optional<Puzzle> Pack::load(std::uint32_t i) const {
+    if (!valid || i >= header().count) return std::nullopt;
+
+    const PackHeader& h = header();
+    const auto* index = reinterpret_cast<const IndexEntry*>(file.data() + h.indexOffset);
+    const IndexEntry& e = index[i];
+
+    const std::size_t rowsSize = static_cast<std::size_t>(h.height) * rowBytes(h.width);
+    if (e.pieceCount == 0 || e.offset > file.size() ||
+        rowsSize + e.pieceCount > file.size() - e.offset) {
+        return std::nullopt;
+    }
+
+    const unsigned char* p = file.data() + e.offset;
+    std::vector<std::uint32_t> rows(h.height, 0);
+    for (int y = 0; y < h.height; y++) {
+        for (int b = 0; b < rowBytes(h.width); b++) {
+            rows[y] |= static_cast<std::uint32_t>(*p++) << (8 * b);
+        }
+    }
+
+    std::vector<TetrominoType> pieces;
+    pieces.reserve(e.pieceCount);
+    for (int k = 0; k < e.pieceCount; k++, p++) {
+        if (*p > 6) return std::nullopt;
+        pieces.push_back(TetrominoType(*p));
+    }
+
+    return Puzzle{i, Board(h.width, h.height, rows, GARBAGE_COLOR), std::move(pieces),
+                  std::max<int>(1, e.goalLines)};
+}
+
+/**
+ * @brief Crée le fichier et réserve la place de l'en-tête.
+ */
+PackWriter::PackWriter(const std::string& path, int w, int h)
+    : out(path, std::ios::binary | std::ios::trunc), width(w), height(h), offset(sizeof(PackHeader))
+{
+    PackHeader placeholder{};
+    out.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+}
+
+/**
+ * @brief Ajoute un puzzle : grille en lignes de bits puis pièces.
+ */
+void PackWriter::add(const Board& board, const std::vector<TetrominoType>& pieces, int goalLines) {
+    record.assign(static_cast<std::size_t>(height) * rowBytes(width), 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (board.getCell(x, y) != sf::Color::Black) {
+                record[y * rowBytes(width) + x / 8] |= 1u << (x % 8);
+            }
+        }
+    }
+    for (auto t : pieces) record.push_back(static_cast<unsigned char>(t));
+
+    index.push_back({offset, static_cast<std::uint16_t>(pieces.size()),
+                     static_cast<std::uint16_t>(goalLines), 0});
+    out.write(reinterpret_cast<const char*>(record.data()), record.size());
+    offset += record.size();
+}
+
+/**
+ * @brief Écrit l'index (aligné sur 8 octets) puis l'en-tête définitif.
+ *
+ * @return false si une écriture a échoué.
+ */
+bool PackWriter::finish() {
+    static const char zeros[8] = {};
+    std::uint64_t padding = (8 - offset % 8) % 8;
+    out.write(zeros, padding);
+    offset += padding;
+
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexEntry));
+
+    PackHeader h{PACK_MAGIC, FORMAT_VERSION, static_cast<std::uint16_t>(width),
+                 static_cast<std::uint16_t>(height), 0,
+                 static_cast<std::uint32_t>(index.size()), offset};
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.flush();
+    return out.good();
+}
+
+}
@@ -0,0 +1,564 @@
+#include "../includes/Simulation.hpp"
+#include "../includes/Gravity.hpp"
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <span>
+
+/**
+ * @brief Affiche les mesures du thread de simulation.
+ *
+ * @param out Flux de sortie (ex. `std::clog`).
+ */
+void SimTimings::report(std::ostream& out) const {
+    double mean = steps ? static_cast<double>(busyUs) / steps : 0.0;
+    out << std::fixed << std::setprecision(1)
+        << "[simulation] ticks : " << steps
+        << "   calcul moyen : " << mean << " us"
+        << "   max : " << maxBusyUs << " us"
+        << "   retard max : " << maxLateUs << " us"
+        << "   ticks en retard : " << lateSteps << std::endl;
+}
+
+/**
+ * @brief Affiche le temps mort de la partie (ticks sans pièce en jeu).
+ *
+ * @param out Flux de sortie (ex. `std::clog`).
+ */
+template <class BoardT>
+void BasicSnapshot<BoardT>::reportDeadTime(std::ostream& out) const {
+    double perClear = clears ? static_cast<double>(clearDeadTicks) / clears : 0.0;
+    out << std::fixed << std::setprecision(1)
+        << "[simulation] temps mort : " << deadTicks << " ticks"
+        << "   apres effacement : " << perClear << " ticks/effacement (" << clears << " effacements)"
+        << std::endl;
+}
+
+/**
+ * @brief Construit un état vide aux dimensions du plateau.
+ */
+template <class BoardT>
+BasicSnapshot<BoardT>::BasicSnapshot(int width, int height)
+    : board(width, height),
+      current(TetrominoType::I, width/2),
+      ghost(TetrominoType::I, width/2),
+      next(TetrominoType::I, width/2)
+{
+    clearedRows.reserve(height);
+}
+
+/**
+ * @brief Constructeur de la simulation.
+ *
+ * La partie est prête mais en pause : elle démarre avec la commande `Resume`.
+ *
+ * @param width Largeur du plateau (en nombre de cases).
+ * @param height Hauteur du plateau (en nombre de cases).
+ * @param seed Graine du tirage des pièces.
+ */
+template <class BoardT>
+BasicSimulation<BoardT>::BasicSimulation(int width, int height, std::uint32_t seed)
+    : board(width, height), rng(seed),
+      current(randomPiece()), next(randomPiece()), spawned(current),
+      search(width, height)
+{
+    pendingEvents.reserve(16);
+    effectRows.reserve(height);
+}
+
+/**
+ * @brief Applique une commande du joueur ou du thread d'affichage.
+ *
+ * Les déplacements sont ignorés en attendant la pièce suivante, en pause
+ * ou après la fin de partie. L'annulation (mode entraînement) est permise
+ * en pause et après la fin de partie, mais pas avant l'apparition de la
+ * pièce suivante (la pose n'est pas encore journalisée).
+ *
+ * @param cmd La commande à appliquer.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::apply(const InputCommand& cmd) {
+    switch (cmd.type) {
+        case Command::Reset:  reset(cmd.gameId); return;
+        case Command::Pause:  running = false; return;
+        case Command::Resume: running = true; return;
+        case Command::SoftDropRelease: softDrop = false; return;
+        case Command::Undo:
+            // Aussi après la fin de partie : on revient avant la pose fatale
+            if (practice && !waiting) undo();
+            return;
+        default: break;
+    }
+
+    if (!isRunning() || waiting) return;
+
+    // Une touche maintenue compte pour un seul appui ; la chute finale est comptée à la pose
+    if (!cmd.repeat && cmd.type != Command::HardDrop) pieceKeys++;
+
+    switch (cmd.type) {
+        case Command::MoveLeft:
+            current.move(-1,0);
+            if (board.checkCollision(current)) current.move(1,0);
+            break;
+        case Command::MoveRight:
+            current.move(1,0);
+            if (board.checkCollision(current)) current.move(-1,0);
+            break;
+        case Command::Rotate: {
+            Tetromino backup = current;
+            current.rotate();
+            if (board.checkCollision(current)) current = backup;
+            break;
+        }
+        case Command::SoftDropPress:
+            softDrop = true;
+            break;
+        case Command::HardDrop: {
+            int distance = board.dropDistance(current);
+            current.move(0, distance);
+
+            int minX = board.getWidth(), maxX = 0, bottomY = 0;
+            for (auto& b : current.getBlocks()) {
+                minX = std::min(minX, b.x);
+                maxX = std::max(maxX, b.x);
+                bottomY = std::max(bottomY, b.y);
+            }
+            emit(GameEvent::Type::HardDropped, distance, minX | maxX << 8 | bottomY << 16);
+            lockPiece();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Joue une suite de touches d'un coup, comme si le joueur les tapait dans le même tick.
+ *
+ * Les touches identiques consécutives (hors rotation) comptent comme un appui
+ * maintenu pour la finesse, comme au clavier. Chaque `Key::SoftDrop` descend la
+ * pièce d'une ligne, comme un pas de descente de `MoveSearch` ; la descente
+ * rapide est relâchée à la fin de la suite.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::play(const std::vector<Key>& keys) {
+    bool pressed = false;
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        Command type = Command::HardDrop;
+        switch (keys[i]) {
+            case Key::Left:     type = Command::MoveLeft; break;
+            case Key::Right:    type = Command::MoveRight; break;
+            case Key::Rotate:   type = Command::Rotate; break;
+            case Key::SoftDrop: type = Command::SoftDropPress; break;
+            case Key::HardDrop: type = Command::HardDrop; break;
+        }
+        bool repeat = i > 0 && keys[i] != Key::Rotate && keys[i] == keys[i - 1];
+        apply({type, gameId, repeat});
+
+        // L'appui ne fait que l'armer : la ligne descendue est jouée ici, sans attendre la gravité
+        if (keys[i] == Key::SoftDrop && isRunning() && !waiting) {
+            pressed = true;
+            current.move(0, 1);
+            if (board.checkCollision(current)) current.move(0, -1);
+        }
+    }
+    if (pressed) apply({Command::SoftDropRelease, gameId});
+}
+
+/**
+ * @brief Un pas de simulation (1/60 s) : tâches arrivées à échéance, puis gravité.
+ *
+ * Un tick passé à attendre la pièce suivante est compté comme temps mort.
+ * Sans effet en pause ou après la fin de partie.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::tick() {
+    if (!isRunning()) return;
+    tickCount++;
+
+    if (waiting) {
+        deadTicks++;
+        if (waitAfterClear) clearDeadTicks++;
+        clock.advance();    // la pièce suivante apparaît peut-être, sans gravité ce tick-ci
+        return;
+    }
+
+    clock.advance();
+    applyGravity();
+}
+
+/**
+ * @brief Copie l'état visible de la partie dans `out`.
+ *
+ * Les tampons de `out` ont déjà la bonne taille : la copie n'alloue pas.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::writeSnapshot(BasicSnapshot<BoardT>& out) const {
+    out.gameId = gameId;
+    out.tick = tickCount;
+    out.board = board;
+    out.current = current;
+    out.ghost = computeGhost();
+    out.next = next;
+    out.score = score;
+    out.level = level;
+    out.lines = totalLinesCleared;
+    out.waiting = waiting;
+    out.clearing = !effectRows.empty();
+    out.clearPhase = out.clearing && delays.clearEffect > 0
+        ? std::min(1.f, static_cast<float>(tickCount - effectStart) / delays.clearEffect) : 0.f;
+    out.clearedRows = effectRows;
+    out.gameOver = gameOver;
+    out.running = running;
+    out.piecesLeft = piecesLeft;
+    out.goalLines = activePuzzle ? activePuzzle->goalLines : 0;
+    out.undoDepth = practice ? static_cast<int>(journal.size()) : -1;
+    out.deadTicks = deadTicks;
+    out.clearDeadTicks = clearDeadTicks;
+    out.clears = clears;
+}
+
+/**
+ * @brief Réinitialise complètement la partie.
+ *
+ * Si un puzzle est chargé, la grille et la suite de pièces en sont reprises.
+ *
+ * @param id Numéro de la nouvelle partie (repris dans les événements et les états publiés).
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::reset(std::uint32_t id) {
+    if (activePuzzle) {
+        board = BoardT(activePuzzle->board);
+        puzzleNext = 0;
+        piecesLeft = static_cast<int>(activePuzzle->pieces.size());
+    } else {
+        board = BoardT(board.getWidth(), board.getHeight());
+        piecesLeft = -1;
+    }
+    gameId = id;
+    tickCount = 0;
+
+    practice = practiceRequested && !activePuzzle;
+    journal.clear();
+    replay.clear();
+
+    score = 0;
+    level = 1;
+    totalLinesCleared = 0;
+    gravityAccumulator = 0;
+    lockTicks = 0;
+    softDrop = false;
+    clock.clear();
+    waiting = false;
+    waitAfterClear = false;
+    effectRows.clear();
+    deadTicks = 0;
+    clearDeadTicks = 0;
+    clears = 0;
+    gameOver = false;
+
+    current = drawPiece();
+    next = drawPiece();
+    spawned = current;
+    pieceKeys = 0;
+}
+
+/**
+ * @brief Applique la gravité du niveau à la pièce courante.
+ *
+ * Les lignes dues s'accumulent en virgule fixe ; une chute de plusieurs lignes
+ * est résolue en une seule requête `Board::dropDistance()`. Une pièce posée
+ * sur la pile se verrouille après `delays.lock` ticks, ou dès la ligne suivante
+ * si la descente rapide est maintenue. Chaque chute remet ce délai à zéro :
+ * il reste un compteur plutôt qu'une tâche.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::applyGravity() {
+    int g = gravity::forLevel(level);
+    if (softDrop) g = std::max(g, gravity::SOFT_DROP);
+
+    gravityAccumulator += g;
+    int rows = gravityAccumulator / gravity::ONE_G;
+    gravityAccumulator %= gravity::ONE_G;
+
+    int distance = board.dropDistance(current);
+    if (distance > 0) {
+        int fall = std::min(rows, distance);
+        if (fall > 0) {
+            current.move(0, fall);
+            lockTicks = 0;
+        }
+        return;
+    }
+
+    lockTicks++;
+    if (lockTicks >= delays.lock || (softDrop && rows > 0)) {
+        lockPiece();
+    }
+}
+
+/**
+ * @brief Pose le Tetromino courant sur la grille.
+ *
+ * Compare d'abord les appuis du joueur au minimum trouvé par `MoveSearch`
+ * (événement `Finesse`). Les lignes complètes sont effacées aussitôt ; la pièce
+ * suivante apparaît après le délai d'apparition (et d'effacement, s'il y en a eu).
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::lockPiece() {
+    if (finesse) {
+        search.setBoard(board);
+        int optimal = search.keysFor(spawned, current.getBlocks());
+        if (optimal >= 0) emit(GameEvent::Type::Finesse, pieceKeys + 1, optimal);
+    }
+
+    board.mergeTetromino(current);
+    if (practice) {
+        delta.piece = current.getId();
+        delta.cells.clear();
+        for (const auto& b : current.getBlocks()) {
+            if (b.y >= 0 && b.y < board.getHeight()) delta.cells.push_back(b);
+        }
+        delta.rows.clear();
+        delta.rowCells.clear();
+        scoreBefore = score;
+        levelBefore = level;
+    }
+    emit(GameEvent::Type::PiecePlaced, board.getStackHeight());
+
+    bool cleared = clearLines() > 0;
+    waiting = true;
+    waitAfterClear = cleared;
+    spawnAfter(delays.entry + (cleared ? delays.lineClear : 0));
+}
+
+/**
+ * @brief Efface les lignes complètes, compte les points et lance l'effet d'effacement.
+ *
+ * @return Nombre de lignes effacées.
+ */
+template <class BoardT>
+int BasicSimulation<BoardT>::clearLines() {
+    board.detectLinesToClear();
+    const auto& lines = board.getLinesToClear();
+    int cleared = static_cast<int>(lines.size());
+    if (cleared == 0) return 0;
+
+    std::uint32_t rowMask = 0;
+    for (int line : lines) {
+        if (line < 32) rowMask |= 1u << line;
+    }
+    if (practice) {
+        for (int line : lines) {
+            delta.rows.push_back(line);
+            for (int x = 0; x < board.getWidth(); x++) delta.rowCells.push_back(board.getCell(x, line));
+        }
+    }
+    effectRows.assign(lines.begin(), lines.end());
+    effectStart = tickCount;
+    endClearEffect(++effectId);
+
+    board.performClearLines();
+    clears++;
+    emit(GameEvent::Type::LinesCleared, cleared, static_cast<int>(rowMask));
+    updateScore(cleared);
+    return cleared;
+}
+
+/**
+ * @brief Tâche : fait apparaître la pièce suivante dans `ticks` ticks (0 : tout de suite).
+ */
+template <class BoardT>
+timeline::Task BasicSimulation<BoardT>::spawnAfter(int ticks) {
+    co_await clock.delay(ticks);
+    waiting = false;
+    spawnNext();
+}
+
+/**
+ * @brief Tâche : termine l'effet d'effacement, sauf si un effet plus récent l'a remplacé.
+ */
+template <class BoardT>
+timeline::Task BasicSimulation<BoardT>::endClearEffect(std::uint32_t effect) {
+    co_await clock.delay(delays.clearEffect);
+    if (effect == effectId) effectRows.clear();
+}
+
+/**
+ * @brief Remplace la pièce courante par la suivante et en tire une nouvelle.
+ *
+ * Déclare la fin de partie si la nouvelle pièce n'a pas la place d'apparaître
+ * ou, en mode puzzle, si le puzzle est terminé.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::spawnNext() {
+    gravityAccumulator = 0;
+    lockTicks = 0;
+    if (practice) recordPlacement();
+    if (checkPuzzleEnd()) return;
+
+    current = next;
+    next = drawPiece();
+    spawned = current;
+    pieceKeys = 0;
+    if (board.checkCollision(current)) {
+        gameOver = true;
+        if (activePuzzle) emit(GameEvent::Type::PuzzleEnded, 0, activePuzzle->index);
+        emit(GameEvent::Type::GameOver, score, level);
+    }
+}
+
+/**
+ * @brief Mode entraînement : ajoute au journal la pose qui vient de se terminer.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::recordPlacement() {
+    delta.score = score - scoreBefore;
+    delta.levelUp = level != levelBefore;
+    journal.record(delta, board.getWidth());
+}
+
+/**
+ * @brief Mode entraînement : annule la dernière pose du journal.
+ *
+ * Défait uniquement ce que la pose a changé (lignes effacées, cases posées,
+ * points, niveau) : le coût suit la taille de la pose, pas celle du plateau.
+ * La pièce posée redevient la pièce courante, à sa position d'apparition, et
+ * la pièce suivante sera tirée de nouveau : rejouer redonne la même suite.
+ * Publie `Undone` pour que les consommateurs des événements retirent la pose
+ * et ses effacements (la hauteur de pile maximale, elle, ne se défait pas).
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::undo() {
+    if (!journal.pop(delta, board.getWidth())) return;
+    effectRows.clear();
+
+    const int width = board.getWidth();
+    for (std::size_t r = delta.rows.size(); r-- > 0;) {
+        board.reinsertLine(delta.rows[r], std::span(delta.rowCells).subspan(r * width, width));
+    }
+    for (const auto& c : delta.cells) board.setCell(c.x, c.y, sf::Color::Black);
+
+    score -= delta.score;
+    totalLinesCleared -= static_cast<int>(delta.rows.size());
+    if (delta.levelUp) level--;
+
+    replay.push_back(next.getId());
+    next = Tetromino(current.getShape(), width/2);
+    current = Tetromino((*pieces)[delta.piece], width/2);
+    spawned = current;
+    pieceKeys = 0;
+    gravityAccumulator = 0;
+    lockTicks = 0;
+    gameOver = false;
+    emit(GameEvent::Type::Undone, static_cast<int>(delta.rows.size()), delta.levelUp ? 1 : 0);
+}
+
+/**
+ * @brief Mode puzzle : décompte la pièce posée et termine la partie si l'objectif
+ * est atteint ou s'il ne reste plus de pièce.
+ *
+ * @return true si la partie est terminée.
+ */
+template <class BoardT>
+bool BasicSimulation<BoardT>::checkPuzzleEnd() {
+    if (!activePuzzle) return false;
+
+    piecesLeft--;
+    bool solved = totalLinesCleared >= activePuzzle->goalLines;
+    if (!solved && piecesLeft > 0) return false;
+
+    gameOver = true;
+    emit(GameEvent::Type::PuzzleEnded, solved ? 1 : 0, activePuzzle->index);
+    emit(GameEvent::Type::GameOver, score, level);
+    return true;
+}
+
+/**
+ * @brief Met à jour le score et le niveau après l'effacement de lignes.
+ *
+ * @param linesCleared Nombre de lignes effacées simultanément (jusqu'à la hauteur de la plus grande pièce).
+ *
+ * @details
+ * - Barème des points attribués :
+ *   - 0 ligne : 0 point
+ *   - 1 ligne : 100 points
+ *   - 2 lignes : 300 points
+ *   - 3 lignes : 500 points
+ *   - 4 lignes : 800 points (Tetris)
+ *   - 5 lignes ou plus (pièces de plus de 4 cases) : comme 4 lignes
+ * - Tous les 10 lignes effacées (`totalLinesCleared / 10 >= level`), le niveau augmente de 1.
+ * - La gravité suit le niveau (voir `gravity::TABLE`), jusqu'à 20G.
+ *
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::updateScore(int linesCleared) {
+    static const std::array<int,5> comboPoints = {0,100,300,500,800};
+    score += comboPoints[std::min(linesCleared, 4)];
+
+    totalLinesCleared += linesCleared;
+    if (totalLinesCleared / 10 >= level) {
+        level++;
+        emit(GameEvent::Type::LevelChanged, level);
+    }
+}
+
+/**
+ * @brief Tire une nouvelle pièce au hasard, centrée en haut du plateau.
+ */
+template <class BoardT>
+Tetromino BasicSimulation<BoardT>::randomPiece() {
+    std::uniform_int_distribution<int> type(0, static_cast<int>(pieces->size()) - 1);
+    return Tetromino((*pieces)[type(rng)], board.getWidth()/2);
+}
+
+/**
+ * @brief Pièce suivante : prise dans la suite du puzzle, sinon au hasard.
+ *
+ * Une fois la suite épuisée, la dernière pièce est répétée (jamais jouée :
+ * le puzzle se termine avant). En mode entraînement, les pièces rendues
+ * par une annulation repassent d'abord.
+ */
+template <class BoardT>
+Tetromino BasicSimulation<BoardT>::drawPiece() {
+    if (!replay.empty()) {
+        PieceId id = replay.back();
+        replay.pop_back();
+        return Tetromino((*pieces)[id], board.getWidth()/2);
+    }
+    if (!activePuzzle) return randomPiece();
+
+    const auto& pieces = activePuzzle->pieces;
+    std::size_t i = std::min(puzzleNext, pieces.size() - 1);
+    if (puzzleNext < pieces.size()) puzzleNext++;
+    return Tetromino(pieces[i], board.getWidth()/2);
+}
+
+/**
+ * @brief Calcule la position du "Ghost Piece" (ombre du Tetromino).
+ *
+ * Le Ghost Piece est affiché en transparence pour indiquer où le Tetromino
+ * courant atterrira s'il est lâché directement.
+ *
+ * @return Tetromino Copie du Tetromino courant positionné en bas.
+ */
+template <class BoardT>
+Tetromino BasicSimulation<BoardT>::computeGhost() const {
+    Tetromino ghost = current;
+    ghost.setColor(sf::Color(200,200,200,120));
+    ghost.move(0, board.dropDistance(ghost));
+    return ghost;
+}
+
+/**
+ * @brief Ajoute un événement à transmettre au thread d'affichage.
+ */
+template <class BoardT>
+void BasicSimulation<BoardT>::emit(GameEvent::Type type, int value, int extra) {
+    pendingEvents.push_back({type, gameId, tickCount, value, extra});
+}
+
+template struct BasicSnapshot<Board>;
+template struct BasicSnapshot<StandardBoard>;
+template class BasicSimulation<Board>;
+template class BasicSimulation<StandardBoard>;
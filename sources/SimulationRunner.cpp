@@ -0,0 +1,146 @@
+#include "../includes/SimulationRunner.hpp"
+#include "../includes/Gravity.hpp"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief Prépare la simulation et publie son état initial (en pause).
+ *
+ * @param width Largeur du plateau (en nombre de cases).
+ * @param height Hauteur du plateau (en nombre de cases).
+ * @param seed Graine du tirage des pièces.
+ */
+SimulationRunner::SimulationRunner(int width, int height, std::uint32_t seed)
+    : sim(width, height, seed), snapshots(GameSnapshot(width, height))
+{
+    publish();
+    snapshots.update();
+}
+
+SimulationRunner::~SimulationRunner() {
+    stop();
+}
+
+/**
+ * @brief Démarre le thread de simulation (1 tick toutes les 1/60 s).
+ */
+void SimulationRunner::start() {
+    if (thread.joinable()) return;
+    stopRequested = false;
+    thread = std::thread([this]() { threadLoop(); });
+}
+
+/**
+ * @brief Arrête et attend le thread de simulation.
+ */
+void SimulationRunner::stop() {
+    stopRequested = true;
+    if (thread.joinable()) thread.join();
+}
+
+/**
+ * @brief Un pas de simulation : commandes en attente, tick, publication.
+ *
+ * Appelé par le thread de simulation, ou directement pour une exécution pas à pas.
+ */
+void SimulationRunner::step() {
+    InputCommand cmd;
+    while (inputs.pop(cmd)) {
+        // Le puzzle est déposé avant l'envoi du Reset : il est forcément visible ici
+        if (cmd.type == Command::Reset && puzzlePending.exchange(false)) {
+            std::lock_guard<std::mutex> lock(puzzleMutex);
+            sim.setPuzzle(std::move(pendingPuzzle));
+            pendingPuzzle.reset();
+        }
+        if (cmd.type == Command::Reset) sim.setPractice(practice);
+        sim.apply(cmd);
+    }
+
+    sim.tick();
+
+    for (const auto& e : sim.events()) events.push(e);
+    sim.clearEvents();
+
+    publish();
+}
+
+/**
+ * @brief Remplace la graine et recommence la partie, puis publie le nouvel état.
+ *
+ * Sert aux exécutions pas à pas reproductibles (banc d'essai) : le thread de
+ * simulation ne doit pas tourner.
+ */
+void SimulationRunner::reseed(std::uint32_t seed) {
+    sim.reseed(seed);
+    publish();
+}
+
+/**
+ * @brief Change le jeu de pièces et recommence la partie, puis publie le nouvel état.
+ *
+ * Le thread de simulation ne doit pas tourner ; `set` doit survivre à la simulation.
+ */
+void SimulationRunner::setPieceSet(const PieceSet& set) {
+    sim.setPieceSet(set);
+    publish();
+}
+
+/**
+ * @brief Transmet un puzzle (ou son absence) à la simulation.
+ *
+ * Pris en compte par le prochain `Reset` : l'appeler juste avant d'envoyer
+ * cette commande.
+ */
+void SimulationRunner::setPuzzle(std::optional<puzzle::Puzzle> p) {
+    std::lock_guard<std::mutex> lock(puzzleMutex);
+    pendingPuzzle = std::move(p);
+    puzzlePending = true;
+}
+
+/**
+ * @brief Copie l'état de la simulation dans le tampon d'écriture et le publie.
+ *
+ * Le flux d'état est écrit avant la publication : ensuite, le tampon appartient à l'affichage.
+ */
+void SimulationRunner::publish() {
+    GameSnapshot& out = snapshots.writeBuffer();
+    sim.writeSnapshot(out);
+    out.timings = timings;
+    if (stateFeed) stateFeed->publish(out);
+    snapshots.publish();
+}
+
+/**
+ * @brief Boucle du thread de simulation, cadencée sur des échéances absolues.
+ *
+ * Chaque tick a une échéance fixe : un tick en retard ne décale pas les suivants.
+ * Au-delà de `MAX_TICKS_PER_FRAME` ticks de retard, l'échéancier est recalé.
+ */
+void SimulationRunner::threadLoop() {
+    using Clock = std::chrono::steady_clock;
+    using Micro = std::chrono::microseconds;
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(gravity::TICK_SECONDS));
+
+    auto deadline = Clock::now();
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        auto start = Clock::now();
+        auto late = std::chrono::duration_cast<Micro>(start - deadline).count();
+
+        step();
+
+        auto busy = std::chrono::duration_cast<Micro>(Clock::now() - start).count();
+        timings.steps++;
+        timings.busyUs += busy;
+        timings.lastBusyUs = static_cast<std::uint32_t>(busy);
+        timings.maxBusyUs = std::max(timings.maxBusyUs, timings.lastBusyUs);
+        if (late > 0) timings.maxLateUs = std::max(timings.maxLateUs, static_cast<std::uint32_t>(late));
+        if (start - deadline > period) timings.lateSteps++;
+
+        deadline += period;
+        if (Clock::now() - deadline > period * gravity::MAX_TICKS_PER_FRAME) {
+            deadline = Clock::now();
+        }
+        std::this_thread::sleep_until(deadline);
+    }
+}
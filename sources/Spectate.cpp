@@ -0,0 +1,358 @@
+#include "../includes/Spectate.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace spectate {
+
+    namespace {
+        constexpr int X_BITS = 5;
+        constexpr int Y_BITS = 6;
+        constexpr int Y_BIAS = 16;          ///< Cases au-dessus du plateau (apparition)
+        constexpr int DROP_BITS = 6;
+        constexpr int ID_BITS = 8;
+        constexpr int ROTATION_BITS = 4;
+        constexpr int COUNT_BITS = 4;
+        constexpr int DX_BITS = 4;
+        constexpr int DY_BITS = 6;
+
+        /// Début d'un message : type et longueur provisoire.
+        std::size_t beginMessage(std::string& out, MessageType type) {
+            std::size_t start = out.size();
+            out.push_back(static_cast<char>(type));
+            out.append(2, '\0');
+            return start;
+        }
+
+        void endMessage(std::string& out, std::size_t start) {
+            std::size_t length = out.size() - start - FRAME_HEADER;
+            out[start + 1] = static_cast<char>(length & 0xFF);
+            out[start + 2] = static_cast<char>(length >> 8);
+        }
+
+        void putPiece(BitWriter& w, const feed::Piece& p) {
+            w.put(p.id, ID_BITS);
+            w.put(p.rotation, ROTATION_BITS);
+            w.put(p.cellCount, COUNT_BITS);
+            for (int i = 0; i < p.cellCount; i++) {
+                w.put(static_cast<std::uint32_t>(p.cells[2 * i]), X_BITS);
+                w.put(static_cast<std::uint32_t>(p.cells[2 * i + 1] + Y_BIAS), Y_BITS);
+            }
+        }
+
+        bool getPiece(BitReader& r, feed::Piece& p) {
+            p = {};
+            p.id = static_cast<std::uint8_t>(r.get(ID_BITS));
+            p.rotation = static_cast<std::uint8_t>(r.get(ROTATION_BITS));
+            p.cellCount = static_cast<std::uint8_t>(r.get(COUNT_BITS));
+            if (p.cellCount > feed::PIECE_CELLS) return false;
+            for (int i = 0; i < p.cellCount; i++) {
+                p.cells[2 * i] = static_cast<std::int8_t>(r.get(X_BITS));
+                p.cells[2 * i + 1] = static_cast<std::int8_t>(static_cast<int>(r.get(Y_BITS)) - Y_BIAS);
+            }
+            return r.ok();
+        }
+
+        bool samePiece(const feed::Piece& a, const feed::Piece& b) {
+            return a.id == b.id && a.rotation == b.rotation && a.cellCount == b.cellCount
+                && std::equal(a.cells.begin(), a.cells.begin() + 2 * a.cellCount, b.cells.begin());
+        }
+
+        /// Distance de chute de la pièce jusqu'à sa position fantôme.
+        int ghostDrop(const feed::Record& s) {
+            if (s.current.cellCount == 0 || s.ghost.cellCount != s.current.cellCount) return 0;
+            return s.ghost.cells[1] - s.current.cells[1];
+        }
+
+        void placeGhost(feed::Record& s, int drop) {
+            s.ghost = s.current;
+            for (int i = 0; i < s.ghost.cellCount; i++) s.ghost.cells[2 * i + 1] = static_cast<std::int8_t>(s.ghost.cells[2 * i + 1] + drop);
+        }
+
+        /// Décalage commun de toutes les cases (même pièce, même orientation), s'il est codable.
+        bool shiftOf(const feed::Piece& from, const feed::Piece& to, int& dx, int& dy) {
+            if (from.id != to.id || from.rotation != to.rotation || from.cellCount != to.cellCount || to.cellCount == 0) return false;
+            dx = to.cells[0] - from.cells[0];
+            dy = to.cells[1] - from.cells[1];
+            if (dx < -(1 << (DX_BITS - 1)) || dx >= (1 << (DX_BITS - 1))) return false;
+            if (dy < -(1 << (DY_BITS - 1)) || dy >= (1 << (DY_BITS - 1))) return false;
+            for (int i = 1; i < to.cellCount; i++) {
+                if (to.cells[2 * i] - from.cells[2 * i] != dx || to.cells[2 * i + 1] - from.cells[2 * i + 1] != dy) return false;
+            }
+            return true;
+        }
+
+        std::uint32_t changedRows(const std::array<std::uint32_t, feed::MAX_SIZE>& a,
+                                  const std::array<std::uint32_t, feed::MAX_SIZE>& b, int height) {
+            std::uint32_t mask = 0;
+            for (int y = 0; y < height; y++) {
+                if (a[y] != b[y]) mask |= 1u << y;
+            }
+            return mask;
+        }
+    }
+
+    void lockPiece(std::array<std::uint32_t, feed::MAX_SIZE>& rows, const feed::Piece& ghost, int width, int height) {
+        for (int i = 0; i < ghost.cellCount; i++) {
+            int x = ghost.cells[2 * i], y = ghost.cells[2 * i + 1];
+            if (x >= 0 && x < width && y >= 0 && y < height) rows[y] |= 1u << x;
+        }
+
+        const std::uint32_t full = width >= 32 ? ~0u : (1u << width) - 1;
+        int to = height - 1;
+        for (int y = height - 1; y >= 0; y--) {
+            if (rows[y] != full) rows[to--] = rows[y];
+        }
+        for (; to >= 0; to--) rows[to] = 0;
+    }
+
+    // --- Champs de bits ---
+
+    void BitWriter::put(std::uint32_t value, int bits) {
+        if (bits < 32) value &= (1u << bits) - 1;
+        pending |= static_cast<std::uint64_t>(value) << count;
+        count += bits;
+        while (count >= 8) {
+            out.push_back(static_cast<char>(pending & 0xFF));
+            pending >>= 8;
+            count -= 8;
+        }
+    }
+
+    void BitWriter::varint(std::uint32_t value) {
+        while (value >= 0x80) {
+            put((value & 0x7F) | 0x80, 8);
+            value >>= 7;
+        }
+        put(value, 8);
+    }
+
+    void BitWriter::flush() {
+        if (count > 0) out.push_back(static_cast<char>(pending & 0xFF));
+        pending = 0;
+        count = 0;
+    }
+
+    std::uint32_t BitReader::get(int bits) {
+        if (position + bits > size * 8) {
+            valid = false;
+            return 0;
+        }
+        std::uint32_t value = 0;
+        for (int done = 0; done < bits;) {
+            std::size_t byte = position >> 3;
+            int offset = static_cast<int>(position & 7);
+            int take = std::min(8 - offset, bits - done);
+            value |= ((static_cast<std::uint32_t>(data[byte]) >> offset) & ((1u << take) - 1)) << done;
+            done += take;
+            position += take;
+        }
+        return value;
+    }
+
+    std::int32_t BitReader::getSigned(int bits) {
+        std::uint32_t v = get(bits);
+        if (v & (1u << (bits - 1))) v |= ~0u << bits;
+        return static_cast<std::int32_t>(v);
+    }
+
+    std::uint32_t BitReader::varint() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            std::uint32_t byte = get(8);
+            value |= (byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        valid = false;
+        return 0;
+    }
+
+    // --- Serveur ---
+
+    Encoder::Encoder(int width, int height) : width(width), height(height) {}
+
+    void Encoder::hello(std::string& out) const {
+        std::size_t start = beginMessage(out, MessageType::Hello);
+        out.push_back(static_cast<char>(PROTOCOL_VERSION));
+        out.push_back(static_cast<char>(width));
+        out.push_back(static_cast<char>(height));
+        endMessage(out, start);
+    }
+
+    void Encoder::keyframe(const feed::Record& s, std::string& out) const {
+        std::size_t start = beginMessage(out, MessageType::Keyframe);
+        {
+            BitWriter w(out);
+            w.put(static_cast<std::uint32_t>(s.tick), 32);
+            w.put(static_cast<std::uint32_t>(s.tick >> 32), 32);
+            w.put(s.gameId, 32);
+            w.put(s.flags, 8);
+            w.put(s.score, 32);
+            w.put(s.level, 16);
+            w.put(s.lines, 16);
+            for (int y = 0; y < height; y++) w.put(s.rows[y], width);
+            putPiece(w, s.current);
+            w.put(static_cast<std::uint32_t>(ghostDrop(s)), DROP_BITS);
+            putPiece(w, s.next);
+        }
+        endMessage(out, start);
+    }
+
+    /**
+     * @brief Différences entre deux états, dans l'ordre : tick, lignes, pièce, pièce suivante, compteurs.
+     *
+     * Pour les lignes, la pose rejouée n'est choisie que si elle laisse moins de lignes à envoyer.
+     */
+    bool Encoder::delta(const feed::Record& prev, const feed::Record& cur, std::string& out) const {
+        if (cur.gameId != prev.gameId) {
+            keyframe(cur, out);
+            return true;
+        }
+
+        std::uint32_t plain = changedRows(prev.rows, cur.rows, height);
+        auto locked = prev.rows;
+        lockPiece(locked, prev.ghost, width, height);
+        std::uint32_t afterLock = changedRows(locked, cur.rows, height);
+        bool useLock = plain != 0 && prev.current.cellCount > 0 && std::popcount(afterLock) < std::popcount(plain);
+        std::uint32_t rowMask = useLock ? afterLock : plain;
+
+        bool pieceChanged = !samePiece(prev.current, cur.current) || ghostDrop(prev) != ghostDrop(cur);
+        bool nextChanged = !samePiece(prev.next, cur.next);
+        bool scoreChanged = prev.score != cur.score;
+        bool levelChanged = prev.level != cur.level;
+        bool linesChanged = prev.lines != cur.lines;
+        bool flagsChanged = prev.flags != cur.flags;
+        if (plain == 0 && !pieceChanged && !nextChanged && !scoreChanged && !levelChanged && !linesChanged && !flagsChanged) {
+            return false;
+        }
+
+        std::size_t start = beginMessage(out, MessageType::Delta);
+        {
+            BitWriter w(out);
+            w.varint(static_cast<std::uint32_t>(std::min<std::uint64_t>(cur.tick - prev.tick, UINT32_MAX)));
+
+            w.put(plain != 0, 1);
+            if (plain != 0) {
+                w.put(useLock, 1);
+                w.put(rowMask, height);
+                for (int y = 0; y < height; y++) {
+                    if (rowMask & (1u << y)) w.put(cur.rows[y], width);
+                }
+            }
+
+            w.put(pieceChanged, 1);
+            if (pieceChanged) {
+                int dx = 0, dy = 0;
+                bool shifted = shiftOf(prev.current, cur.current, dx, dy);
+                w.put(shifted ? 0 : 1, 1);
+                if (shifted) {
+                    w.putSigned(dx, DX_BITS);
+                    w.putSigned(dy, DY_BITS);
+                } else {
+                    putPiece(w, cur.current);
+                }
+                w.put(static_cast<std::uint32_t>(ghostDrop(cur)), DROP_BITS);
+            }
+
+            w.put(nextChanged, 1);
+            if (nextChanged) putPiece(w, cur.next);
+
+            w.put(scoreChanged, 1);
+            if (scoreChanged) w.zigzag(static_cast<std::int32_t>(cur.score - prev.score));
+            w.put(levelChanged, 1);
+            if (levelChanged) w.zigzag(static_cast<std::int32_t>(cur.level - prev.level));
+            w.put(linesChanged, 1);
+            if (linesChanged) w.zigzag(static_cast<std::int32_t>(cur.lines - prev.lines));
+            w.put(flagsChanged, 1);
+            if (flagsChanged) w.put(cur.flags, 8);
+        }
+        endMessage(out, start);
+        return true;
+    }
+
+    // --- Spectateur ---
+
+    bool Decoder::receive(const char* bytes, std::size_t size) {
+        buffer.insert(buffer.end(), bytes, bytes + size);
+
+        bool valid = true;
+        while (valid && buffer.size() - consumed >= FRAME_HEADER) {
+            const auto* frame = reinterpret_cast<const unsigned char*>(buffer.data() + consumed);
+            std::size_t length = frame[1] | (static_cast<std::size_t>(frame[2]) << 8);
+            if (buffer.size() - consumed < FRAME_HEADER + length) break;
+
+            valid = apply(static_cast<MessageType>(frame[0]), frame + FRAME_HEADER, length);
+            consumed += FRAME_HEADER + length;
+            count++;
+        }
+
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
+        consumed = 0;
+        return valid;
+    }
+
+    bool Decoder::apply(MessageType type, const unsigned char* payload, std::size_t size) {
+        BitReader r(payload, size);
+        feed::Record& s = current;
+
+        switch (type) {
+            case MessageType::Hello:
+                if (size < 3 || payload[0] != PROTOCOL_VERSION) return false;
+                boardWidth = payload[1];
+                boardHeight = payload[2];
+                return boardWidth > 0 && boardWidth <= feed::MAX_SIZE && boardHeight > 0 && boardHeight <= feed::MAX_SIZE;
+
+            case MessageType::Keyframe: {
+                if (boardWidth == 0) return false;
+                s = {};
+                s.tick = r.get(32);
+                s.tick |= static_cast<std::uint64_t>(r.get(32)) << 32;
+                s.gameId = r.get(32);
+                s.flags = r.get(8);
+                s.score = r.get(32);
+                s.level = r.get(16);
+                s.lines = r.get(16);
+                for (int y = 0; y < boardHeight; y++) s.rows[y] = r.get(boardWidth);
+                if (!getPiece(r, s.current)) return false;
+                placeGhost(s, static_cast<int>(r.get(DROP_BITS)));
+                if (!getPiece(r, s.next)) return false;
+                hasKeyframe = r.ok();
+                return hasKeyframe;
+            }
+
+            case MessageType::Delta: {
+                if (!hasKeyframe) return false;
+                s.tick += r.varint();
+
+                if (r.get(1)) {
+                    if (r.get(1)) lockPiece(s.rows, s.ghost, boardWidth, boardHeight);
+                    std::uint32_t mask = r.get(boardHeight);
+                    for (int y = 0; y < boardHeight; y++) {
+                        if (mask & (1u << y)) s.rows[y] = r.get(boardWidth);
+                    }
+                }
+
+                if (r.get(1)) {
+                    if (r.get(1) == 0) {
+                        int dx = r.getSigned(DX_BITS), dy = r.getSigned(DY_BITS);
+                        for (int i = 0; i < s.current.cellCount; i++) {
+                            s.current.cells[2 * i] = static_cast<std::int8_t>(s.current.cells[2 * i] + dx);
+                            s.current.cells[2 * i + 1] = static_cast<std::int8_t>(s.current.cells[2 * i + 1] + dy);
+                        }
+                    } else if (!getPiece(r, s.current)) {
+                        return false;
+                    }
+                    placeGhost(s, static_cast<int>(r.get(DROP_BITS)));
+                }
+
+                if (r.get(1) && !getPiece(r, s.next)) return false;
+                if (r.get(1)) s.score += static_cast<std::uint32_t>(r.zigzag());
+                if (r.get(1)) s.level += static_cast<std::uint32_t>(r.zigzag());
+                if (r.get(1)) s.lines += static_cast<std::uint32_t>(r.zigzag());
+                if (r.get(1)) s.flags = r.get(8);
+                return r.ok();
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,351 @@
+#include "../includes/SpectateServer.hpp"
+#include "../includes/Gravity.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace spectate {
+
+    namespace {
+        constexpr int MAX_EVENTS = 256;
+
+        double threadCpuSeconds() {
+            timespec ts{};
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return static_cast<double>(ts.tv_sec) + ts.tv_nsec / 1e9;
+        }
+
+        ServerStats difference(const ServerStats& a, const ServerStats& b) {
+            ServerStats d;
+            d.ticks = a.ticks - b.ticks;
+            d.deltas = a.deltas - b.deltas;
+            d.keyframes = a.keyframes - b.keyframes;
+            d.bytes = a.bytes - b.bytes;
+            d.keyframeBytes = a.keyframeBytes - b.keyframeBytes;
+            d.sends = a.sends - b.sends;
+            d.resyncs = a.resyncs - b.resyncs;
+            d.accepted = a.accepted - b.accepted;
+            d.viewerSeconds = a.viewerSeconds - b.viewerSeconds;
+            d.cpuSeconds = a.cpuSeconds - b.cpuSeconds;
+            d.seconds = a.seconds - b.seconds;
+            return d;
+        }
+    }
+
+    /**
+     * @brief Ouvre la socket d'écoute (127.0.0.1), l'instance epoll et la minuterie.
+     */
+    Server::Server(int width, int height, std::uint16_t port)
+        : encoder(width, height)
+    {
+        listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) {
+            failure = std::strerror(errno);
+            return;
+        }
+        int yes = 1;
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listenFd, SOMAXCONN) != 0) {
+            failure = std::strerror(errno);
+            return;
+        }
+
+        timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        int fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (timerFd < 0 || fd < 0) {
+            failure = std::strerror(errno);
+            if (fd >= 0) ::close(fd);
+            return;
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = &listenFd;
+        ::epoll_ctl(fd, EPOLL_CTL_ADD, listenFd, &ev);
+        ev.data.ptr = &timerFd;
+        ::epoll_ctl(fd, EPOLL_CTL_ADD, timerFd, &ev);
+        epollFd = fd;
+    }
+
+    Server::~Server() {
+        for (auto& c : clients) {
+            if (!c->closed) ::close(c->fd);
+        }
+        if (epollFd >= 0) ::close(epollFd);
+        if (timerFd >= 0) ::close(timerFd);
+        if (listenFd >= 0) ::close(listenFd);
+    }
+
+    /**
+     * @brief Sert les spectateurs et interroge la source jusqu'à `Source::Stop` ou `requestStop()`.
+     */
+    void Server::run(double hz, const std::function<Source(feed::Record&)>& next, double reportSeconds) {
+        if (!isOpen()) return;
+
+        const long periodNs = std::lround(1e9 / hz);
+        itimerspec spec{};
+        spec.it_interval.tv_sec = periodNs / 1000000000L;
+        spec.it_interval.tv_nsec = periodNs % 1000000000L;
+        spec.it_value = spec.it_interval;
+        ::timerfd_settime(timerFd, 0, &spec, nullptr);
+
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        const double cpuStart = threadCpuSeconds();
+        auto last = start;
+        double nextReport = reportSeconds;
+        ServerStats reported = totals;
+
+        feed::Record state{};
+        bool stopping = false;
+        epoll_event events[MAX_EVENTS];
+        while (!stopping && !stopRequested.load(std::memory_order_relaxed)) {
+            int n = ::epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+            if (n < 0 && errno != EINTR) break;
+
+            for (int i = 0; i < n; i++) {
+                void* tag = events[i].data.ptr;
+                if (tag == &listenFd) {
+                    accept();
+                } else if (tag == &timerFd) {
+                    std::uint64_t expirations = 0;
+                    if (::read(timerFd, &expirations, sizeof(expirations)) != sizeof(expirations)) continue;
+                    auto ticks = std::min<std::uint64_t>(expirations, gravity::MAX_TICKS_PER_FRAME);
+                    for (std::uint64_t t = 0; t < ticks && !stopping; t++) {
+                        Source result = next(state);
+                        if (result == Source::Updated) broadcast(state);
+                        stopping = result == Source::Stop;
+                    }
+                } else {
+                    Client& c = *static_cast<Client*>(tag);
+                    if (c.closed) continue;
+                    if (events[i].events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+                        drop(c);
+                        continue;
+                    }
+                    if (events[i].events & EPOLLIN) {
+                        // Les spectateurs n'envoient rien : on vide et on guette la fermeture
+                        char discard[256];
+                        ssize_t r = ::recv(c.fd, discard, sizeof(discard), MSG_DONTWAIT);
+                        if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                            drop(c);
+                            continue;
+                        }
+                    }
+                    if (events[i].events & EPOLLOUT) flush(c);
+                }
+            }
+
+            auto now = Clock::now();
+            totals.viewerSeconds += static_cast<double>(clients.size()) * std::chrono::duration<double>(now - last).count();
+            last = now;
+            sweep();
+
+            totals.seconds = std::chrono::duration<double>(now - start).count();
+            if (reportSeconds > 0.0 && totals.seconds >= nextReport) {
+                totals.cpuSeconds = threadCpuSeconds() - cpuStart;
+                reportSince(reported, std::clog);
+                reported = totals;
+                nextReport += reportSeconds;
+            }
+        }
+
+        totals.cpuSeconds = threadCpuSeconds() - cpuStart;
+        spec = {};
+        ::timerfd_settime(timerFd, 0, &spec, nullptr);
+    }
+
+    void Server::accept() {
+        while (true) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;     // EAGAIN : plus de connexion en attente
+
+            int yes = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+            auto client = std::make_unique<Client>();
+            client->fd = fd;
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.ptr = client.get();
+            if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                ::close(fd);
+                continue;
+            }
+            Client& c = *client;
+            clients.push_back(std::move(client));
+            totals.accepted++;
+
+            message.clear();
+            encoder.hello(message);
+            queue(c, message);
+            c.resync = true;
+            catchUp(c);
+        }
+    }
+
+    /**
+     * @brief Encode le passage du dernier état diffusé à `state`, une fois pour tous les spectateurs.
+     */
+    void Server::broadcast(const feed::Record& state) {
+        totals.ticks++;
+        if (!hasState) {
+            sent = state;
+            hasState = true;
+            for (auto& c : clients) {
+                if (!c->closed) catchUp(*c);
+            }
+            return;
+        }
+
+        message.clear();
+        bool newGame = state.gameId != sent.gameId;
+        if (!encoder.delta(sent, state, message)) return;
+        sent = state;
+        totals.deltas++;
+
+        for (auto& c : clients) {
+            if (c->closed || c->resync) continue;
+            if (c->pending.size() - c->sent > MAX_BACKLOG) {
+                c->resync = true;
+                totals.resyncs++;
+                continue;
+            }
+            if (newGame) {
+                totals.keyframes++;
+                totals.keyframeBytes += message.size();
+            }
+            queue(*c, message);
+        }
+    }
+
+    /**
+     * @brief Envoie directement si rien n'est en attente, sinon met le message à la suite.
+     */
+    void Server::queue(Client& c, const std::string& bytes) {
+        if (!c.pending.empty()) {
+            c.pending += bytes;
+            return;
+        }
+
+        ssize_t n = ::send(c.fd, bytes.data(), bytes.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        totals.sends++;
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                drop(c);
+                return;
+            }
+            n = 0;
+        }
+        totals.bytes += static_cast<std::uint64_t>(n);
+        if (static_cast<std::size_t>(n) == bytes.size()) return;
+
+        c.pending.assign(bytes, static_cast<std::size_t>(n));
+        c.sent = 0;
+        watchWrites(c, true);
+    }
+
+    /**
+     * @brief Envoie la suite du tampon quand la socket redevient disponible.
+     */
+    void Server::flush(Client& c) {
+        while (c.sent < c.pending.size()) {
+            ssize_t n = ::send(c.fd, c.pending.data() + c.sent, c.pending.size() - c.sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+            totals.sends++;
+            if (n < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) drop(c);
+                return;
+            }
+            totals.bytes += static_cast<std::uint64_t>(n);
+            c.sent += static_cast<std::size_t>(n);
+        }
+        c.pending.clear();
+        c.sent = 0;
+        watchWrites(c, false);
+        catchUp(c);
+    }
+
+    /**
+     * @brief Image clé de l'état diffusé pour un spectateur nouveau ou en retard, dès que son tampon est vide.
+     */
+    void Server::catchUp(Client& c) {
+        if (!c.resync || !hasState || !c.pending.empty() || c.closed) return;
+        c.resync = false;
+        keyframeBuffer.clear();
+        encoder.keyframe(sent, keyframeBuffer);
+        totals.keyframes++;
+        totals.keyframeBytes += keyframeBuffer.size();
+        queue(c, keyframeBuffer);
+    }
+
+    void Server::drop(Client& c) {
+        if (c.closed) return;
+        c.closed = true;
+        ::close(c.fd);  // retire aussi la socket de l'instance epoll
+    }
+
+    void Server::watchWrites(Client& c, bool enable) {
+        if (c.writable == !enable || c.closed) return;
+        c.writable = !enable;
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP | (enable ? EPOLLOUT : 0u);
+        ev.data.ptr = &c;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+    }
+
+    /// Retire les spectateurs fermés (après le traitement d'un lot d'événements : aucun pointeur pendant).
+    void Server::sweep() {
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](const auto& c) { return c->closed; }),
+                      clients.end());
+    }
+
+    void Server::report(std::ostream& out) const {
+        reportSince({}, out);
+    }
+
+    /**
+     * @brief Débit et CPU par spectateur sur la période, comparés à un état complet envoyé à chaque tick.
+     */
+    void Server::reportSince(const ServerStats& from, std::ostream& out) const {
+        ServerStats d = difference(totals, from);
+        if (d.seconds <= 0.0) return;
+
+        const double viewers = d.viewerSeconds / d.seconds;
+        const double perViewer = d.viewerSeconds > 0.0 ? 1.0 / d.viewerSeconds : 0.0;
+        const double ticksPerSecond = d.ticks / d.seconds;
+        std::string full;
+        if (hasState) encoder.keyframe(sent, full);
+        const double fullBytesPerSecond = static_cast<double>(full.size()) * ticksPerSecond;
+        const double bytesPerSecond = d.bytes * perViewer;
+
+        out << std::fixed << std::setprecision(1)
+            << "[spectate] " << clients.size() << " spectateur(s) (" << viewers << " en moyenne), "
+            << ticksPerSecond << " etats/s, " << d.deltas / d.seconds << " deltas/s : "
+            << bytesPerSecond << " o/s par spectateur (images cles " << (d.bytes ? 100.0 * d.keyframeBytes / d.bytes : 0.0)
+            << " %), " << d.sends * perViewer << " send/s par spectateur, CPU " << 100.0 * d.cpuSeconds / d.seconds
+            << " % (" << 1e6 * d.cpuSeconds * perViewer << " us/s par spectateur)";
+        if (fullBytesPerSecond > 0.0 && bytesPerSecond > 0.0) {
+            out << " ; etat complet a chaque tick : " << fullBytesPerSecond << " o/s (x"
+                << fullBytesPerSecond / bytesPerSecond << ")";
+        }
+        if (d.resyncs) out << ", " << d.resyncs << " rattrapage(s)";
+        out << std::endl;
+    }
+}
@@ -0,0 +1,298 @@
+#include "../includes/SpectatorWall.hpp"
+#include "../includes/Gravity.hpp"
+#include "../includes/Resources.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr unsigned WINDOW_WIDTH = 1280;
+    constexpr unsigned WINDOW_HEIGHT = 800;
+    constexpr float HEADER_HEIGHT = 28.f;
+    constexpr float LABEL_HEIGHT = 16.f;    ///< Bandeau du score au-dessus de chaque plateau
+    constexpr float MARGIN = 6.f;
+    constexpr unsigned TEXT_SIZE = 13;      ///< Une seule taille : une seule texture de glyphes
+
+    /// Affichage de l'écran de fin avant de relancer la partie (2 s).
+    constexpr int RESTART_TICKS = 2 * gravity::TICKS_PER_SECOND;
+
+    const sf::Color BOARD_COLOR(20, 20, 28);
+    const sf::Color OVER_VEIL(0, 0, 0, 170);
+}
+
+/**
+ * @brief Une partie du mur, déjà en marche.
+ */
+SpectatorWall::Match::Match(int width, int height, std::uint32_t s, const PieceSet& pieces)
+    : sim(width, height, s), bot(width, height), snap(width, height), seed(s), every(1)
+{
+    sim.setPieceSet(pieces);
+    sim.apply({Command::Resume});
+    sim.writeSnapshot(snap);
+}
+
+SpectatorWall::SpectatorWall(int games, std::uint32_t seed, const PieceSet& pieces, unsigned threads, double thinkMs)
+    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Tetris SFML - mur de spectateurs"),
+      threadCount(std::clamp(threads ? threads : std::thread::hardware_concurrency(), 1u,
+                             static_cast<unsigned>(std::clamp(games, MIN_GAMES, MAX_GAMES)))),
+      frameStart(threadCount), frameDone(threadCount)
+{
+    if (!font.loadFromMemory(resources::defaultFontData, resources::defaultFontSize)) {
+        throw std::runtime_error("Impossible de charger la police integree !");
+    }
+
+    games = std::clamp(games, MIN_GAMES, MAX_GAMES);
+    matches.reserve(games);
+    for (int i = 0; i < games; i++) {
+        auto m = std::make_unique<Match>(boardWidth, boardHeight, seed + static_cast<std::uint32_t>(i) * 7919u, pieces);
+        m->every = 4 + (i % 6) * 3;     // des robots de vitesses différentes
+        m->countdown = i % m->every;    // et décalés entre eux
+        if (thinkMs > 0.0) m->bot.setLookahead(pieces, {3, 6, thinkMs, 1});
+        matches.push_back(std::move(m));
+    }
+
+    cells.resize(games * (boardWidth * boardHeight + MAX_CELLS + 2) * 4);
+    cells.clear();                      // garde la place réservée
+    layout();
+
+    for (unsigned t = 1; t < threadCount; t++) workers.emplace_back([this]() { workerLoop(); });
+}
+
+SpectatorWall::~SpectatorWall() {
+    stopping = true;
+    frameStart.arrive_and_wait();
+    for (auto& w : workers) w.join();
+}
+
+/**
+ * @brief Boucle d'affichage : simulation de toutes les parties, puis rendu.
+ *
+ * Sans limite d'images, les ticks dus sont rattrapés d'après l'horloge (au plus
+ * `MAX_TICKS_PER_FRAME` par image). Avec une limite, chaque image joue exactement
+ * un tick et la synchronisation verticale est coupée : la mesure est reproductible.
+ *
+ * @param frames Nombre d'images à afficher (0 : jusqu'à la fermeture de la fenêtre).
+ */
+void SpectatorWall::run(long frames) {
+    using Clock = std::chrono::steady_clock;
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    window.setVerticalSyncEnabled(frames == 0);
+    auto last = Clock::now();
+    double due = 0.0;
+
+    while (window.isOpen() && (frames == 0 || framesShown < frames)) {
+        sf::Event e;
+        while (window.pollEvent(e)) {
+            if (e.type == sf::Event::Closed) window.close();
+            if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Escape) window.close();
+        }
+
+        auto now = Clock::now();
+        if (frames == 0) {
+            due += std::chrono::duration<double>(now - last).count() / gravity::TICK_SECONDS;
+            pendingTicks = std::min(static_cast<int>(due), gravity::MAX_TICKS_PER_FRAME);
+            due = std::min(due - pendingTicks, 1.0);
+        } else {
+            pendingTicks = 1;
+        }
+        last = now;
+
+        // Les barrières ordonnent les accès : les workers ne touchent aux parties qu'entre les deux
+        nextMatch = 0;
+        frameStart.arrive_and_wait();
+        stepMatches();
+        frameDone.arrive_and_wait();
+
+        if (perfLog) {
+            perf::Reading search;
+            for (auto& m : matches) {
+                search += m->searchCounters;
+                m->searchCounters = {};
+            }
+            perfLog->add("search", search);
+            perfLog->start();
+        }
+
+        auto stepped = Clock::now();
+        render();
+        if (perfLog) {
+            perfLog->lap("render");
+            perfLog->nextFrame();
+        }
+        stepMs += Ms(stepped - now).count();
+        renderMs += Ms(Clock::now() - stepped).count();
+        framesShown++;
+    }
+
+    int played = 0;
+    long searches = 0, depthSum = 0;
+    std::uint64_t nodes = 0;
+    double searchMs = 0.0;
+    for (const auto& m : matches) {
+        played += m->played;
+        searches += m->searches;
+        depthSum += m->depthSum;
+        nodes += m->nodes;
+        searchMs += m->searchMs;
+    }
+    double perFrame = framesShown ? 1.0 / framesShown : 0.0;
+    std::clog << std::fixed << std::setprecision(3)
+              << "[mur] " << matches.size() << " parties, " << threadCount << " thread(s), "
+              << framesShown << " images : simulation " << stepMs * perFrame << " ms/image, rendu "
+              << renderMs * perFrame << " ms/image, " << window.getDrawCalls() << " appels de dessin/image, "
+              << played << " partie(s) terminee(s)" << std::endl;
+    if (searches > 0) {
+        std::clog << std::setprecision(2)
+                  << "[mur] recherche : " << searches << " coups, " << searchMs / searches << " ms/coup, profondeur moyenne "
+                  << static_cast<double>(depthSum) / searches << ", " << std::setprecision(0)
+                  << (searchMs > 0.0 ? nodes / searchMs : 0.0) << " knoeuds/s par thread" << std::endl;
+    }
+    if (perfLog) perfLog->report(std::clog);
+}
+
+void SpectatorWall::workerLoop() {
+    while (true) {
+        frameStart.arrive_and_wait();
+        if (stopping) return;
+        stepMatches();
+        frameDone.arrive_and_wait();
+    }
+}
+
+/**
+ * @brief Prend les parties une à une jusqu'à épuisement (partagé par tous les threads).
+ */
+void SpectatorWall::stepMatches() {
+    for (std::size_t i; (i = nextMatch.fetch_add(1, std::memory_order_relaxed)) < matches.size();) {
+        for (int t = 0; t < pendingTicks; t++) stepMatch(*matches[i]);
+    }
+}
+
+/**
+ * @brief Un tick d'une partie : coup du robot si c'est son tour, puis simulation.
+ */
+void SpectatorWall::stepMatch(Match& m) {
+    if (m.snap.gameOver) {
+        if (++m.overTicks < RESTART_TICKS) return;
+        m.overTicks = 0;
+        m.played++;
+        m.seed = m.seed * 1664525u + 1013904223u;   // graine suivante (LCG)
+        m.sim.reseed(m.seed);
+    } else if (--m.countdown <= 0) {
+        perf::Reading before;
+        if (perfLog) before = perf::threadCounters().read();
+        bool played = m.bot.play(m.sim, m.snap);
+        if (perfLog) m.searchCounters += perf::threadCounters().read() - before;
+
+        if (played) {
+            if (const bot::SearchStats* s = m.bot.searchStats()) {
+                m.searches++;
+                m.depthSum += s->depth;
+                m.nodes += s->nodes;
+                m.searchMs += s->ms;
+            }
+        }
+        m.countdown = m.every;
+    }
+
+    m.sim.tick();
+    m.sim.clearEvents();
+    m.sim.writeSnapshot(m.snap);
+}
+
+/**
+ * @brief Choisit le nombre de colonnes qui donne les plus grandes cases.
+ */
+void SpectatorWall::layout() {
+    const int n = static_cast<int>(matches.size());
+    const float width = static_cast<float>(WINDOW_WIDTH);
+    const float height = WINDOW_HEIGHT - HEADER_HEIGHT;
+
+    cellSize = 0.f;
+    for (int c = 1; c <= n; c++) {
+        int r = (n + c - 1) / c;
+        float w = width / c, h = height / r;
+        float size = std::floor(std::min((w - MARGIN) / boardWidth, (h - MARGIN - LABEL_HEIGHT) / boardHeight));
+        if (size > cellSize) {
+            cellSize = size;
+            columns = c;
+            tileSize = {w, h};
+        }
+    }
+}
+
+/**
+ * @brief Reconstruit les deux tableaux de sommets et les dessine.
+ */
+void SpectatorWall::render() {
+    cells.clear();
+    glyphs.clear();
+
+    int played = 0;
+    for (const auto& m : matches) played += m->played;
+    label = std::to_string(matches.size()) + " parties   " + std::to_string(threadCount) + " thread(s)   " +
+            std::to_string(played) + " terminee(s)   ECHAP : quitter";
+    appendText(label, MARGIN, MARGIN + TEXT_SIZE, sf::Color::White);
+
+    const float boardW = cellSize * boardWidth;
+    const float boardH = cellSize * boardHeight;
+    const float block = std::max(1.f, cellSize - 1.f);
+
+    for (std::size_t i = 0; i < matches.size(); i++) {
+        const Match& m = *matches[i];
+        const GameSnapshot& snap = m.snap;
+        float ox = (i % columns) * tileSize.x + (tileSize.x - boardW) / 2.f;
+        float oy = HEADER_HEIGHT + (i / columns) * tileSize.y + LABEL_HEIGHT;
+
+        appendQuad(cells, {ox, oy, boardW, boardH}, BOARD_COLOR);
+        for (int y = 0; y < boardHeight; y++) {
+            for (int x = 0; x < boardWidth; x++) {
+                const sf::Color& c = snap.board.getCell(x, y);
+                if (c != sf::Color::Black) appendQuad(cells, {ox + x * cellSize, oy + y * cellSize, block, block}, c);
+            }
+        }
+        if (!snap.waiting && !snap.gameOver) {
+            for (const auto& b : snap.current.getBlocks()) {
+                if (b.y < 0) continue;
+                appendQuad(cells, {ox + b.x * cellSize, oy + b.y * cellSize, block, block}, snap.current.getColor());
+            }
+        }
+        if (snap.gameOver) appendQuad(cells, {ox, oy, boardW, boardH}, OVER_VEIL);
+
+        label = '#' + std::to_string(i + 1) + ' ' + std::to_string(snap.score) + " N" + std::to_string(snap.level);
+        appendText(label, ox, oy - 3.f, snap.gameOver ? sf::Color(150, 150, 150) : sf::Color::White);
+    }
+
+    window.resetDrawCalls();
+    window.clear(sf::Color::Black);
+    window.draw(cells);
+    window.draw(glyphs, sf::RenderStates(&font.getTexture(TEXT_SIZE)));
+    window.display();
+}
+
+void SpectatorWall::appendQuad(sf::VertexArray& target, sf::FloatRect r, sf::Color color, sf::FloatRect tex) {
+    target.append(sf::Vertex({r.left, r.top}, color, {tex.left, tex.top}));
+    target.append(sf::Vertex({r.left + r.width, r.top}, color, {tex.left + tex.width, tex.top}));
+    target.append(sf::Vertex({r.left + r.width, r.top + r.height}, color, {tex.left + tex.width, tex.top + tex.height}));
+    target.append(sf::Vertex({r.left, r.top + r.height}, color, {tex.left, tex.top + tex.height}));
+}
+
+/**
+ * @brief Ajoute un texte aux glyphes à dessiner (une ligne, ASCII).
+ *
+ * @param x Bord gauche du texte.
+ * @param y Ligne de base.
+ */
+void SpectatorWall::appendText(std::string_view text, float x, float y, sf::Color color) {
+    for (char ch : text) {
+        const sf::Glyph& g = font.getGlyph(static_cast<unsigned char>(ch), TEXT_SIZE, false);
+        sf::FloatRect tex(g.textureRect);
+        appendQuad(glyphs, {x + g.bounds.left, y + g.bounds.top, g.bounds.width, g.bounds.height}, color, tex);
+        x += g.advance;
+    }
+}
@@ -0,0 +1,47 @@
+#include "../includes/StartupTrace.hpp"
+#include <iomanip>
+
+namespace {
+    double toMs(std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+}
+
+/**
+ * @brief Démarre la chronologie (instant zéro).
+ */
+StartupTrace::StartupTrace() : start(Clock::now()) {}
+
+/**
+ * @brief Enregistre la fin d'une étape du démarrage.
+ *
+ * @param label Nom de l'étape (ex. "police", "fenetre").
+ */
+void StartupTrace::mark(const std::string& label) {
+    steps.push_back({label, Clock::now()});
+}
+
+/**
+ * @brief Retourne le temps écoulé entre le début et le dernier jalon.
+ */
+double StartupTrace::totalMs() const {
+    return steps.empty() ? 0.0 : toMs(steps.back().at - start);
+}
+
+/**
+ * @brief Affiche la chronologie du démarrage.
+ *
+ * Une ligne par étape : temps cumulé depuis le début et durée de l'étape.
+ *
+ * @param out Flux de sortie (ex. `std::clog`).
+ */
+void StartupTrace::report(std::ostream& out) const {
+    auto previous = start;
+    out << std::fixed << std::setprecision(1);
+    for (const auto& step : steps) {
+        out << "[demarrage] " << std::setw(8) << toMs(step.at - start) << " ms  (+"
+            << toMs(step.at - previous) << " ms)  " << step.label << '\n';
+        previous = step.at;
+    }
+    out << "[demarrage] temps jusqu'a la premiere image : " << totalMs() << " ms" << std::endl;
+}
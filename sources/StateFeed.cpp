@@ -0,0 +1,136 @@
+#include "../includes/StateFeed.hpp"
+#include "../includes/Simulation.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace feed {
+
+    static_assert(MAX_CELLS <= PIECE_CELLS, "Une pièce doit tenir dans un enregistrement du flux");
+
+    namespace {
+        void writePiece(Piece& out, const Tetromino& piece) {
+            const Cells& blocks = piece.getBlocks();
+            out = {};
+            out.id = piece.getId();
+            out.rotation = static_cast<std::uint8_t>(piece.getRotation());
+            out.cellCount = static_cast<std::uint8_t>(blocks.size());
+            for (std::size_t i = 0; i < blocks.size(); i++) {
+                out.cells[2 * i] = static_cast<std::int8_t>(blocks[i].x);
+                out.cells[2 * i + 1] = static_cast<std::int8_t>(blocks[i].y);
+            }
+        }
+    }
+
+    void capture(Record& out, const GameSnapshot& snap) {
+        out = {};
+        out.tick = snap.tick;
+        out.gameId = snap.gameId;
+        out.flags = (snap.running ? Running : 0u) | (snap.gameOver ? GameOver : 0u)
+                  | (snap.waiting ? Waiting : 0u) | (snap.clearing ? Clearing : 0u)
+                  | (snap.piecesLeft >= 0 ? Puzzle : 0u) | (snap.undoDepth >= 0 ? Practice : 0u);
+        out.score = static_cast<std::uint32_t>(snap.score);
+        out.level = static_cast<std::uint32_t>(snap.level);
+        out.lines = static_cast<std::uint32_t>(snap.lines);
+
+        out.lastBusyUs = snap.timings.lastBusyUs;
+        out.maxBusyUs = snap.timings.maxBusyUs;
+        out.maxLateUs = snap.timings.maxLateUs;
+        out.lateSteps = static_cast<std::uint32_t>(std::min<std::uint64_t>(snap.timings.lateSteps, UINT32_MAX));
+
+        writePiece(out.current, snap.current);
+        writePiece(out.ghost, snap.ghost);
+        writePiece(out.next, snap.next);
+
+        for (int y = 0; y < snap.board.getHeight(); y++) out.rows[y] = snap.board.getRowBits(y);
+    }
+
+    /**
+     * @brief Crée (ou remplace) le segment et y écrit l'en-tête.
+     *
+     * La signature est écrite en dernier : un lecteur qui s'attache pendant
+     * l'initialisation refuse le segment au lieu de lire un en-tête incomplet.
+     */
+    Writer::Writer(const std::string& name, int width, int height) : name(name) {
+        if (width > MAX_SIZE || height > MAX_SIZE) {
+            failure = "plateau trop grand pour le flux (32 x 32 au plus)";
+            return;
+        }
+#ifdef _WIN32
+        failure = "memoire partagee POSIX indisponible sous Windows";
+#else
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+        if (fd < 0) {
+            failure = std::strerror(errno);
+            return;
+        }
+        void* p = MAP_FAILED;
+        if (::ftruncate(fd, static_cast<off_t>(SEGMENT_BYTES)) == 0) {
+            p = ::mmap(nullptr, SEGMENT_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        if (p == MAP_FAILED) {
+            failure = std::strerror(errno);
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return;
+        }
+        ::close(fd);
+
+        auto* bytes = static_cast<unsigned char*>(p);
+        header = new (bytes) Header();
+        slots = reinterpret_cast<Slot*>(bytes + sizeof(Header));
+        for (std::uint32_t i = 0; i < CAPACITY; i++) new (&slots[i]) Slot();
+
+        header->version = FORMAT_VERSION;
+        header->slotSize = sizeof(Slot);
+        header->capacity = CAPACITY;
+        header->width = static_cast<std::uint32_t>(width);
+        header->height = static_cast<std::uint32_t>(height);
+        header->producer = static_cast<std::uint32_t>(::getpid());
+        header->alive.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = MAGIC;
+#endif
+    }
+
+    /**
+     * @brief Signale la fermeture aux lecteurs et supprime le nom du segment.
+     */
+    Writer::~Writer() {
+#ifndef _WIN32
+        if (!header) return;
+        header->alive.store(0, std::memory_order_release);
+        ::munmap(header, SEGMENT_BYTES);
+        ::shm_unlink(name.c_str());
+#endif
+    }
+
+    /**
+     * @brief Écrit l'enregistrement suivant, en écrasant le plus ancien.
+     *
+     * L'enregistrement est préparé hors de l'anneau puis copié : la case n'est
+     * en cours d'écriture que le temps d'une copie de 240 octets.
+     */
+    void Writer::publish(const GameSnapshot& snap) {
+        if (!header) return;
+
+        Record record;
+        capture(record, snap);
+
+        Slot& slot = slots[written % CAPACITY];
+        slot.sequence.store(2 * written + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.record, &record, sizeof(Record));
+        slot.sequence.store(2 * written + 2, std::memory_order_release);
+
+        header->published.store(++written, std::memory_order_release);
+    }
+}
@@ -0,0 +1,91 @@
+#include "../includes/StateFeedReader.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace feed {
+
+    /**
+     * @brief Projette le segment et vérifie son format.
+     *
+     * @param name Nom POSIX donné à l'écrivain (ex. "/tetris-feed").
+     */
+    Reader::Reader(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            failure = std::strerror(errno);
+            return;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < SEGMENT_BYTES) {
+            failure = "segment trop petit (ecrivain en cours d'initialisation ?)";
+            ::close(fd);
+            return;
+        }
+        void* p = ::mmap(nullptr, SEGMENT_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            failure = std::strerror(errno);
+            return;
+        }
+
+        const auto* h = static_cast<const Header*>(p);
+        if (h->magic != MAGIC || h->version != FORMAT_VERSION
+            || h->slotSize != sizeof(Slot) || h->capacity != CAPACITY) {
+            failure = "format de flux inconnu";
+            ::munmap(p, SEGMENT_BYTES);
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        header = h;
+        slots = reinterpret_cast<const Slot*>(static_cast<const unsigned char*>(p) + sizeof(Header));
+        std::uint64_t published = header->published.load(std::memory_order_acquire);
+        cursor = published > 0 ? published - 1 : 0;
+    }
+
+    Reader::~Reader() {
+        if (header) ::munmap(const_cast<Header*>(header), SEGMENT_BYTES);
+    }
+
+    /**
+     * @brief Lit l'enregistrement `cursor` par le protocole seqlock.
+     *
+     * Une case réécrite pendant la copie (ou avant) signifie que l'écrivain a
+     * fait le tour de l'anneau : le lecteur repart du plus récent.
+     */
+    Reader::Status Reader::next(Record& out) {
+        while (true) {
+            // alive est lu avant published : un flux fermé n'a plus rien à publier ensuite
+            bool alive = header->alive.load(std::memory_order_acquire) != 0;
+            std::uint64_t published = header->published.load(std::memory_order_acquire);
+            if (cursor >= published) return alive ? Status::Empty : Status::Closed;
+
+            if (published - cursor > CAPACITY) {
+                lost += published - 1 - cursor;
+                cursor = published - 1;
+            }
+
+            const Slot& slot = slots[cursor % CAPACITY];
+            const std::uint64_t expected = 2 * cursor + 2;
+            std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before == expected) {
+                std::memcpy(&out, &slot.record, sizeof(Record));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+                    cursor++;
+                    count++;
+                    return Status::Record;
+                }
+            }
+
+            // Case déjà réécrite : l'écrivain a pris un tour d'avance, on saute au plus récent
+            published = header->published.load(std::memory_order_acquire);
+            lost += published - 1 - cursor;
+            cursor = published - 1;
+        }
+    }
+}
@@ -0,0 +1,287 @@
+#include "../includes/Telemetry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace telemetry {
+
+namespace {
+    /// Les durées d'image sont classées par tranches de 0,25 ms jusqu'à 64 ms.
+    constexpr double FRAME_BUCKET_US = 250.0;
+    constexpr std::size_t FRAME_BUCKETS = 256;
+
+    constexpr std::uint64_t align8(std::uint64_t n) { return (n + 7) & ~std::uint64_t(7); }
+
+    /// Colonne en cours de construction (copie brute de ses éléments).
+    struct ColumnData {
+        Column id;
+        std::uint16_t elementSize;
+        std::vector<unsigned char> bytes;
+
+        template <typename T>
+        void push(T value) {
+            auto* p = reinterpret_cast<const unsigned char*>(&value);
+            bytes.insert(bytes.end(), p, p + sizeof(T));
+        }
+        std::uint64_t count() const { return bytes.size() / elementSize; }
+    };
+
+    template <typename T, typename F>
+    ColumnData makeColumn(Column id, const std::vector<GameRecord>& games, F field) {
+        ColumnData c{id, sizeof(T), {}};
+        c.bytes.reserve(games.size() * sizeof(T));
+        for (const auto& g : games) c.push<T>(static_cast<T>(field(g)));
+        return c;
+    }
+}
+
+/**
+ * @brief Crée un histogramme.
+ *
+ * @param bucketWidth Largeur d'une case.
+ * @param bucketCount Nombre de cases (la dernière reçoit les valeurs hors borne).
+ */
+Histogram::Histogram(double bucketWidth, std::size_t bucketCount)
+    : width(bucketWidth), buckets(bucketCount, 0)
+{}
+
+/**
+ * @brief Ajoute une valeur (les valeurs négatives vont dans la première case).
+ */
+void Histogram::add(double value) {
+    std::size_t i = value <= 0 ? 0 : static_cast<std::size_t>(value / width);
+    buckets[std::min(i, buckets.size() - 1)]++;
+    total++;
+    sum += value;
+    maximum = std::max(maximum, value);
+}
+
+/**
+ * @brief Cumule un autre histogramme de même géométrie.
+ */
+void Histogram::merge(const Histogram& other) {
+    for (std::size_t i = 0; i < buckets.size() && i < other.buckets.size(); i++) {
+        buckets[i] += other.buckets[i];
+    }
+    total += other.total;
+    sum += other.sum;
+    maximum = std::max(maximum, other.maximum);
+}
+
+/**
+ * @brief Centile approché (borne haute de la case qui le contient).
+ *
+ * @param p Centile voulu, entre 0 et 100.
+ */
+double Histogram::percentile(double p) const {
+    if (total == 0) return 0.0;
+    auto rank = static_cast<std::uint64_t>(p / 100.0 * (total - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return i + 1 == buckets.size() ? maximum : std::min(maximum, (i + 1) * width);
+        }
+    }
+    return maximum;
+}
+
+Recorder::Recorder() : frameTimes(FRAME_BUCKET_US, FRAME_BUCKETS) {}
+
+/**
+ * @brief Démarre l'enregistrement d'une nouvelle partie.
+ */
+void Recorder::begin() {
+    record = GameRecord{};
+    record.startTime = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    frameTimes = Histogram(FRAME_BUCKET_US, FRAME_BUCKETS);
+    elapsedMs = 0.0;
+    active = true;
+}
+
+/**
+ * @brief Fait avancer le temps de jeu d'une image.
+ *
+ * @param dt Durée de l'image (en secondes).
+ */
+void Recorder::advance(float dt) {
+    if (!active) return;
+    elapsedMs += dt * 1000.0;
+    frameTimes.add(dt * 1e6);
+}
+
+/**
+ * @brief Enregistre la pose d'une pièce.
+ *
+ * @param stackHeight Hauteur de la pile juste après la pose (en cases).
+ */
+void Recorder::onPiecePlaced(int stackHeight) {
+    if (!active) return;
+    record.placementMs.push_back(static_cast<std::uint32_t>(elapsedMs));
+    record.maxStackHeight = std::max(record.maxStackHeight, static_cast<std::uint32_t>(stackHeight));
+}
+
+/**
+ * @brief Enregistre un effacement simultané de `count` lignes (1 à 4).
+ */
+void Recorder::onLinesCleared(int count) {
+    if (!active || count <= 0) return;
+    record.lines += count;
+    record.clears[std::min(count, 4) - 1]++;
+}
+
+/**
+ * @brief Enregistre le passage à un nouveau niveau.
+ */
+void Recorder::onLevelChanged(int level) {
+    if (!active) return;
+    record.levelUps.push_back({static_cast<std::uint32_t>(elapsedMs), static_cast<std::uint32_t>(level)});
+}
+
+/**
+ * @brief Retire la dernière pose (annulée en mode entraînement) et ses effacements.
+ *
+ * @param linesCleared Lignes effacées par la pose annulée.
+ * @param levelDown true si la pose avait fait changer de niveau.
+ */
+void Recorder::onUndone(int linesCleared, bool levelDown) {
+    if (!active) return;
+    if (!record.placementMs.empty()) record.placementMs.pop_back();
+    if (linesCleared > 0) {
+        record.lines -= linesCleared;
+        record.clears[std::min(linesCleared, 4) - 1]--;
+    }
+    if (levelDown && !record.levelUps.empty()) record.levelUps.pop_back();
+}
+
+/**
+ * @brief Termine la partie et retourne son enregistrement.
+ *
+ * @param score Score final.
+ * @param level Niveau final.
+ */
+GameRecord Recorder::finish(int score, int level) {
+    active = false;
+    record.durationMs = static_cast<std::uint32_t>(elapsedMs);
+    record.score = static_cast<std::uint32_t>(score);
+    record.finalLevel = static_cast<std::uint32_t>(level);
+    record.frames.count = static_cast<std::uint32_t>(frameTimes.count());
+    record.frames.meanUs = static_cast<std::uint32_t>(frameTimes.mean());
+    record.frames.p50Us = static_cast<std::uint32_t>(frameTimes.percentile(50));
+    record.frames.p99Us = static_cast<std::uint32_t>(frameTimes.percentile(99));
+    record.frames.maxUs = static_cast<std::uint32_t>(frameTimes.max());
+    return record;
+}
+
+/**
+ * @brief FNV-1a 32 bits.
+ */
+std::uint32_t checksum(const unsigned char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Ajoute un segment contenant `games` à la fin du fichier.
+ *
+ * Le fichier n'est jamais réécrit : un segment incomplet (arrêt brutal pendant
+ * l'écriture) n'a pas de SegmentTrailer valide et est ignoré par les lecteurs,
+ * y compris quand d'autres segments sont ajoutés ensuite.
+ *
+ * @param path Chemin du fichier de télémétrie.
+ * @param games Parties à écrire (au moins une).
+ * @return true si l'écriture a réussi.
+ */
+bool appendSegment(const std::string& path, const std::vector<GameRecord>& games) {
+    if (games.empty()) return true;
+
+    std::vector<ColumnData> columns;
+    columns.push_back(makeColumn<std::uint64_t>(Column::StartTime, games, [](const GameRecord& g) { return g.startTime; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::DurationMs, games, [](const GameRecord& g) { return g.durationMs; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Score, games, [](const GameRecord& g) { return g.score; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::FinalLevel, games, [](const GameRecord& g) { return g.finalLevel; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Pieces, games, [](const GameRecord& g) { return g.placementMs.size(); }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Lines, games, [](const GameRecord& g) { return g.lines; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Clears1, games, [](const GameRecord& g) { return g.clears[0]; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Clears2, games, [](const GameRecord& g) { return g.clears[1]; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Clears3, games, [](const GameRecord& g) { return g.clears[2]; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::Clears4, games, [](const GameRecord& g) { return g.clears[3]; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::MaxStackHeight, games, [](const GameRecord& g) { return g.maxStackHeight; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::FrameCount, games, [](const GameRecord& g) { return g.frames.count; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::FrameMeanUs, games, [](const GameRecord& g) { return g.frames.meanUs; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::FrameP50Us, games, [](const GameRecord& g) { return g.frames.p50Us; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::FrameP99Us, games, [](const GameRecord& g) { return g.frames.p99Us; }));
+    columns.push_back(makeColumn<std::uint32_t>(Column::FrameMaxUs, games, [](const GameRecord& g) { return g.frames.maxUs; }));
+
+    // Colonnes de longueur variable : tableau d'offsets (N+1) + valeurs concaténées
+    ColumnData placementOffsets{Column::PlacementOffsets, sizeof(std::uint64_t), {}};
+    ColumnData placements{Column::PlacementMs, sizeof(std::uint32_t), {}};
+    ColumnData levelOffsets{Column::LevelUpOffsets, sizeof(std::uint64_t), {}};
+    ColumnData levelMs{Column::LevelUpMs, sizeof(std::uint32_t), {}};
+    ColumnData levelValues{Column::LevelUpLevel, sizeof(std::uint32_t), {}};
+
+    std::uint64_t placementCount = 0, levelCount = 0;
+    for (const auto& g : games) {
+        placementOffsets.push<std::uint64_t>(placementCount);
+        levelOffsets.push<std::uint64_t>(levelCount);
+        for (auto ms : g.placementMs) placements.push<std::uint32_t>(ms);
+        for (const auto& l : g.levelUps) {
+            levelMs.push<std::uint32_t>(l.atMs);
+            levelValues.push<std::uint32_t>(l.level);
+        }
+        placementCount += g.placementMs.size();
+        levelCount += g.levelUps.size();
+    }
+    placementOffsets.push<std::uint64_t>(placementCount);
+    levelOffsets.push<std::uint64_t>(levelCount);
+
+    columns.push_back(std::move(placementOffsets));
+    columns.push_back(std::move(placements));
+    columns.push_back(std::move(levelOffsets));
+    columns.push_back(std::move(levelMs));
+    columns.push_back(std::move(levelValues));
+
+    // Placement des colonnes derrière l'en-tête, chacune alignée sur 8 octets
+    std::vector<ColumnDesc> descs;
+    std::uint64_t offset = align8(sizeof(SegmentHeader) + columns.size() * sizeof(ColumnDesc));
+    for (const auto& c : columns) {
+        descs.push_back({static_cast<std::uint16_t>(c.id), c.elementSize, 0, offset, c.count()});
+        offset = align8(offset + c.bytes.size());
+    }
+    offset += sizeof(SegmentTrailer);
+
+    SegmentHeader header{SEGMENT_MAGIC, FORMAT_VERSION, static_cast<std::uint16_t>(columns.size()),
+                         static_cast<std::uint32_t>(games.size()), 0, offset};
+
+    std::vector<unsigned char> segment(offset, 0);
+    std::memcpy(segment.data(), &header, sizeof(header));
+    std::memcpy(segment.data() + sizeof(header), descs.data(), descs.size() * sizeof(ColumnDesc));
+    for (std::size_t i = 0; i < columns.size(); i++) {
+        std::memcpy(segment.data() + descs[i].offset, columns[i].bytes.data(), columns[i].bytes.size());
+    }
+    const std::size_t payload = segment.size() - sizeof(SegmentTrailer);
+    SegmentTrailer trailer{SEGMENT_END, checksum(segment.data(), payload)};
+    std::memcpy(segment.data() + payload, &trailer, sizeof(trailer));
+
+    // Un segment tronqué par un arrêt brutal laisse parfois le fichier désaligné :
+    // on complète jusqu'à 8 octets pour que les lecteurs retrouvent le segment suivant
+    std::error_code ec;
+    std::uintmax_t existing = std::filesystem::file_size(path, ec);
+    std::size_t padding = ec ? 0 : static_cast<std::size_t>(align8(existing) - existing);
+
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) return false;
+    const char zeros[8] = {};
+    file.write(zeros, static_cast<std::streamsize>(padding));
+    file.write(reinterpret_cast<const char*>(segment.data()), static_cast<std::streamsize>(segment.size()));
+    return static_cast<bool>(file);
+}
+
+}
@@ -0,0 +1,101 @@
+#include "../includes/TelemetryReader.hpp"
+#include <algorithm>
+
+namespace telemetry {
+
+/**
+ * @brief Construit une vue sur le segment commençant à `base` (supposé valide).
+ */
+Segment::Segment(const unsigned char* b) : base(b) {}
+
+/**
+ * @brief Vérifie l'en-tête d'un segment, les bornes de toutes ses colonnes et,
+ * depuis la version 2, son SegmentTrailer.
+ *
+ * @param p Début supposé du segment.
+ * @param available Octets disponibles à partir de `p`.
+ */
+bool Segment::isValid(const unsigned char* p, std::size_t available) {
+    if (available < sizeof(SegmentHeader)) return false;
+    const auto& h = *reinterpret_cast<const SegmentHeader*>(p);
+    if (h.magic != SEGMENT_MAGIC || (h.version != FORMAT_VERSION && h.version != UNCHECKED_VERSION)) return false;
+    if (h.segmentBytes > available || h.segmentBytes % 8 != 0) return false;
+    const std::size_t trailer = h.version == FORMAT_VERSION ? sizeof(SegmentTrailer) : 0;
+    if (sizeof(SegmentHeader) + h.columnCount * sizeof(ColumnDesc) + trailer > h.segmentBytes) return false;
+
+    const auto* descs = reinterpret_cast<const ColumnDesc*>(p + sizeof(SegmentHeader));
+    for (std::uint16_t i = 0; i < h.columnCount; i++) {
+        const ColumnDesc& d = descs[i];
+        if (d.elementSize == 0 || d.offset % 8 != 0) return false;
+        if (d.offset > h.segmentBytes - trailer || d.count > (h.segmentBytes - trailer - d.offset) / d.elementSize) return false;
+    }
+
+    if (trailer == 0) return true;
+    const std::size_t payload = h.segmentBytes - trailer;
+    const auto& t = *reinterpret_cast<const SegmentTrailer*>(p + payload);
+    return t.magic == SEGMENT_END && t.checksum == checksum(p, payload);
+}
+
+/**
+ * @brief Vrai si `p` est la fin du fichier ou le début (éventuellement tronqué) d'un en-tête.
+ *
+ * Un segment complet est toujours suivi de l'un ou de l'autre ; sinon sa
+ * taille déclarée ne correspond pas à ce qui a été écrit.
+ */
+bool Segment::isBoundary(const unsigned char* p, std::size_t available) {
+    const std::size_t n = std::min(available, SEGMENT_MAGIC.size());
+    return std::equal(p, p + n, SEGMENT_MAGIC.begin());
+}
+
+/**
+ * @brief Cherche la description de la colonne `id`.
+ */
+const ColumnDesc* Segment::find(Column id) const {
+    const auto* descs = reinterpret_cast<const ColumnDesc*>(base + sizeof(SegmentHeader));
+    for (std::uint16_t i = 0; i < header().columnCount; i++) {
+        if (descs[i].id == static_cast<std::uint16_t>(id)) return &descs[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Reconstruit la partie d'indice `i` (copie ; sert à la compaction).
+ */
+GameRecord Segment::row(std::size_t i) const {
+    auto u32 = [&](Column id) -> std::uint32_t {
+        auto c = column<std::uint32_t>(id);
+        return i < c.size() ? c[i] : 0;
+    };
+
+    GameRecord g;
+    auto start = column<std::uint64_t>(Column::StartTime);
+    g.startTime = i < start.size() ? start[i] : 0;
+    g.durationMs = u32(Column::DurationMs);
+    g.score = u32(Column::Score);
+    g.finalLevel = u32(Column::FinalLevel);
+    g.lines = u32(Column::Lines);
+    g.clears = {u32(Column::Clears1), u32(Column::Clears2), u32(Column::Clears3), u32(Column::Clears4)};
+    g.maxStackHeight = u32(Column::MaxStackHeight);
+    g.frames = {u32(Column::FrameCount), u32(Column::FrameMeanUs), u32(Column::FrameP50Us),
+                u32(Column::FrameP99Us), u32(Column::FrameMaxUs)};
+
+    auto placementOffsets = column<std::uint64_t>(Column::PlacementOffsets);
+    auto placements = column<std::uint32_t>(Column::PlacementMs);
+    if (i + 1 < placementOffsets.size()) {
+        for (auto k = placementOffsets[i]; k < placementOffsets[i + 1] && k < placements.size(); k++) {
+            g.placementMs.push_back(placements[k]);
+        }
+    }
+
+    auto levelOffsets = column<std::uint64_t>(Column::LevelUpOffsets);
+    auto levelMs = column<std::uint32_t>(Column::LevelUpMs);
+    auto levels = column<std::uint32_t>(Column::LevelUpLevel);
+    if (i + 1 < levelOffsets.size()) {
+        for (auto k = levelOffsets[i]; k < levelOffsets[i + 1] && k < levelMs.size() && k < levels.size(); k++) {
+            g.levelUps.push_back({levelMs[k], levels[k]});
+        }
+    }
+    return g;
+}
+
+}
@@ -1,54 +1,25 @@
 #include "../includes/Tetromino.hpp"
 #include <SFML/Graphics.hpp>
 
-namespace {
-    /**
-     * @brief Liste des formes des Tetrominos (I, O, T, S, Z, J, L).
-     * 
-     * Chaque forme est représentée par 4 entiers (positions sur une grille 2x4).
-     * Exemple : `{1,3,5,7}` représente les coordonnées d'un Tetromino en partant du coin supérieur gauche.
-     */
-    constexpr std::array<std::array<int,4>,7> SHAPES {
-        {
-            {1,3,5,7},   ///< Forme I
-            {2,3,4,5},   ///< Forme O
-            {3,5,4,6},   ///< Forme T
-            {3,4,5,6},   ///< Forme S
-            {2,4,5,7},   ///< Forme Z
-            {2,3,5,7},   ///< Forme J
-            {3,5,4,7}    ///< Forme L
-        }
-    };
-
-    /**
-     * @brief Couleurs des 7 Tetrominos.
-     * 
-     * Ordre : Cyan, Jaune, Magenta, Vert, Rouge, Bleu, Orange.
-     */
-    std::array<sf::Color,7> COLORS {{
-        sf::Color::Cyan, sf::Color::Yellow, sf::Color::Magenta,
-        sf::Color::Green, sf::Color::Red, sf::Color::Blue, sf::Color(255,165,0)
-    }};
-}
-
 /**
- * @brief Constructeur du Tetromino.
- * 
- * Initialise la forme et la couleur en fonction du type passé en paramètre.
- * La position de départ est centrée sur `startX`.
- * 
+ * @brief Constructeur d'un tétromino du jeu standard.
+ *
  * @param t Le type du Tetromino (I, O, T, S, Z, J, L).
  * @param startX La position de départ sur l'axe X (en blocs).
  */
-Tetromino::Tetromino(TetrominoType t, int startX) : type(t) {
-    int n = static_cast<int>(t);
-    color = COLORS[n];
-    
-    // Remplir les coordonnées des 4 blocs du Tetromino
-    for (int i=0; i<4; i++) {
-        blocks[i].x = SHAPES[n][i] % 2 + startX;
-        blocks[i].y = SHAPES[n][i] / 2;
-    }
+Tetromino::Tetromino(TetrominoType t, int startX)
+    : Tetromino(PieceSet::standard()[static_cast<std::size_t>(t)], startX) {}
+
+/**
+ * @brief Constructeur d'une pièce quelconque.
+ *
+ * Place les cases de la forme, décalées de `startX` colonnes, avec sa couleur.
+ *
+ * @param s La forme (issue d'un `PieceSet`, qui doit survivre à la pièce).
+ * @param startX La position de départ sur l'axe X (en blocs).
+ */
+Tetromino::Tetromino(const PieceShape& s, int startX) : shape(&s), color(s.color) {
+    for (const auto& c : s.cells) blocks.push_back(sf::Vector2i(c.x + startX, c.y));
 }
 
 /**
@@ -65,23 +36,18 @@ void Tetromino::move(int dx, int dy) {
 }
 
 /**
- * @brief Fait pivoter le Tetromino de 90° dans le sens horaire.
- * 
- * Le pivot est le deuxième bloc du Tetromino.
- * Le Tetromino de type O ne tourne pas.
+ * @brief Fait pivoter la pièce de 90° dans le sens horaire autour de son pivot.
+ *
+ * Les décalages de l'orientation suivante sont lus dans la table de la forme.
+ * Une pièce sans pivot (le carré O) ne tourne pas.
  */
 void Tetromino::rotate() {
-    if (type == TetrominoType::O) return; // Le carré ne tourne pas
-
-    auto pivot = blocks[1];
+    if (shape->rotations == 1) return;
 
-    for (auto& b : blocks) {
-        int x = b.y - pivot.y;
-        int y = b.x - pivot.x;
-
-        b.x = pivot.x - x;
-        b.y = pivot.y + y;
-    }
+    rotation = (rotation + 1) % 4;
+    const sf::Vector2i pivot = blocks[shape->pivot];
+    const Cells& offsets = shape->offsets[rotation];
+    for (std::size_t i = 0; i < blocks.size(); i++) blocks[i] = pivot + offsets[i];
 }
 
 /**
@@ -90,7 +56,7 @@ void Tetromino::rotate() {
  * @param window La fenêtre SFML dans laquelle dessiner.
  * @param tileSize Taille d'un bloc en pixels.
  */
-void Tetromino::draw(sf::RenderWindow& window, int tileSize) {
+void Tetromino::draw(GameWindow& window, int tileSize) const {
     sf::RectangleShape block(sf::Vector2f(tileSize-1, tileSize-1));
     block.setFillColor(color);
 
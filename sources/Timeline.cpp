@@ -0,0 +1,71 @@
+#include "../includes/Timeline.hpp"
+#include <algorithm>
+
+namespace timeline {
+
+namespace {
+    /// Taille des cadres recyclés ; les tâches plus grosses passent par l'allocateur.
+    constexpr std::size_t FRAME_BYTES = 256;
+    /// Cadres libres gardés au plus par thread.
+    constexpr std::size_t MAX_FREE_FRAMES = 64;
+
+    /// Cadres libérés par ce thread, repris par ses prochaines tâches.
+    struct FramePool {
+        FramePool() { frames.reserve(MAX_FREE_FRAMES); }
+        ~FramePool() { for (void* f : frames) ::operator delete(f); }
+        std::vector<void*> frames;
+    };
+    thread_local FramePool pool;
+
+    /// Ordre du tas : l'échéance la plus proche, puis la plus ancienne mise en attente.
+    bool later(const auto& a, const auto& b) {
+        return a.due != b.due ? a.due > b.due : a.order > b.order;
+    }
+}
+
+void* Task::promise_type::operator new(std::size_t size) {
+    if (size > FRAME_BYTES) return ::operator new(size);
+    if (pool.frames.empty()) return ::operator new(FRAME_BYTES);
+    void* frame = pool.frames.back();
+    pool.frames.pop_back();
+    return frame;
+}
+
+void Task::promise_type::operator delete(void* frame, std::size_t size) noexcept {
+    if (size <= FRAME_BYTES && pool.frames.size() < MAX_FREE_FRAMES) {
+        pool.frames.push_back(frame);   // capacité réservée : n'alloue pas
+        return;
+    }
+    ::operator delete(frame);
+}
+
+/**
+ * @brief Avance d'un tick et reprend les tâches arrivées à échéance, dans l'ordre.
+ *
+ * Une tâche reprise peut en lancer d'autres : celles qui n'attendent pas
+ * s'exécutent aussitôt, les autres sont reprises à un tick suivant.
+ */
+void Timeline::advance() {
+    current++;
+    while (!waiting.empty() && waiting.front().due <= current) {
+        std::pop_heap(waiting.begin(), waiting.end(), later<Waiting, Waiting>);
+        std::coroutine_handle<> task = waiting.back().task;
+        waiting.pop_back();
+        task.resume();
+    }
+}
+
+/**
+ * @brief Abandonne toutes les tâches en attente (nouvelle partie).
+ */
+void Timeline::clear() {
+    for (auto& w : waiting) w.task.destroy();
+    waiting.clear();
+}
+
+void Timeline::schedule(Tick due, std::coroutine_handle<> task) {
+    waiting.push_back({due, scheduled++, task});
+    std::push_heap(waiting.begin(), waiting.end(), later<Waiting, Waiting>);
+}
+
+}
@@ -0,0 +1,153 @@
+#include "../includes/UndoJournal.hpp"
+#include <algorithm>
+
+namespace {
+    /// Pièce, passage de niveau, points (u16), nombre de cases, nombre de lignes.
+    constexpr std::size_t HEADER_BYTES = 6;
+    /// Taille de la pose, en tête et en queue.
+    constexpr std::size_t SIZE_BYTES = 2;
+}
+
+/**
+ * @param bytes Taille de l'anneau ; la plus grosse pose doit y tenir.
+ */
+UndoJournal::UndoJournal(std::size_t bytes)
+    : ring(bytes)
+{
+    palette.reserve(16);
+    scratch.reserve(256);
+}
+
+/**
+ * @brief Oublie toutes les poses (nouvelle partie).
+ */
+void UndoJournal::clear() {
+    head = 0;
+    used = 0;
+    count = 0;
+    palette.clear();
+}
+
+/**
+ * @brief Ajoute une pose, en oubliant les plus anciennes si l'anneau est plein.
+ *
+ * @param delta La pose à enregistrer.
+ * @param width Largeur du plateau (longueur de chaque ligne effacée).
+ */
+void UndoJournal::record(const PlacementDelta& delta, int width) {
+    // Palette bientôt pleine (plus de 256 couleurs) : on repart d'un journal vide
+    std::size_t unknown = std::count_if(delta.rowCells.begin(), delta.rowCells.end(), [&](sf::Color c) {
+        return std::find(palette.begin(), palette.end(), c) == palette.end();
+    });
+    if (palette.size() + unknown > 256) clear();
+
+    const std::size_t size = 2 * SIZE_BYTES + HEADER_BYTES + 2 * delta.cells.size()
+                           + delta.rows.size() * (1 + width);
+    if (size > ring.size()) {
+        clear();
+        return;
+    }
+
+    scratch.clear();
+    scratch.push_back(static_cast<std::uint8_t>(size));
+    scratch.push_back(static_cast<std::uint8_t>(size >> 8));
+    scratch.push_back(delta.piece);
+    scratch.push_back(delta.levelUp ? 1 : 0);
+    scratch.push_back(static_cast<std::uint8_t>(delta.score));
+    scratch.push_back(static_cast<std::uint8_t>(delta.score >> 8));
+    scratch.push_back(static_cast<std::uint8_t>(delta.cells.size()));
+    scratch.push_back(static_cast<std::uint8_t>(delta.rows.size()));
+    for (const auto& c : delta.cells) {
+        scratch.push_back(static_cast<std::uint8_t>(c.x));
+        scratch.push_back(static_cast<std::uint8_t>(c.y));
+    }
+    for (std::size_t r = 0; r < delta.rows.size(); r++) {
+        scratch.push_back(static_cast<std::uint8_t>(delta.rows[r]));
+        for (int x = 0; x < width; x++) scratch.push_back(paletteIndex(delta.rowCells[r * width + x]));
+    }
+    scratch.push_back(static_cast<std::uint8_t>(size));
+    scratch.push_back(static_cast<std::uint8_t>(size >> 8));
+
+    while (ring.size() - used < size) dropOldest();
+    write(scratch.data(), size);
+    count++;
+}
+
+/**
+ * @brief Décode et retire la pose la plus récente.
+ *
+ * @param out Reçoit la pose (ses tampons sont réutilisés).
+ * @param width Largeur du plateau lors de l'enregistrement.
+ */
+bool UndoJournal::pop(PlacementDelta& out, int width) {
+    if (count == 0) return false;
+
+    std::uint8_t tail[SIZE_BYTES];
+    read(head + used - SIZE_BYTES, tail, SIZE_BYTES);
+    const std::size_t size = tail[0] | tail[1] << 8;
+
+    scratch.resize(size);
+    read(head + used - size, scratch.data(), size);
+    used -= size;
+    count--;
+
+    const std::uint8_t* p = scratch.data() + SIZE_BYTES;
+    out.piece = p[0];
+    out.levelUp = p[1] != 0;
+    out.score = p[2] | p[3] << 8;
+    const int cells = p[4];
+    const int rows = p[5];
+    p += HEADER_BYTES;
+
+    out.cells.clear();
+    for (int i = 0; i < cells; i++, p += 2) out.cells.push_back(sf::Vector2i(p[0], p[1]));
+
+    out.rows.clear();
+    out.rowCells.clear();
+    for (int r = 0; r < rows; r++) {
+        out.rows.push_back(*p++);
+        for (int x = 0; x < width; x++) out.rowCells.push_back(palette[*p++]);
+    }
+    return true;
+}
+
+std::uint8_t UndoJournal::paletteIndex(sf::Color c) {
+    auto it = std::find(palette.begin(), palette.end(), c);
+    if (it != palette.end()) return static_cast<std::uint8_t>(it - palette.begin());
+    palette.push_back(c);
+    return static_cast<std::uint8_t>(palette.size() - 1);
+}
+
+/**
+ * @brief Copie `n` octets après la dernière pose (la place est libre).
+ */
+void UndoJournal::write(const std::uint8_t* data, std::size_t n) {
+    std::size_t at = (head + used) % ring.size();
+    std::size_t first = std::min(n, ring.size() - at);
+    std::copy(data, data + first, ring.begin() + at);
+    std::copy(data + first, data + n, ring.begin());
+    used += n;
+}
+
+/**
+ * @brief Lit `n` octets à partir de la position `at` (modulo la taille de l'anneau).
+ */
+void UndoJournal::read(std::size_t at, std::uint8_t* data, std::size_t n) const {
+    at %= ring.size();
+    std::size_t first = std::min(n, ring.size() - at);
+    std::copy(ring.begin() + at, ring.begin() + at + first, data);
+    std::copy(ring.begin(), ring.begin() + (n - first), data + first);
+}
+
+std::size_t UndoJournal::recordSize(std::size_t at) const {
+    std::uint8_t bytes[SIZE_BYTES];
+    read(at, bytes, SIZE_BYTES);
+    return bytes[0] | bytes[1] << 8;
+}
+
+void UndoJournal::dropOldest() {
+    std::size_t size = recordSize(head);
+    head = (head + size) % ring.size();
+    used -= size;
+    count--;
+}
@@ -1,7 +1,194 @@
 #include "../includes/Game.hpp"
+#include "../includes/SpectatorWall.hpp"
+#include <charconv>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace {
+    int usage() {
+        std::cerr << "Utilisation : tetris [--profile] [--frame-budget ms] [--perf-counters fichier.csv] [--state-feed nom]\n"
+                     "              [--telemetry fichier | --no-telemetry] [--puzzles paquet [--puzzle n]] [--pieces fichier]\n"
+                     "              [--lock-delay ticks] [--entry-delay ticks] [--clear-delay ticks]\n"
+                     "              [--wall n [--wall-frames n] [--wall-think ms]]\n"
+                     "              [--bench script [--bench-save fichier] [--bench-baseline fichier] [--bench-tolerance pourcent]]"
+                  << std::endl;
+        return 2;
+    }
+
+    /// Nombre écrit en entier dans `word` (sans espace ni suffixe).
+    template <typename T>
+    bool parseNumber(std::string_view word, T& value) {
+        auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), value);
+        return ec == std::errc() && end == word.data() + word.size();
+    }
+
+    /**
+     * @brief Mode `--bench` : joue le script, affiche les mesures, compare à la référence.
+     *
+     * @return 0 si tout va bien, 1 en cas de régression ou d'interruption, 2 si le script est invalide.
+     */
+    int runBenchmark(Game& game, const std::string& scriptPath, const std::string& baselinePath,
+                     const std::string& savePath, double tolerance) {
+        std::string error;
+        auto script = bench::Script::load(scriptPath, error);
+        if (!script) {
+            std::cerr << "[bench] " << error << std::endl;
+            return 2;
+        }
+
+        bench::Recorder recorder;
+        if (!game.runBenchmark(*script, recorder)) {
+            std::cerr << "[bench] fenetre fermee avant la fin du script" << std::endl;
+            return 1;
+        }
+
+        bench::Summary summary = recorder.summarize();
+        std::cout << "[bench] " << scriptPath << " : " << script->frameCount()
+                  << " images, graine " << script->seed << "\n";
+        bench::report(summary, std::cout);
+
+        if (!savePath.empty() && !bench::save(summary, savePath)) {
+            std::cerr << "[bench] impossible d'ecrire " << savePath << std::endl;
+            return 1;
+        }
+        if (baselinePath.empty()) return 0;
+
+        auto baseline = bench::loadBaseline(baselinePath);
+        if (!baseline) {
+            std::cerr << "[bench] reference illisible : " << baselinePath << std::endl;
+            return 1;
+        }
+        int regressions = bench::compare(summary, *baseline, tolerance, std::cout);
+        std::cout << "[bench] " << (regressions ? "ECHEC" : "OK") << " : " << regressions
+                  << " regression(s) par rapport a " << baselinePath << std::endl;
+        return regressions ? 1 : 0;
+    }
+
+    /**
+     * @brief Mode `--wall` : mur de parties de robots, sans passer par `Game`.
+     *
+     * @param frames Nombre d'images avant de quitter (0 : jusqu'à la fermeture).
+     * @param thinkMs Temps de recherche par coup des robots (0 : sans anticipation).
+     * @param perfLog Compteurs matériels par image (nul : aucun).
+     */
+    int runWall(int games, long frames, double thinkMs, const std::string& piecesPath, perf::Log* perfLog) {
+        std::optional<PieceSet> loaded;
+        if (!piecesPath.empty()) {
+            std::string error;
+            loaded = PieceSet::load(piecesPath, error);
+            if (!loaded) std::cerr << "Jeu de pieces invalide : " << error << std::endl;
+        }
+
+        SpectatorWall wall(games, static_cast<std::uint32_t>(time(nullptr)),
+                           loaded ? *loaded : PieceSet::standard(), 0, thinkMs);
+        wall.setPerfLog(perfLog);
+        wall.run(frames);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool profile = false;
+    std::string telemetry = "telemetry.bin";
+    std::string puzzles;
+    std::string pieces;
+    std::uint32_t firstPuzzle = 0;
+    std::string benchScript, benchBaseline, benchSave;
+    double benchTolerance = 0.15;
+    int wallGames = 0;
+    long wallFrames = 0;
+    double wallThink = 0.0;
+    gravity::Delays delays;
+    std::string perfPath;
+    std::string feedName;
+    double frameBudget = 1000.0 / 60.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        // Valeur de l'option : texte, ou nombre positif ou nul
+        bool ok = true;
+        auto text = [&](std::string& out) {
+            ok = i + 1 < argc;
+            if (ok) out = argv[++i];
+        };
+        auto number = [&](auto& out) {
+            ok = i + 1 < argc && parseNumber(argv[++i], out) && out >= 0;
+        };
+
+        if (arg == "--profile") profile = true;
+        else if (arg == "--telemetry") text(telemetry);
+        else if (arg == "--no-telemetry") telemetry.clear();
+        else if (arg == "--puzzles") text(puzzles);
+        else if (arg == "--puzzle") {
+            number(firstPuzzle);
+            if (ok && firstPuzzle == 0) {
+                std::cerr << "--puzzle : numero de 1 a la taille du paquet" << std::endl;
+                return 2;
+            }
+            if (ok) firstPuzzle--;
+        }
+        else if (arg == "--pieces") text(pieces);
+        else if (arg == "--bench") text(benchScript);
+        else if (arg == "--bench-baseline") text(benchBaseline);
+        else if (arg == "--bench-save") text(benchSave);
+        else if (arg == "--bench-tolerance") {
+            number(benchTolerance);
+            benchTolerance /= 100.0;
+        }
+        else if (arg == "--wall") number(wallGames);
+        else if (arg == "--wall-frames") number(wallFrames);
+        else if (arg == "--wall-think") number(wallThink);
+        else if (arg == "--lock-delay") number(delays.lock);
+        else if (arg == "--entry-delay") number(delays.entry);
+        else if (arg == "--clear-delay") number(delays.lineClear);
+        else if (arg == "--perf-counters") text(perfPath);
+        else if (arg == "--state-feed") text(feedName);
+        else if (arg == "--frame-budget") {
+            number(frameBudget);
+            if (ok && frameBudget <= 0) {
+                std::cerr << "--frame-budget : duree strictement positive (ms)" << std::endl;
+                return 2;
+            }
+        }
+        else {
+            std::cerr << "Option inconnue : " << arg << std::endl;
+            return usage();
+        }
+        if (!ok) {
+            std::cerr << "Valeur absente ou invalide pour " << arg << std::endl;
+            return usage();
+        }
+    }
+
+    if (wallGames > 0) {
+        perf::Log perfLog;
+        if (!perfPath.empty() && !perfLog.open(perfPath)) {
+            std::cerr << "[perf] impossible d'ecrire " << perfPath << std::endl;
+        }
+        return runWall(wallGames, wallFrames, wallThink, pieces, perfLog.isOpen() ? &perfLog : nullptr);
+    }
 
-int main() {
     Game game(10, 20, 30);
+    game.setProfiling(profile);
+    if (!perfPath.empty() && !game.setPerfCounters(perfPath)) {
+        std::cerr << "[perf] impossible d'ecrire " << perfPath << std::endl;
+    }
+    game.setTelemetryPath(telemetry);
+    game.setDelays(delays);
+    game.setFrameBudget(frameBudget);
+    if (!pieces.empty()) game.setPieceSet(pieces);
+    if (!feedName.empty()) game.setStateFeed(feedName);
+
+    if (!benchScript.empty()) {
+        return runBenchmark(game, benchScript, benchBaseline, benchSave, benchTolerance);
+    }
+
+    if (!puzzles.empty() && !game.setPuzzlePack(puzzles, firstPuzzle)) return 2;
+
     game.run();
     return 0;
-}
\ No newline at end of file
+}
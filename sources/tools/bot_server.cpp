@@ -0,0 +1,291 @@
+/**
+ * @file bot_server.cpp
+ * @brief Outil `tetris-server` : parties sans fenêtre pilotées par des robots (protocole de BotServer.hpp).
+ *
+ * @code
+ * tetris-server [--pieces <fichier>]              requêtes sur l'entrée standard, réponses sur la sortie
+ * tetris-server --socket <chemin> [--pieces ...]  même protocole sur une socket Unix
+ * tetris-server --check [poses] [--pieces ...]     vérifie `place` par le protocole
+ * @endcode
+ *
+ * Les requêtes sont lues par blocs et les réponses de tout un bloc partent en
+ * une seule écriture : un client qui envoie beaucoup de lignes d'un coup ne
+ * coûte que quelques appels système. Sur socket, les clients sont servis l'un
+ * après l'autre et retrouvent les parties laissées par les précédents.
+ *
+ * `--check` joue des parties par le protocole (`moves`, puis `place`), en
+ * choisissant une pose sous un surplomb dès qu'il y en a une, et compare la
+ * grille rendue par `state` aux cases demandées.
+ */
+#include "../../includes/BotServer.hpp"
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+    constexpr int WIDTH = 10;
+    constexpr int HEIGHT = 20;
+    /// Ligne de requête la plus longue acceptée (au-delà, le client est déconnecté).
+    constexpr std::size_t MAX_LINE = 64u << 20;
+
+    int usage() {
+        std::fprintf(stderr,
+            "Utilisation :\n"
+            "  tetris-server [--pieces <fichier>]\n"
+            "  tetris-server --socket <chemin> [--pieces <fichier>]\n"
+            "  tetris-server --check [poses] [--pieces <fichier>]\n");
+        return 2;
+    }
+
+    bool writeAll(int fd, std::string_view data) {
+        while (!data.empty()) {
+            ssize_t n = write(fd, data.data(), data.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            data.remove_prefix(static_cast<std::size_t>(n));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Sert un client jusqu'à la fin de son flux ou sa commande `quit`.
+     *
+     * @return false si le client a demandé `quit`.
+     */
+    bool serve(bot::Server& server, int in, int out) {
+        std::string input, output;
+        std::string buffer(1 << 16, '\0');
+
+        while (true) {
+            ssize_t n = read(in, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            input.append(buffer.data(), static_cast<std::size_t>(n));
+
+            std::size_t start = 0;
+            for (std::size_t end; (end = input.find('\n', start)) != std::string::npos; start = end + 1) {
+                if (!server.handleLine(std::string_view(input).substr(start, end - start), output)) {
+                    writeAll(out, output);
+                    return false;
+                }
+            }
+            input.erase(0, start);
+            if (input.size() > MAX_LINE) {
+                std::cerr << "[serveur] ligne trop longue, client deconnecte" << std::endl;
+                return true;
+            }
+
+            if (!writeAll(out, output)) return true;
+            output.clear();
+        }
+
+        // Dernière ligne sans retour à la ligne
+        if (!input.empty() && server.handleLine(input, output)) writeAll(out, output);
+        return true;
+    }
+
+    int serveSocket(bot::Server& server, const std::string& path) {
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Chemin de socket trop long : " << path << std::endl;
+            return 1;
+        }
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, path.size());
+
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(path.c_str());
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            listen(listener, 8) < 0) {
+            std::perror(("socket " + path).c_str());
+            return 1;
+        }
+        std::cerr << "[serveur] en attente sur " << path << std::endl;
+
+        bool running = true;
+        while (running) {
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR) continue;
+                std::perror("accept");
+                break;
+            }
+            running = serve(server, client, client);
+            close(client);
+        }
+        close(listener);
+        unlink(path.c_str());
+        return 0;
+    }
+
+    /// Réponse d'une requête, sans le retour à la ligne final.
+    std::string request(bot::Server& server, const std::string& line) {
+        std::string out;
+        server.handleLine(line, out);
+        if (!out.empty() && out.back() == '\n') out.pop_back();
+        return out;
+    }
+
+    /// Lignes de bits de la grille, lues dans la réponse de `state`.
+    std::vector<std::uint32_t> readRows(std::string_view reply) {
+        std::vector<std::uint32_t> rows;
+        std::size_t at = reply.find("rows=");
+        if (at == std::string_view::npos) return rows;
+        const char* p = reply.data() + at + 5;
+        const char* end = reply.data() + reply.size();
+        while (p < end) {
+            std::uint32_t row = 0;
+            auto [next, ec] = std::from_chars(p, end, row, 16);
+            if (ec != std::errc()) break;
+            rows.push_back(row);
+            p = next < end && *next == ',' ? next + 1 : end;
+        }
+        return rows;
+    }
+
+    /// Poses de la réponse de `moves` : cases `x,y/x,y/...` séparées par des espaces.
+    std::vector<std::vector<std::pair<int, int>>> readMoves(std::string_view reply) {
+        std::vector<std::vector<std::pair<int, int>>> moves;
+        std::size_t at = reply.find(' ', 3);   // après "ok <id>"
+        while (at != std::string_view::npos && at < reply.size()) {
+            std::size_t end = reply.find(' ', at + 1);
+            std::string_view word = reply.substr(at + 1, end == std::string_view::npos ? std::string_view::npos : end - at - 1);
+            auto& cells = moves.emplace_back();
+            const char* p = word.data();
+            const char* last = word.data() + word.size();
+            while (p < last) {
+                int x = 0, y = 0;
+                auto [comma, ec1] = std::from_chars(p, last, x);
+                auto [next, ec2] = std::from_chars(comma + 1, last, y);
+                if (ec1 != std::errc() || ec2 != std::errc()) break;
+                cells.emplace_back(x, y);
+                p = next < last ? next + 1 : last;
+            }
+            at = end;
+        }
+        return moves;
+    }
+
+    /**
+     * @brief Mode `--check` : `poses` coups joués par `place`, chacun comparé
+     * à la grille attendue (cases demandées ajoutées, lignes pleines retirées).
+     *
+     * @return 0 si toutes les poses tombent sur les cases demandées et qu'au
+     *         moins une passait sous un surplomb, 1 sinon.
+     */
+    int check(bot::Server& server, long placements) {
+        const std::uint32_t full = (1u << WIDTH) - 1;
+        std::uint64_t state = 0x9E3779B97F4A7C15ull;
+        long tucks = 0, games = 1;
+        request(server, "new 1 1");
+
+        for (long n = 0; n < placements; n++) {
+            std::string reply = request(server, "state 0");
+            if (reply.find(" over=1") != std::string::npos) {
+                request(server, "reset 0");
+                games++;
+                continue;
+            }
+            std::vector<std::uint32_t> rows = readRows(reply);
+            auto moves = readMoves(request(server, "moves 0"));
+            if (static_cast<int>(rows.size()) != HEIGHT || moves.empty()) {
+                std::fprintf(stderr, "reponse illisible : %s\n", reply.c_str());
+                return 1;
+            }
+
+            // Une pose sous un surplomb (une case occupée plus haut dans sa colonne) si possible
+            auto covered = [&](const std::vector<std::pair<int, int>>& cells) {
+                for (auto [x, y] : cells) {
+                    for (int above = 0; above < y; above++) {
+                        if (rows[above] >> x & 1u) return true;
+                    }
+                }
+                return false;
+            };
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            std::size_t index = (state >> 33) % moves.size();
+            for (std::size_t i = 0; i < moves.size(); i++) {
+                if (covered(moves[i])) {
+                    index = i;
+                    break;
+                }
+            }
+            bool tuck = covered(moves[index]);
+
+            std::vector<std::uint32_t> expected = rows;
+            for (auto [x, y] : moves[index]) {
+                if (y >= 0) expected[y] |= 1u << x;
+            }
+            std::erase(expected, full);
+            expected.insert(expected.begin(), HEIGHT - expected.size(), 0);
+
+            std::string placed = request(server, "place 0 " + std::to_string(index));
+            std::vector<std::uint32_t> after = readRows(request(server, "state 0"));
+            if (placed.rfind("ok", 0) != 0 || after != expected) {
+                std::fprintf(stderr, "DIVERGENCE pose %ld (partie %ld, pose %zu%s) : %s\n", n, games, index,
+                             tuck ? ", sous un surplomb" : "", placed.c_str());
+                for (int y = 0; y < HEIGHT; y++) {
+                    std::fprintf(stderr, "  %03x attendu %03x\n", after.size() > static_cast<std::size_t>(y) ? after[y] : 0u, expected[y]);
+                }
+                return 1;
+            }
+            tucks += tuck;
+        }
+
+        std::printf("%ld poses verifiees (%ld sous un surplomb, %ld parties)\n", placements, tucks, games);
+        if (tucks == 0) {
+            std::fprintf(stderr, "aucune pose sous un surplomb : augmenter le nombre de poses\n");
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string socketPath, piecesPath;
+    long checkPlacements = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--check") {
+            checkPlacements = 2000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                std::string_view word = argv[++i];
+                auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), checkPlacements);
+                if (ec != std::errc() || end != word.data() + word.size() || checkPlacements <= 0) return usage();
+            }
+        }
+        else if (arg == "--socket" && i + 1 < argc) socketPath = argv[++i];
+        else if (arg == "--pieces" && i + 1 < argc) piecesPath = argv[++i];
+        else return usage();
+    }
+
+    std::optional<PieceSet> pieces;
+    if (!piecesPath.empty()) {
+        std::string error;
+        pieces = PieceSet::load(piecesPath, error);
+        if (!pieces) {
+            std::cerr << "Jeu de pieces invalide : " << error << std::endl;
+            return 2;
+        }
+    }
+
+    // Un client qui se déconnecte ne doit pas arrêter le serveur
+    std::signal(SIGPIPE, SIG_IGN);
+
+    bot::Server server(WIDTH, HEIGHT, pieces ? *pieces : PieceSet::standard());
+    if (checkPlacements > 0) return check(server, checkPlacements);
+    if (!socketPath.empty()) return serveSocket(server, socketPath);
+    serve(server, STDIN_FILENO, STDOUT_FILENO);
+    return 0;
+}
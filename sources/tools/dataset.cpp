@@ -0,0 +1,146 @@
+/**
+ * @file dataset.cpp
+ * @brief Outil `tetris-dataset` : jeux de données de poses par parties de robot (voir Dataset.hpp).
+ *
+ * @code
+ * tetris-dataset write <sortie> [--samples n] [--threads t] [--seed s] [--explore p] [--pieces fichier]
+ * tetris-dataset info <fichier>    en-tête, parties, points et lignes par pose
+ * @endcode
+ */
+#include "../../includes/Dataset.hpp"
+#include "../../includes/MappedFile.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+    std::atomic<bool> interrupted{false};
+
+    int usage() {
+        std::fprintf(stderr,
+            "Utilisation :\n"
+            "  tetris-dataset write <sortie> [--samples <n>] [--threads <t>] [--seed <s>] [--explore <p>] [--pieces <fichier>]\n"
+            "  tetris-dataset info <fichier>\n");
+        return 2;
+    }
+
+    int write(const std::string& path, const dataset::Config& config, const std::string& piecesPath) {
+        std::optional<PieceSet> loaded;
+        if (!piecesPath.empty()) {
+            std::string error;
+            loaded = PieceSet::load(piecesPath, error);
+            if (!loaded) {
+                std::fprintf(stderr, "Jeu de pieces invalide : %s\n", error.c_str());
+                return 1;
+            }
+        }
+        const PieceSet& pieces = loaded ? *loaded : PieceSet::standard();
+
+        dataset::Writer writer(path, dataset::makeHeader(config, pieces), pieces);
+        if (!writer.isOpen()) {
+            std::fprintf(stderr, "Impossible d'ecrire %s\n", path.c_str());
+            return 1;
+        }
+        std::signal(SIGINT, [](int) { interrupted = true; });
+
+        // Avancement toutes les 2 s sur la sortie d'erreur
+        std::atomic<bool> finished{false};
+        std::jthread progress([&]() {
+            auto start = std::chrono::steady_clock::now();
+            while (!finished) {
+                for (int i = 0; i < 20 && !finished; i++) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (finished) break;
+                double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::fprintf(stderr, "[dataset] %llu / %llu poses (%.0f par minute)\n",
+                             static_cast<unsigned long long>(writer.records()),
+                             static_cast<unsigned long long>(config.samples), writer.records() * 60.0 / s);
+            }
+        });
+
+        dataset::Stats stats = dataset::run(config, pieces, writer, interrupted);
+        finished = true;
+        progress.join();
+
+        std::printf("[dataset] %s : %llu poses, %llu parties terminees, %.1f Mo en %.2f s sur %u thread(s) : %.0f poses par minute\n",
+                    path.c_str(), static_cast<unsigned long long>(stats.samples),
+                    static_cast<unsigned long long>(stats.games), stats.bytes / 1e6, stats.seconds, stats.threads,
+                    stats.samplesPerMinute());
+        return 0;
+    }
+
+    int info(const std::string& path) {
+        MappedFile file(path);
+        dataset::FileHeader header;
+        if (!file.isOpen() || file.size() < sizeof(header)) {
+            std::fprintf(stderr, "Fichier illisible : %s\n", path.c_str());
+            return 1;
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (header.magic != dataset::MAGIC || header.version != dataset::FORMAT_VERSION ||
+            header.recordSize != sizeof(dataset::Record) || header.headerSize > file.size()) {
+            std::fprintf(stderr, "Format inconnu : %s\n", path.c_str());
+            return 1;
+        }
+
+        std::string names;
+        for (std::size_t i = 0; i < header.pieceCount; i++) {
+            const char* name = reinterpret_cast<const char*>(file.data()) + sizeof(header) + i * dataset::NAME_SIZE;
+            if (i > 0) names += ' ';
+            std::string_view field(name, dataset::NAME_SIZE);
+            names += field.substr(0, field.find('\0'));
+        }
+
+        std::size_t count = (file.size() - header.headerSize) / header.recordSize;
+        std::uint64_t games = 0, explored = 0, reward = 0;
+        std::array<std::uint64_t, 5> clears{};
+        for (std::size_t i = 0; i < count; i++) {
+            dataset::Record r;
+            std::memcpy(&r, file.data() + header.headerSize + i * header.recordSize, sizeof(r));
+            games += (r.flags & dataset::GameOver) != 0;
+            explored += (r.flags & dataset::Explored) != 0;
+            reward += r.reward;
+            clears[std::min<std::size_t>(r.lines, 4)]++;
+        }
+
+        std::printf("[dataset] %s : plateau %ux%u, pieces %s, graine %llu\n", path.c_str(), header.width, header.height,
+                    names.c_str(), static_cast<unsigned long long>(header.seed));
+        std::printf("[dataset] %zu poses de %u octets (debut a %u), %llu parties terminees\n", count, header.recordSize,
+                    header.headerSize, static_cast<unsigned long long>(games));
+        if (count == 0) return 0;
+        std::printf("[dataset] explorees %.1f %% (demande %.1f %%), %.1f points par pose\n", 100.0 * explored / count,
+                    header.explorePermille / 10.0, static_cast<double>(reward) / count);
+        std::printf("[dataset] lignes par pose : 0 %.1f %%, 1 %.2f %%, 2 %.2f %%, 3 %.2f %%, 4 %.2f %%\n",
+                    100.0 * clears[0] / count, 100.0 * clears[1] / count, 100.0 * clears[2] / count,
+                    100.0 * clears[3] / count, 100.0 * clears[4] / count);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) return usage();
+    std::string_view mode = argv[1];
+    if (mode == "info") return info(argv[2]);
+    if (mode != "write") return usage();
+
+    dataset::Config config;
+    std::string piecesPath;
+    for (int i = 3; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--samples" && i + 1 < argc) config.samples = std::stoull(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) config.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--seed" && i + 1 < argc) config.seed = std::stoull(argv[++i]);
+        else if (arg == "--explore" && i + 1 < argc) config.explore = std::stod(argv[++i]);
+        else if (arg == "--pieces" && i + 1 < argc) piecesPath = argv[++i];
+        else return usage();
+    }
+    return write(argv[2], config, piecesPath);
+}
@@ -0,0 +1,839 @@
+/**
+ * @file fuzz.cpp
+ * @brief Outil `tetris-fuzz` : test différentiel de Board et Tetromino.
+ *
+ * Des suites d'opérations aléatoires (apparition, déplacements, rotations,
+ * chute, pose, effacement de lignes) sont jouées à la fois sur `Board`/`Tetromino`
+ * et sur un modèle de référence volontairement naïf, qui reprend la sémantique
+ * d'origine de `checkCollision`, `mergeTetromino`, `rotate` et `performClearLines`.
+ * Après chaque opération, les deux modèles sont comparés case par case.
+ *
+ * À la première divergence, la suite est réduite (suppression de blocs
+ * d'opérations tant que la divergence persiste) et affichée avec sa graine.
+ *
+ * Les deux variantes de la grille passent les mêmes suites : `Board` (taille
+ * à l'exécution) et `StandardBoard` (10 x 20 fixé à la compilation). `--bench`
+ * joue les suites sur chaque variante seule, sans modèle de référence, et
+ * compare leurs débits, puis ceux de `Simulation` sur chacune (ticks et états
+ * publiés, comme le thread de simulation du jeu).
+ *
+ * `--finesse` vérifie `MoveSearch` contre `Simulation` : des parties sont jouées
+ * en posant chaque pièce au hasard par le chemin de `path()`, et les appuis
+ * comptés par la simulation doivent égaler le minimum annoncé par la recherche.
+ * La simulation tourne sur chaque variante de la grille, avec son débit.
+ *
+ * @code
+ * tetris-fuzz [--seed S] [--sequences N] [--length L] [--threads T] [--size WxH] [--board dynamic|fixed|both]
+ * tetris-fuzz --replay <graine de suite> [--length L] [--size WxH] [--board dynamic|fixed|both]
+ * tetris-fuzz --bench [--sequences N] [--length L]
+ * tetris-fuzz --finesse [--seed S] [--sequences N] [--size WxH] [--board dynamic|fixed|both]
+ * @endcode
+ */
+#include "../../includes/Board.hpp"
+#include "../../includes/MoveSearch.hpp"
+#include "../../includes/Simulation.hpp"
+#include "../../includes/Tetromino.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // ------------------------------------------------------------------
+    // Modèle de référence (sémantique d'origine, sans aucune optimisation)
+    // ------------------------------------------------------------------
+
+    constexpr int REF_SHAPES[7][4] = {
+        {1,3,5,7}, {2,3,4,5}, {3,5,4,6}, {3,4,5,6}, {2,4,5,7}, {2,3,5,7}, {3,5,4,7}
+    };
+
+    struct RefPiece {
+        int type = 0;
+        int x[4]{}, y[4]{};
+        std::uint32_t color = 0;
+
+        void move(int dx, int dy) {
+            for (int i = 0; i < 4; i++) { x[i] += dx; y[i] += dy; }
+        }
+
+        void rotate() {
+            if (type == 1) return; // O
+            int px = x[1], py = y[1];
+            for (int i = 0; i < 4; i++) {
+                int rx = y[i] - py;
+                int ry = x[i] - px;
+                x[i] = px - rx;
+                y[i] = py + ry;
+            }
+        }
+    };
+
+    struct RefBoard {
+        int width = 0, height = 0;
+        std::vector<std::uint32_t> cells;   ///< 0 : case vide
+        std::vector<int> linesToClear;
+
+        RefBoard(int w, int h) : width(w), height(h), cells(w * h, 0) {}
+
+        std::uint32_t& at(int x, int y) { return cells[y * width + x]; }
+        std::uint32_t at(int x, int y) const { return cells[y * width + x]; }
+
+        bool collides(const RefPiece& p) const {
+            for (int i = 0; i < 4; i++) {
+                if (p.x[i] < 0 || p.x[i] >= width || p.y[i] >= height) return true;
+                if (p.y[i] >= 0 && at(p.x[i], p.y[i]) != 0) return true;
+            }
+            return false;
+        }
+
+        void merge(const RefPiece& p) {
+            for (int i = 0; i < 4; i++) {
+                if (p.y[i] >= 0 && p.y[i] < height) at(p.x[i], p.y[i]) = p.color;
+            }
+        }
+
+        void detect() {
+            linesToClear.clear();
+            for (int y = 0; y < height; y++) {
+                bool full = true;
+                for (int x = 0; x < width; x++) full = full && at(x, y) != 0;
+                if (full) linesToClear.push_back(y);
+            }
+        }
+
+        void clear() {
+            std::vector<std::uint32_t> kept;
+            int removed = 0;
+            for (int y = 0; y < height; y++) {
+                if (std::find(linesToClear.begin(), linesToClear.end(), y) != linesToClear.end()) {
+                    removed++;
+                    continue;
+                }
+                for (int x = 0; x < width; x++) kept.push_back(at(x, y));
+            }
+            std::fill(cells.begin(), cells.end(), 0);
+            std::copy(kept.begin(), kept.end(), cells.begin() + removed * width);
+            linesToClear.clear();
+        }
+    };
+
+    std::uint32_t colorKey(const sf::Color& c) {
+        return c == sf::Color::Black ? 0 : c.toInteger();
+    }
+
+    // ------------------------------------------------------------------
+    // Opérations aléatoires
+    // ------------------------------------------------------------------
+
+    enum class OpType : std::uint8_t { Spawn, Left, Right, Down, Rotate, Drop, Lock, Scatter, Probe };
+
+    struct Op {
+        OpType type;
+        std::int8_t a = 0;   ///< Spawn : type de pièce ; Scatter/Probe : dx
+        std::int8_t b = 0;   ///< Spawn : x de départ ; Scatter/Probe : dy
+        std::uint32_t c = 0; ///< Scatter : cases choisies
+    };
+
+    std::uint64_t splitmix64(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    void generate(std::uint64_t seed, int length, int width, std::vector<Op>& ops) {
+        ops.clear();
+        std::uint64_t s = seed;
+        ops.push_back({OpType::Spawn, static_cast<std::int8_t>(splitmix64(s) % 7), static_cast<std::int8_t>(width / 2), 0});
+        for (int i = 1; i < length; i++) {
+            std::uint64_t r = splitmix64(s);
+            Op op{OpType::Down};
+            switch (r % 16) {
+                case 0:  op = {OpType::Spawn, static_cast<std::int8_t>((r >> 8) % 7),
+                               static_cast<std::int8_t>(static_cast<int>((r >> 16) % (width + 4)) - 2), 0}; break;
+                case 1: case 2:  op.type = OpType::Left; break;
+                case 3: case 4:  op.type = OpType::Right; break;
+                case 5: case 6:  op.type = OpType::Down; break;
+                case 7: case 8:  op.type = OpType::Rotate; break;
+                case 9: case 10: op.type = OpType::Drop; break;
+                case 11:         op.type = OpType::Lock; break;
+                case 12: case 13: op = {OpType::Scatter, 0, 0, static_cast<std::uint32_t>(r >> 32)}; break;
+                default: op = {OpType::Probe, static_cast<std::int8_t>(static_cast<int>((r >> 8) % 7) - 3),
+                               static_cast<std::int8_t>(static_cast<int>((r >> 16) % 7) - 3), 0}; break;
+            }
+            ops.push_back(op);
+        }
+    }
+
+    std::string describe(const Op& op) {
+        switch (op.type) {
+            case OpType::Spawn:   return "spawn type=" + std::to_string(op.a) + " x=" + std::to_string(op.b);
+            case OpType::Left:    return "left";
+            case OpType::Right:   return "right";
+            case OpType::Down:    return "down";
+            case OpType::Rotate:  return "rotate";
+            case OpType::Drop:    return "drop";
+            case OpType::Lock:    return "lock";
+            case OpType::Scatter: return "scatter " + std::to_string(op.c);
+            case OpType::Probe:   return "probe dx=" + std::to_string(op.a) + " dy=" + std::to_string(op.b);
+        }
+        return "?";
+    }
+
+    // ------------------------------------------------------------------
+    // Exécution différentielle
+    // ------------------------------------------------------------------
+
+    struct Divergence {
+        std::size_t opIndex;
+        std::string what;
+    };
+
+    /// Nom d'une variante de la grille dans les messages.
+    template <class BoardT>
+    constexpr const char* boardName() { return BoardT::FIXED ? "StandardBoard" : "Board"; }
+
+    /**
+     * @brief Joue les deux modèles en parallèle et compare après chaque opération.
+     */
+    template <class BoardT>
+    class Differential {
+    public:
+        Differential(int w, int h) : width(w), height(h), emptyBoard(w, h), board(w, h), ref(w, h) {}
+
+        std::optional<Divergence> run(const std::vector<Op>& ops) {
+            board = emptyBoard;
+            ref = RefBoard(width, height);
+            piece = Tetromino(TetrominoType::I, width / 2);
+            refPiece = spawnRef(0, width / 2);
+
+            for (std::size_t i = 0; i < ops.size(); i++) {
+                boardChanged = false;
+                if (auto what = apply(ops[i])) return Divergence{i, *what};
+                if (auto what = compare()) return Divergence{i, *what};
+            }
+            return std::nullopt;
+        }
+
+        std::uint64_t operations = 0;
+
+    private:
+        RefPiece spawnRef(int type, int startX) const {
+            RefPiece p;
+            p.type = type;
+            p.color = colorKey(Tetromino(TetrominoType(type), startX).getColor());
+            for (int i = 0; i < 4; i++) {
+                p.x[i] = REF_SHAPES[type][i] % 2 + startX;
+                p.y[i] = REF_SHAPES[type][i] / 2;
+            }
+            return p;
+        }
+
+        /// Déplacement annulé en cas de collision (comme dans le jeu).
+        std::optional<std::string> tryMove(int dx, int dy) {
+            piece.move(dx, dy);
+            refPiece.move(dx, dy);
+            bool hit = board.checkCollision(piece);
+            bool refHit = ref.collides(refPiece);
+            if (hit != refHit) return "checkCollision apres deplacement";
+            if (hit) {
+                piece.move(-dx, -dy);
+                refPiece.move(-dx, -dy);
+            }
+            return std::nullopt;
+        }
+
+        std::optional<std::string> apply(const Op& op) {
+            operations++;
+            switch (op.type) {
+                case OpType::Spawn:
+                    piece = Tetromino(TetrominoType(op.a), op.b);
+                    refPiece = spawnRef(op.a, op.b);
+                    if (board.checkCollision(piece) != ref.collides(refPiece)) return "checkCollision a l'apparition";
+                    return std::nullopt;
+                case OpType::Left:  return tryMove(-1, 0);
+                case OpType::Right: return tryMove(1, 0);
+                case OpType::Down:  return tryMove(0, 1);
+                case OpType::Rotate: {
+                    Tetromino backup = piece;
+                    RefPiece refBackup = refPiece;
+                    piece.rotate();
+                    refPiece.rotate();
+                    bool hit = board.checkCollision(piece);
+                    if (hit != ref.collides(refPiece)) return "checkCollision apres rotation";
+                    if (hit) {
+                        piece = backup;
+                        refPiece = refBackup;
+                    }
+                    return std::nullopt;
+                }
+                case OpType::Drop: {
+                    if (ref.collides(refPiece)) return std::nullopt;
+                    int refDistance = 0;
+                    while (!ref.collides(refPiece)) { refPiece.move(0, 1); refDistance++; }
+                    refPiece.move(0, -1);
+                    refDistance--;
+                    int distance = board.dropDistance(piece);
+                    if (distance != refDistance) {
+                        return "dropDistance " + std::to_string(distance) + " au lieu de " + std::to_string(refDistance);
+                    }
+                    piece.move(0, distance);
+                    return std::nullopt;
+                }
+                case OpType::Lock:
+                    if (ref.collides(refPiece)) return std::nullopt; // le jeu ne pose jamais une pièce en collision
+                    board.mergeTetromino(piece);
+                    ref.merge(refPiece);
+                    return clearLines();
+                case OpType::Scatter: {
+                    // Quatre cases libres choisies dans la grille, posées comme une pièce
+                    Cells cells;
+                    std::uint64_t s = op.c;
+                    for (int i = 0; i < 4; i++) {
+                        std::uint64_t r = splitmix64(s);
+                        cells.push_back({static_cast<int>(r % width), height - 1 - static_cast<int>((r >> 16) % std::min(height, 6))});
+                    }
+                    Tetromino blob = piece;
+                    blob.setBlocks(cells);
+                    RefPiece refBlob = refPiece;
+                    for (int i = 0; i < 4; i++) { refBlob.x[i] = cells[i].x; refBlob.y[i] = cells[i].y; }
+                    if (board.checkCollision(blob) != ref.collides(refBlob)) return "checkCollision (cases libres)";
+                    if (ref.collides(refBlob)) return std::nullopt;
+                    board.mergeTetromino(blob);
+                    ref.merge(refBlob);
+                    return clearLines();
+                }
+                case OpType::Probe: {
+                    Tetromino probe = piece;
+                    probe.move(op.a, op.b);
+                    RefPiece refProbe = refPiece;
+                    refProbe.move(op.a, op.b);
+                    if (board.checkCollision(probe) != ref.collides(refProbe)) return "checkCollision (sonde)";
+                    return std::nullopt;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::optional<std::string> clearLines() {
+            boardChanged = true;
+            board.detectLinesToClear();
+            ref.detect();
+            if (board.getLinesToClear() != ref.linesToClear) return "detectLinesToClear";
+            if (board.isClearing()) {
+                board.performClearLines();
+                ref.clear();
+            }
+            return std::nullopt;
+        }
+
+        std::optional<std::string> compare() const {
+            auto blocks = piece.getBlocks();
+            for (int i = 0; i < 4; i++) {
+                if (blocks[i].x != refPiece.x[i] || blocks[i].y != refPiece.y[i]) {
+                    return "position du bloc " + std::to_string(i);
+                }
+            }
+            if (!boardChanged) return std::nullopt; // la grille n'a pas bougé depuis la dernière comparaison
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    if (colorKey(board.getCell(x, y)) != ref.at(x, y)) {
+                        return "case (" + std::to_string(x) + "," + std::to_string(y) + ")";
+                    }
+                }
+            }
+            int refStack = 0;
+            for (int y = 0; y < height && refStack == 0; y++) {
+                for (int x = 0; x < width; x++) {
+                    if (ref.at(x, y) != 0) { refStack = height - y; break; }
+                }
+            }
+            if (board.getStackHeight() != refStack) return "getStackHeight";
+            return std::nullopt;
+        }
+
+        int width, height;
+        BoardT emptyBoard;
+        BoardT board;
+        RefBoard ref;
+        Tetromino piece{TetrominoType::I, 0};
+        RefPiece refPiece;
+        bool boardChanged = false;
+    };
+
+    /**
+     * @brief Réduit une suite divergente en retirant des blocs d'opérations.
+     */
+    template <class BoardT>
+    std::vector<Op> minimize(std::vector<Op> ops, Differential<BoardT>& diff) {
+        auto failure = diff.run(ops);
+        if (!failure) return ops;
+        ops.resize(failure->opIndex + 1);
+
+        for (std::size_t chunk = ops.size() / 2; chunk >= 1; chunk /= 2) {
+            for (std::size_t start = 1; start + chunk <= ops.size();) {
+                std::vector<Op> candidate(ops.begin(), ops.begin() + start);
+                candidate.insert(candidate.end(), ops.begin() + start + chunk, ops.end());
+                if (auto f = diff.run(candidate)) {
+                    candidate.resize(f->opIndex + 1);
+                    ops = std::move(candidate);
+                } else {
+                    start += chunk;
+                }
+            }
+        }
+        return ops;
+    }
+
+    struct Options {
+        std::uint64_t seed = 1;
+        std::uint64_t sequences = 1'000'000;
+        int length = 64;
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        int width = 10;
+        int height = 20;
+        bool dynamicBoard = true;
+        bool fixedBoard = true;
+        bool bench = false;
+        bool finesse = false;
+        std::optional<std::uint64_t> replay;
+    };
+
+    std::uint64_t sequenceSeed(std::uint64_t base, std::uint64_t index) {
+        std::uint64_t s = base ^ (index * 0xD1B54A32D192ED03ull);
+        return splitmix64(s);
+    }
+
+    template <class BoardT>
+    void report(const Options& opt, std::uint64_t seqSeed, const std::vector<Op>& ops, Differential<BoardT>& diff) {
+        auto minimal = minimize(ops, diff);
+        auto failure = diff.run(minimal);
+        std::printf("DIVERGENCE %s (graine de suite %llu, plateau %dx%d)\n", boardName<BoardT>(),
+                    static_cast<unsigned long long>(seqSeed), opt.width, opt.height);
+        std::printf("reproducteur minimal (%zu operations) :\n", minimal.size());
+        for (std::size_t i = 0; i < minimal.size(); i++) {
+            std::printf("  %3zu  %s\n", i, describe(minimal[i]).c_str());
+        }
+        if (failure) std::printf("ecart apres l'operation %zu : %s\n", failure->opIndex, failure->what.c_str());
+        std::printf("rejouer : tetris-fuzz --replay %llu --length %d --size %dx%d --board %s\n",
+                    static_cast<unsigned long long>(seqSeed), opt.length, opt.width, opt.height,
+                    BoardT::FIXED ? "fixed" : "dynamic");
+    }
+
+    template <class BoardT>
+    int fuzz(const Options& opt) {
+        std::atomic<std::uint64_t> nextIndex{0};
+        std::atomic<std::uint64_t> totalOps{0};
+        std::atomic<bool> failed{false};
+        std::mutex failureMutex;
+        std::uint64_t failedSeed = 0;
+        std::vector<Op> failedOps;
+
+        constexpr std::uint64_t BATCH = 1024;
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < opt.threads; t++) {
+            workers.emplace_back([&]() {
+                Differential<BoardT> diff(opt.width, opt.height);
+                std::vector<Op> ops;
+                ops.reserve(opt.length);
+                while (!failed.load(std::memory_order_relaxed)) {
+                    std::uint64_t first = nextIndex.fetch_add(BATCH);
+                    if (first >= opt.sequences) break;
+                    std::uint64_t last = std::min(first + BATCH, opt.sequences);
+                    for (std::uint64_t i = first; i < last; i++) {
+                        std::uint64_t seqSeed = sequenceSeed(opt.seed, i);
+                        generate(seqSeed, opt.length, opt.width, ops);
+                        if (diff.run(ops)) {
+                            std::lock_guard<std::mutex> lock(failureMutex);
+                            if (!failed.exchange(true)) {
+                                failedSeed = seqSeed;
+                                failedOps = ops;
+                            }
+                            break;
+                        }
+                    }
+                }
+                totalOps += diff.operations;
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::uint64_t done = std::min<std::uint64_t>(nextIndex.load(), opt.sequences);
+        std::printf("%s : %llu suites, %llu operations en %.2f s sur %u threads : %.0f suites/s, %.0f operations/s\n",
+                    boardName<BoardT>(), static_cast<unsigned long long>(done), static_cast<unsigned long long>(totalOps.load()), seconds,
+                    opt.threads, done / seconds, totalOps.load() / seconds);
+
+        if (failed) {
+            Differential<BoardT> diff(opt.width, opt.height);
+            report(opt, failedSeed, failedOps, diff);
+            return 1;
+        }
+        std::printf("aucune divergence\n");
+        return 0;
+    }
+
+    /**
+     * @param list Affiche la suite rejouée si elle ne diverge pas.
+     */
+    template <class BoardT>
+    int replay(const Options& opt, bool list) {
+        std::vector<Op> ops;
+        generate(*opt.replay, opt.length, opt.width, ops);
+        Differential<BoardT> diff(opt.width, opt.height);
+        if (diff.run(ops)) {
+            report(opt, *opt.replay, ops, diff);
+            return 1;
+        }
+        if (list) {
+            for (std::size_t i = 0; i < ops.size(); i++) std::printf("  %3zu  %s\n", i, describe(ops[i]).c_str());
+        }
+        std::printf("%s : aucune divergence\n", boardName<BoardT>());
+        return 0;
+    }
+
+    /**
+     * @brief Joue les suites sur une variante de la grille seule, sans modèle de
+     * référence, puis copie la grille obtenue (le jeu en publie une copie à chaque tick).
+     *
+     * Les suites sont générées par lots hors chronométrage. La somme de contrôle
+     * doit être la même pour les deux variantes.
+     *
+     * @return Somme de contrôle des collisions, distances de chute et hauteurs de pile.
+     */
+    template <class BoardT>
+    std::uint64_t benchmark(const Options& opt) {
+        constexpr std::uint64_t BATCH = 1024;
+        constexpr int COPIES = 1'000'000;
+        const BoardT empty(opt.width, opt.height);
+        BoardT board = empty;
+        std::vector<std::vector<Op>> batch(BATCH);
+        std::uint64_t operations = 0, checksum = 0;
+        double seconds = 0.0;
+
+        for (std::uint64_t first = 0; first < opt.sequences; first += BATCH) {
+            std::uint64_t count = std::min(BATCH, opt.sequences - first);
+            for (std::uint64_t i = 0; i < count; i++) generate(sequenceSeed(opt.seed, first + i), opt.length, opt.width, batch[i]);
+
+            auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < count; i++) {
+                board = empty;
+                Tetromino piece(TetrominoType::I, opt.width / 2);
+                auto place = [&](const Tetromino& t) {
+                    board.mergeTetromino(t);
+                    board.detectLinesToClear();
+                    if (board.isClearing()) board.performClearLines();
+                };
+                for (const Op& op : batch[i]) {
+                    switch (op.type) {
+                        case OpType::Spawn:
+                            piece = Tetromino(TetrominoType(op.a), op.b);
+                            checksum += board.checkCollision(piece);
+                            break;
+                        case OpType::Left: case OpType::Right: case OpType::Down: {
+                            int dx = op.type == OpType::Left ? -1 : op.type == OpType::Right ? 1 : 0;
+                            int dy = op.type == OpType::Down ? 1 : 0;
+                            piece.move(dx, dy);
+                            if (board.checkCollision(piece)) piece.move(-dx, -dy);
+                            break;
+                        }
+                        case OpType::Rotate: {
+                            Tetromino backup = piece;
+                            piece.rotate();
+                            if (board.checkCollision(piece)) piece = backup;
+                            break;
+                        }
+                        case OpType::Drop:
+                            if (board.checkCollision(piece)) break;
+                            {
+                                int distance = board.dropDistance(piece);
+                                checksum += distance;
+                                piece.move(0, distance);
+                            }
+                            break;
+                        case OpType::Lock:
+                            if (!board.checkCollision(piece)) place(piece);
+                            break;
+                        case OpType::Scatter: {
+                            Cells cells;
+                            std::uint64_t r = op.c;
+                            for (int k = 0; k < 4; k++) {
+                                std::uint64_t v = splitmix64(r);
+                                cells.push_back({static_cast<int>(v % opt.width),
+                                                 opt.height - 1 - static_cast<int>((v >> 16) % std::min(opt.height, 6))});
+                            }
+                            Tetromino blob = piece;
+                            blob.setBlocks(cells);
+                            if (!board.checkCollision(blob)) place(blob);
+                            break;
+                        }
+                        case OpType::Probe: {
+                            Tetromino probe = piece;
+                            probe.move(op.a, op.b);
+                            checksum += board.checkCollision(probe);
+                            break;
+                        }
+                    }
+                }
+                checksum += board.getStackHeight();
+            }
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            operations += count * opt.length;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < COPIES; i++) {
+            BoardT copy = board;
+            checksum += copy.getCell(i % opt.width, opt.height - 1) != sf::Color::Black;
+        }
+        double copySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%-13s : %.2f M operations/s, %.2f M copies de grille/s (controle %llu)\n", boardName<BoardT>(),
+                    operations / seconds / 1e6, COPIES / copySeconds / 1e6, static_cast<unsigned long long>(checksum));
+        return checksum;
+    }
+
+    /**
+     * @brief Joue des parties sur `BasicSimulation<BoardT>` : un état publié par
+     * tick, comme `SimulationRunner`, et des coups au hasard (déplacements,
+     * rotations, chute) toutes les 8 ticks. Finesse désactivée : seule la
+     * simulation est mesurée.
+     *
+     * @return Somme de contrôle des scores et des ticks, la même pour les deux variantes.
+     */
+    template <class BoardT>
+    std::uint64_t simulate(const Options& opt) {
+        const std::uint64_t pieces = opt.sequences;
+        BasicSimulation<BoardT> sim(opt.width, opt.height, static_cast<std::uint32_t>(opt.seed));
+        BasicSnapshot<BoardT> snap(opt.width, opt.height);
+        sim.setFinesse(false);
+        std::uint64_t state = opt.seed, checksum = 0, ticks = 0, played = 0;
+        std::vector<Key> keys;
+        std::uint32_t game = 0;
+
+        sim.apply({Command::Reset, game});
+        sim.apply({Command::Resume});
+        auto start = std::chrono::steady_clock::now();
+        while (played < pieces) {
+            sim.tick();
+            sim.writeSnapshot(snap);
+            sim.clearEvents();
+            ticks++;
+            if (snap.gameOver) {
+                checksum += static_cast<std::uint64_t>(snap.score) + snap.tick;
+                sim.apply({Command::Reset, ++game});
+                sim.apply({Command::Resume});
+                continue;
+            }
+            if (snap.waiting || ticks % 8 != 0) continue;
+
+            std::uint64_t r = splitmix64(state);
+            keys.assign(r % 4, Key::Rotate);
+            keys.insert(keys.end(), (r >> 8) % (opt.width / 2 + 1), (r >> 16) & 1 ? Key::Left : Key::Right);
+            keys.push_back(Key::HardDrop);
+            sim.play(keys);
+            played++;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        checksum += static_cast<std::uint64_t>(snap.score) + snap.tick;
+
+        std::printf("%-13s : %.2f M ticks/s (simulation et etat publie), %u parties (controle %llu)\n", boardName<BoardT>(),
+                    ticks / seconds / 1e6, game + 1, static_cast<unsigned long long>(checksum));
+        return checksum;
+    }
+
+    const char* keyName(Key k) {
+        switch (k) {
+            case Key::Left: return "gauche";
+            case Key::Right: return "droite";
+            case Key::Rotate: return "rotation";
+            case Key::SoftDrop: return "bas";
+            case Key::HardDrop: return "chute";
+        }
+        return "?";
+    }
+
+    /**
+     * @brief Pose `opt.sequences` pièces, chacune à une place tirée au hasard et
+     * par le chemin de `MoveSearch::path`, et compare l'événement `Finesse` de la
+     * simulation (appuis comptés) au coût annoncé par la recherche, puis la
+     * grille obtenue aux cases de la pose (lignes pleines retirées). Les chemins
+     * avec descente rapide (glissements sous un surplomb) en font partie.
+     */
+    template <class BoardT>
+    int finesse(const Options& opt) {
+        const auto seed = static_cast<std::uint32_t>(opt.seed);
+        BasicSimulation<BoardT> sim(opt.width, opt.height, seed);
+        BasicSnapshot<BoardT> snap(opt.width, opt.height);
+        MoveSearch search(opt.width, opt.height);
+        std::uint64_t state = opt.seed;
+        std::vector<Key> keys;
+        std::vector<std::uint32_t> expectedRows;
+        const std::uint32_t fullRow = opt.width >= 32 ? ~0u : (1u << opt.width) - 1;
+        std::uint32_t game = 0;
+        std::uint64_t pieces = 0, checked = 0, tucks = 0;
+
+        sim.apply({Command::Reset, game});
+        sim.apply({Command::Resume});
+        auto start = std::chrono::steady_clock::now();
+
+        while (pieces < opt.sequences) {
+            sim.writeSnapshot(snap);
+            if (snap.gameOver) {
+                sim.apply({Command::Reset, ++game});
+                sim.apply({Command::Resume});
+                continue;
+            }
+
+            search.setBoard(snap.board);
+            const auto& placements = search.placements(snap.current);
+            keys = {Key::HardDrop};
+            int expected = -1;
+            expectedRows.clear();
+            if (!placements.empty()) {
+                const Placement& p = placements[splitmix64(state) % placements.size()];
+                keys = search.path(p);
+                expected = p.keys;
+                tucks += std::find(keys.begin(), keys.end(), Key::SoftDrop) != keys.end();
+
+                // Grille attendue : cases de la pose ajoutées, lignes pleines retirées
+                for (int y = 0; y < opt.height; y++) expectedRows.push_back(snap.board.getRowBits(y));
+                for (const auto& b : p.blocks) {
+                    if (b.y >= 0) expectedRows[b.y] |= 1u << b.x;
+                }
+                std::erase(expectedRows, fullRow);
+                expectedRows.insert(expectedRows.begin(), opt.height - expectedRows.size(), 0u);
+            }
+
+            sim.play(keys);
+            pieces++;
+            if (!expectedRows.empty()) {
+                sim.writeSnapshot(snap);
+                for (int y = 0; y < opt.height; y++) {
+                    if (snap.board.getRowBits(y) == expectedRows[y]) continue;
+                    std::printf("DIVERGENCE pose %s (graine %llu, partie %u, piece %llu) : ligne %d = %x, attendu %x\n",
+                                boardName<BoardT>(), static_cast<unsigned long long>(opt.seed), game,
+                                static_cast<unsigned long long>(pieces), y, snap.board.getRowBits(y), expectedRows[y]);
+                    std::printf("chemin :");
+                    for (Key k : keys) std::printf(" %s", keyName(k));
+                    std::printf("\n");
+                    return 1;
+                }
+            }
+            for (const auto& e : sim.events()) {
+                if (e.type != GameEvent::Type::Finesse || expected < 0) continue;
+                checked++;
+                if (e.value == expected && e.extra == expected) continue;
+
+                std::printf("DIVERGENCE finesse %s (graine %llu, partie %u, piece %llu)\n",
+                            boardName<BoardT>(), static_cast<unsigned long long>(opt.seed), game, static_cast<unsigned long long>(pieces));
+                std::printf("chemin :");
+                for (Key k : keys) std::printf(" %s", keyName(k));
+                std::printf("\nrecherche : %d appuis, simulation : %d comptes, minimum a la pose : %d\n",
+                            expected, e.value, e.extra);
+                return 1;
+            }
+            while (sim.isWaiting() && sim.isRunning()) sim.tick();
+            sim.clearEvents();
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("finesse %-13s : %llu pieces (%llu chemins verifies dont %llu avec descente, %u parties) en %.2f s, "
+                    "%.0f pieces/s, aucune divergence\n",
+                    boardName<BoardT>(), static_cast<unsigned long long>(pieces), static_cast<unsigned long long>(checked),
+                    static_cast<unsigned long long>(tucks), game + 1, seconds, pieces / seconds);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+        if (arg == "--seed") opt.seed = std::stoull(value());
+        else if (arg == "--sequences") opt.sequences = std::stoull(value());
+        else if (arg == "--length") opt.length = std::max(1, std::stoi(value()));
+        else if (arg == "--threads") opt.threads = std::max(1, std::stoi(value()));
+        else if (arg == "--replay") opt.replay = std::stoull(value());
+        else if (arg == "--bench") opt.bench = true;
+        else if (arg == "--finesse") opt.finesse = true;
+        else if (arg == "--board") {
+            std::string kind = value();
+            opt.dynamicBoard = kind == "dynamic" || kind == "both";
+            opt.fixedBoard = kind == "fixed" || kind == "both";
+            if (!opt.dynamicBoard && !opt.fixedBoard) {
+                std::fprintf(stderr, "Grille inconnue : %s (dynamic, fixed ou both)\n", kind.c_str());
+                return 2;
+            }
+        }
+        else if (arg == "--size") {
+            std::istringstream in(value());
+            char x = 0;
+            in >> opt.width >> x >> opt.height;
+            if (opt.width < 4 || opt.height < 4 || opt.width > 100 || opt.height > 100) {
+                std::fprintf(stderr, "Taille invalide (4x4 a 100x100)\n");
+                return 2;
+            }
+        } else {
+            std::fprintf(stderr, "Utilisation : tetris-fuzz [--seed S] [--sequences N] [--length L] "
+                                 "[--threads T] [--size WxH] [--board dynamic|fixed|both] [--replay GRAINE] [--bench] [--finesse]\n");
+            return 2;
+        }
+    }
+
+    // La grille fixe n'existe qu'en 10 x 20
+    if (opt.fixedBoard && (opt.width != 10 || opt.height != 20)) {
+        if (!opt.dynamicBoard) {
+            std::fprintf(stderr, "StandardBoard n'existe qu'en 10x20\n");
+            return 2;
+        }
+        opt.fixedBoard = false;
+    }
+
+    if (opt.finesse) {
+        if (opt.width > 32) {
+            std::fprintf(stderr, "--finesse : 32 colonnes au plus (lignes de bits)\n");
+            return 2;
+        }
+        int status = 0;
+        if (opt.dynamicBoard) status |= finesse<Board>(opt);
+        if (opt.fixedBoard && status == 0) status |= finesse<StandardBoard>(opt);
+        return status;
+    }
+
+    if (opt.bench) {
+        std::optional<std::uint64_t> dynamicSum, fixedSum;
+        if (opt.dynamicBoard) dynamicSum = benchmark<Board>(opt);
+        if (opt.fixedBoard) fixedSum = benchmark<StandardBoard>(opt);
+        if (dynamicSum && fixedSum && *dynamicSum != *fixedSum) {
+            std::fprintf(stderr, "Sommes de controle differentes : les deux grilles divergent\n");
+            return 1;
+        }
+
+        std::optional<std::uint64_t> dynamicSim, fixedSim;
+        if (opt.dynamicBoard) dynamicSim = simulate<Board>(opt);
+        if (opt.fixedBoard) fixedSim = simulate<StandardBoard>(opt);
+        if (dynamicSim && fixedSim && *dynamicSim != *fixedSim) {
+            std::fprintf(stderr, "Sommes de controle differentes : les deux simulations divergent\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    int status = 0;
+    if (opt.dynamicBoard) status |= opt.replay ? replay<Board>(opt, !opt.fixedBoard) : fuzz<Board>(opt);
+    if (opt.fixedBoard && status == 0) status |= opt.replay ? replay<StandardBoard>(opt, true) : fuzz<StandardBoard>(opt);
+    return status;
+}
@@ -0,0 +1,387 @@
+/**
+ * @file puzzle_pack.cpp
+ * @brief Outil `tetris-puzzles` : création, inspection et résolution des paquets de puzzles.
+ *
+ * @code
+ * tetris-puzzles generate <paquet> <nombre> [--seed S] [--pieces N] [--perfect H]
+ * tetris-puzzles info <paquet> [numéro]
+ * tetris-puzzles solve <paquet> [--pieces N] [--height H] [--threads T] [--budget ms]
+ * @endcode
+ *
+ * Chaque puzzle généré part de lignes de déchets trouées ; la suite de pièces
+ * est jouée par une recherche gloutonne (`MoveSearch`) et l'objectif est le
+ * nombre de lignes qu'elle a effacées : tout puzzle a donc une solution.
+ * Avec `--perfect H`, la grille est le début d'un remplissage au hasard des
+ * H lignes du bas (2 à H) et les pièces restantes la vident entièrement.
+ *
+ * `solve` cherche un perfect clear pour chaque puzzle avec ses pièces
+ * (`bot::PerfectClear`), rejoue chaque solution avec `MoveSearch` et affiche
+ * le débit en puzzles résolus par seconde.
+ */
+#include "../../includes/MoveSearch.hpp"
+#include "../../includes/PerfectClear.hpp"
+#include "../../includes/PuzzlePack.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr int WIDTH = 10;
+    constexpr int HEIGHT = 20;
+
+    int usage() {
+        std::fprintf(stderr,
+            "Utilisation :\n"
+            "  tetris-puzzles generate <paquet> <nombre> [--seed S] [--pieces N] [--perfect H]\n"
+            "  tetris-puzzles info <paquet> [numero]\n"
+            "  tetris-puzzles solve <paquet> [--pieces N] [--height H] [--threads T] [--budget ms]\n");
+        return 2;
+    }
+
+    /// Lignes complètes si l'on ajoute `blocks` aux lignes de bits `rows`.
+    int fullRowsWith(const std::vector<std::uint32_t>& rows, const Cells& blocks) {
+        constexpr std::uint32_t FULL = (1u << WIDTH) - 1;
+        int full = 0;
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            int y = blocks[i].y;
+            if (y < 0) continue;
+            bool seen = false;
+            for (std::size_t k = 0; k < i; k++) seen = seen || blocks[k].y == y;
+            if (seen) continue;
+
+            std::uint32_t row = rows[y];
+            for (const auto& b : blocks) if (b.y == y) row |= 1u << b.x;
+            if (row == FULL) full++;
+        }
+        return full;
+    }
+
+    std::vector<std::uint32_t> toRows(const Board& board) {
+        std::vector<std::uint32_t> rows(HEIGHT, 0);
+        for (int y = 0; y < HEIGHT; y++) rows[y] = board.getRowBits(y);
+        return rows;
+    }
+
+    /**
+     * @brief Vrai si la pose laisse les `height` lignes du bas remplissables par des
+     * tétrominos : aucune case vide sous la pièce, et chaque groupe de colonnes liées
+     * par des cases vides en compte un multiple de 4.
+     */
+    bool keepsFillable(std::vector<std::uint32_t> rows, const Cells& blocks, int height) {
+        for (const auto& b : blocks) rows[b.y] |= 1u << b.x;
+        for (const auto& b : blocks) {
+            if (b.y + 1 < HEIGHT && !(rows[b.y + 1] >> b.x & 1u)) return false;
+        }
+
+        constexpr std::uint32_t FULL = (1u << WIDTH) - 1;
+        std::uint32_t links = 0;
+        std::array<int, WIDTH> empty{};
+        for (int y = HEIGHT - height; y < HEIGHT; y++) {
+            std::uint32_t holes = ~rows[y] & FULL;
+            links |= holes & (holes >> 1);
+            for (int x = 0; x < WIDTH; x++) empty[x] += holes >> x & 1u;
+        }
+        int group = 0;
+        for (int x = 0; x < WIDTH; x++) {
+            group += empty[x];
+            if (!(links >> x & 1u)) {
+                if (group % 4 != 0) return false;
+                group = 0;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Puzzle de perfect clear : remplit au hasard les `height` lignes du bas d'une
+     * grille vide, pièce par pièce, jusqu'à les effacer toutes (poses retenues
+     * par `keepsFillable`). Chaque ligne effacée retire une ligne à la zone : le
+     * puzzle efface exactement `height` lignes.
+     *
+     * Une pièce qui ne trouve aucune place annule la pose précédente. La grille
+     * du puzzle est l'état après un nombre tiré au hasard de ces poses ; les
+     * pièces restantes ont donc une solution qui vide la grille.
+     *
+     * @return false si le remplissage reste bloqué après `MAX_FILL_STEPS` pièces.
+     */
+    bool perfectPuzzle(std::mt19937& rng, MoveSearch& search, int height,
+                       std::optional<Board>& initial, std::vector<TetrominoType>& pieces, int& lines) {
+        Board board(WIDTH, HEIGHT);
+        std::vector<Board> states{board};
+        std::vector<int> areas{height};     // Lignes encore à remplir, par état
+        std::vector<TetrominoType> played;
+        std::vector<const Placement*> inside;
+        auto cellsOf = [](const Board& b) {
+            int cells = 0;
+            for (std::uint32_t row : toRows(b)) cells += std::popcount(row);
+            return cells;
+        };
+        constexpr int MAX_FILL_STEPS = 200;
+        for (int step = 0; played.empty() || cellsOf(board) > 0; step++) {
+            if (step == MAX_FILL_STEPS) return false;
+            TetrominoType type = TetrominoType(rng() % 7);
+            Tetromino piece(type, WIDTH / 2);
+            search.setBoard(board);
+            inside.clear();
+            auto rows = toRows(board);
+            for (const auto& p : search.placements(piece)) {
+                if (std::all_of(p.blocks.begin(), p.blocks.end(), [&](const auto& b) { return b.y >= HEIGHT - areas.back(); }) &&
+                    keepsFillable(rows, p.blocks, areas.back())) {
+                    inside.push_back(&p);
+                }
+            }
+            if (inside.empty()) {
+                if (played.empty()) continue;
+                played.pop_back();
+                states.pop_back();
+                areas.pop_back();
+                board = states.back();
+                continue;
+            }
+
+            piece.setBlocks(inside[rng() % inside.size()]->blocks);
+            board.mergeTetromino(piece);
+            board.detectLinesToClear();
+            int cleared = static_cast<int>(board.getLinesToClear().size());
+            board.performClearLines();
+            played.push_back(type);
+            states.push_back(board);
+            areas.push_back(areas.back() - cleared);
+        }
+
+        std::size_t first = rng() % played.size();
+        initial = states[first];
+        pieces.assign(played.begin() + first, played.end());
+        lines = areas[first];
+        return true;
+    }
+
+    int generate(const std::string& path, long count, std::uint32_t seed, int pieceCount, int perfect) {
+        puzzle::PackWriter writer(path, WIDTH, HEIGHT);
+        if (!writer.isOpen()) {
+            std::fprintf(stderr, "Impossible de creer %s\n", path.c_str());
+            return 1;
+        }
+
+        std::mt19937 rng(seed);
+        MoveSearch search(WIDTH, HEIGHT);
+        std::vector<TetrominoType> pieces;
+        auto start = std::chrono::steady_clock::now();
+
+        for (long n = 0; n < count;) {
+            if (perfect > 0) {
+                std::optional<Board> initial;
+                int lines = 0;
+                int height = 2 + static_cast<int>(rng() % (perfect - 1));
+                if (!perfectPuzzle(rng, search, height, initial, pieces, lines)) continue;
+                writer.add(*initial, pieces, lines);
+                n++;
+                continue;
+            }
+
+            // Déchets : 3 à 8 lignes, une ou deux cases vides chacune
+            std::vector<std::uint32_t> garbage(HEIGHT, 0);
+            int garbageRows = 3 + rng() % 6;
+            for (int y = HEIGHT - garbageRows; y < HEIGHT; y++) {
+                std::uint32_t row = (1u << WIDTH) - 1;
+                row &= ~(1u << (rng() % WIDTH));
+                if (rng() % 2) row &= ~(1u << (rng() % WIDTH));
+                garbage[y] = row;
+            }
+            const Board initial(WIDTH, HEIGHT, garbage, puzzle::GARBAGE_COLOR);
+
+            pieces.clear();
+            for (int k = 0; k < pieceCount; k++) pieces.push_back(TetrominoType(rng() % 7));
+
+            // Partie gloutonne : le plus de lignes possible à chaque pièce
+            Board board = initial;
+            int lines = 0;
+            bool blocked = false;
+            for (auto type : pieces) {
+                Tetromino piece(type, WIDTH / 2);
+                if (board.checkCollision(piece)) { blocked = true; break; }
+
+                search.setBoard(board);
+                const auto& options = search.placements(piece);
+                if (options.empty()) { blocked = true; break; }
+
+                auto rows = toRows(board);
+                const Placement* best = nullptr;
+                int bestLines = -1;
+                for (const auto& p : options) {
+                    int full = fullRowsWith(rows, p.blocks);
+                    if (full > bestLines || (full == bestLines && rng() % 3 == 0)) {
+                        best = &p;
+                        bestLines = full;
+                    }
+                }
+
+                piece.setBlocks(best->blocks);
+                board.mergeTetromino(piece);
+                board.detectLinesToClear();
+                lines += board.getLinesToClear().size();
+                board.performClearLines();
+            }
+            if (blocked || lines == 0) continue;
+
+            writer.add(initial, pieces, lines);
+            n++;
+        }
+
+        if (!writer.finish()) {
+            std::fprintf(stderr, "Echec de l'ecriture de %s\n", path.c_str());
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%ld puzzles ecrits dans %s en %.1f s\n", count, path.c_str(), seconds);
+        return 0;
+    }
+
+    /// Rejoue une solution : chaque pose doit être atteignable et la grille finir vide.
+    bool replay(const puzzle::Puzzle& p, const bot::ClearResult& result, MoveSearch& search) {
+        Board board = p.board;
+        for (std::size_t k = 0; k < result.placements.size(); k++) {
+            Tetromino piece(p.pieces[k], board.getWidth() / 2);
+            search.setBoard(board);
+            if (search.keysFor(piece, result.placements[k]) < 0) return false;
+            piece.setBlocks(result.placements[k]);
+            board.mergeTetromino(piece);
+            board.detectLinesToClear();
+            board.performClearLines();
+        }
+        for (int y = 0; y < board.getHeight(); y++) {
+            for (int x = 0; x < board.getWidth(); x++) {
+                if (board.getCell(x, y) != sf::Color::Black) return false;
+            }
+        }
+        return true;
+    }
+
+    int solve(const std::string& path, const bot::ClearConfig& config) {
+        puzzle::Pack pack(path);
+        if (!pack.isValid()) {
+            std::fprintf(stderr, "Paquet invalide : %s\n", path.c_str());
+            return 1;
+        }
+        if (pack.getWidth() > bot::PerfectClear::MAX_WIDTH) {
+            std::fprintf(stderr, "Plateau trop large pour le solveur (%d colonnes au plus)\n", bot::PerfectClear::MAX_WIDTH);
+            return 1;
+        }
+
+        bot::PerfectClear solver(pack.getWidth(), pack.getHeight(), PieceSet::standard(), config);
+        MoveSearch search(pack.getWidth(), pack.getHeight());
+        std::uint32_t found = 0, timedOut = 0, invalid = 0, unreadable = 0;
+        std::uint64_t nodes = 0, memoHits = 0, pruned = 0, placed = 0;
+        double solveMs = 0.0, worstMs = 0.0;
+        std::vector<PieceId> sequence;
+
+        for (std::uint32_t i = 0; i < pack.size(); i++) {
+            auto p = pack.load(i);
+            if (!p) { unreadable++; continue; }
+            sequence.clear();
+            for (auto t : p->pieces) sequence.push_back(static_cast<PieceId>(t));
+
+            bot::ClearResult r = solver.solve(p->board, sequence);
+            solveMs += r.ms;
+            worstMs = std::max(worstMs, r.ms);
+            nodes += r.nodes;
+            memoHits += r.memoHits;
+            pruned += r.pruned;
+            timedOut += r.timedOut;
+            if (!r.found) continue;
+            found++;
+            placed += r.placements.size();
+            if (!replay(*p, r, search)) invalid++;
+        }
+
+        std::uint32_t total = pack.size() - unreadable;
+        std::printf("%s : %u puzzles, perfect clear pour %u (%.1f pieces en moyenne), sans solution %u, budget epuise %u\n",
+                    path.c_str(), total, found, found ? static_cast<double>(placed) / found : 0.0,
+                    total - found - timedOut, timedOut);
+        std::printf("%.1f ms en tout, %.0f puzzles/s (pire %.2f ms), %.2f M grilles/s, cache %llu, coupures %llu\n",
+                    solveMs, solveMs > 0.0 ? total * 1000.0 / solveMs : 0.0, worstMs,
+                    solveMs > 0.0 ? nodes / solveMs / 1000.0 : 0.0,
+                    static_cast<unsigned long long>(memoHits), static_cast<unsigned long long>(pruned));
+        if (invalid || unreadable) {
+            std::fprintf(stderr, "%u solution(s) invalide(s), %u puzzle(s) illisible(s)\n", invalid, unreadable);
+            return 1;
+        }
+        return 0;
+    }
+
+    int info(const std::string& path, long number) {
+        auto start = std::chrono::steady_clock::now();
+        puzzle::Pack pack(path);
+        double openUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (!pack.isValid()) {
+            std::fprintf(stderr, "Paquet invalide : %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("%s : %u puzzles %dx%d (ouvert en %.0f us)\n",
+                    path.c_str(), pack.size(), pack.getWidth(), pack.getHeight(), openUs);
+        if (number <= 0) return 0;
+
+        auto p = pack.load(static_cast<std::uint32_t>(number - 1));
+        if (!p) {
+            std::fprintf(stderr, "Puzzle %ld absent ou illisible\n", number);
+            return 1;
+        }
+
+        static const char NAMES[] = "IOTSZJL";
+        std::printf("puzzle %ld : effacer %d ligne(s) avec ", number, p->goalLines);
+        for (auto t : p->pieces) std::printf("%c", NAMES[static_cast<int>(t)]);
+        std::printf("\n");
+        for (int y = 0; y < pack.getHeight(); y++) {
+            std::printf("  |");
+            for (int x = 0; x < pack.getWidth(); x++) {
+                std::printf("%c", p->board.getCell(x, y) != sf::Color::Black ? '#' : '.');
+            }
+            std::printf("|\n");
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) return usage();
+    std::string command = argv[1];
+
+    if (command == "generate" && argc >= 4) {
+        std::uint32_t seed = 1;
+        int pieceCount = 5;
+        int perfect = 0;
+        for (int i = 4; i + 1 < argc; i += 2) {
+            std::string opt = argv[i];
+            if (opt == "--seed") seed = static_cast<std::uint32_t>(std::stoul(argv[i + 1]));
+            else if (opt == "--pieces") pieceCount = std::max(1, std::min(1000, std::stoi(argv[i + 1])));
+            else if (opt == "--perfect") perfect = std::clamp(std::stoi(argv[i + 1]), 2, bot::PerfectClear::MAX_HEIGHT);
+            else return usage();
+        }
+        return generate(argv[2], std::stol(argv[3]), seed, pieceCount, perfect);
+    }
+    if (command == "solve") {
+        bot::ClearConfig config;
+        config.maxPieces = 1000;
+        config.maxHeight = bot::PerfectClear::MAX_HEIGHT;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string opt = argv[i];
+            if (opt == "--pieces") config.maxPieces = std::max(1, std::stoi(argv[i + 1]));
+            else if (opt == "--height") config.maxHeight = std::stoi(argv[i + 1]);
+            else if (opt == "--threads") config.threads = static_cast<unsigned>(std::stoul(argv[i + 1]));
+            else if (opt == "--budget") config.budgetMs = std::stod(argv[i + 1]);
+            else return usage();
+        }
+        return solve(argv[2], config);
+    }
+    if (command == "info") {
+        return info(argv[2], argc >= 4 ? std::stol(argv[3]) : 0);
+    }
+    return usage();
+}
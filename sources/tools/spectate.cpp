@@ -0,0 +1,293 @@
+/**
+ * @file spectate.cpp
+ * @brief Outil `tetris-spectate` : diffusion d'une partie en direct aux spectateurs (protocole de Spectate.hpp).
+ *
+ * @code
+ * tetris-spectate serve [--port 7777] [--feed <nom> | --bot [graine]]   serveur (epoll, un thread)
+ * tetris-spectate watch [--port 7777] [--board]                          un spectateur en mode texte
+ * tetris-spectate load <n> [--port 7777] [--seconds 10]                  n spectateurs pour mesurer le serveur
+ * @endcode
+ *
+ * Le serveur diffuse soit la partie d'un jeu lancé avec `--state-feed <nom>`,
+ * soit sa propre partie jouée par un robot (sans fenêtre).
+ */
+#include "../../includes/Autoplayer.hpp"
+#include "../../includes/SpectateServer.hpp"
+#include "../../includes/StateFeedReader.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+    constexpr int WIDTH = 10;
+    constexpr int HEIGHT = 20;
+    /// Ticks entre deux coups du robot de démonstration.
+    constexpr int BOT_EVERY = 8;
+    /// Écran de fin du robot avant la partie suivante (2 s).
+    constexpr int RESTART_TICKS = 2 * gravity::TICKS_PER_SECOND;
+
+    int usage() {
+        std::fprintf(stderr,
+            "Utilisation :\n"
+            "  tetris-spectate serve [--port <p>] [--feed <nom> | --bot [graine]]\n"
+            "  tetris-spectate watch [--port <p>] [--board]\n"
+            "  tetris-spectate load <n> [--port <p>] [--seconds <s>]\n");
+        return 2;
+    }
+
+    /// Socket connectée à 127.0.0.1:port (-1 en cas d'échec).
+    int connectLocal(std::uint16_t port, bool blocking) {
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC | (blocking ? 0 : SOCK_NONBLOCK), 0);
+        if (fd < 0) return -1;
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 && errno != EINPROGRESS) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int serve(std::uint16_t port, const std::string& feedName, std::uint32_t seed) {
+        spectate::Server server(WIDTH, HEIGHT, port);
+        if (!server.isOpen()) {
+            std::fprintf(stderr, "Port %u indisponible : %s\n", port, server.error().c_str());
+            return 1;
+        }
+        std::signal(SIGINT, [](int) { spectate::Server::requestStop(); });
+        std::signal(SIGTERM, [](int) { spectate::Server::requestStop(); });
+
+        if (!feedName.empty()) {
+            // Partie d'un jeu lancé avec --state-feed : seul le dernier état compte
+            feed::Reader reader(feedName);
+            if (!reader.isOpen()) {
+                std::fprintf(stderr, "Flux %s illisible : %s\n", feedName.c_str(), reader.error().c_str());
+                return 1;
+            }
+            if (static_cast<int>(reader.info().width) != WIDTH || static_cast<int>(reader.info().height) != HEIGHT) {
+                std::fprintf(stderr, "Plateau %ux%u non pris en charge\n", reader.info().width, reader.info().height);
+                return 1;
+            }
+            std::clog << "[spectate] 127.0.0.1:" << port << ", partie du flux " << feedName << std::endl;
+            server.run(2.0 * gravity::TICKS_PER_SECOND, [&](feed::Record& state) {
+                bool updated = false;
+                feed::Reader::Status status;
+                while ((status = reader.next(state)) == feed::Reader::Status::Record) updated = true;
+                if (status == feed::Reader::Status::Closed) return spectate::Server::Source::Stop;
+                return updated ? spectate::Server::Source::Updated : spectate::Server::Source::Idle;
+            });
+        } else {
+            // Partie de démonstration jouée par le robot, au rythme du jeu
+            Simulation sim(WIDTH, HEIGHT, seed);
+            Autoplayer bot(WIDTH, HEIGHT);
+            GameSnapshot snap(WIDTH, HEIGHT);
+            std::uint32_t gameId = 0;
+            int countdown = BOT_EVERY, overTicks = 0;
+            sim.apply({Command::Resume});
+            sim.writeSnapshot(snap);
+
+            std::clog << "[spectate] 127.0.0.1:" << port << ", partie du robot (graine " << seed << ")" << std::endl;
+            server.run(gravity::TICKS_PER_SECOND, [&](feed::Record& state) {
+                if (snap.gameOver) {
+                    if (++overTicks >= RESTART_TICKS) {
+                        overTicks = 0;
+                        sim.apply({Command::Reset, ++gameId});
+                        sim.apply({Command::Resume});
+                    }
+                } else if (--countdown <= 0) {
+                    bot.play(sim, snap);
+                    countdown = BOT_EVERY;
+                }
+                sim.tick();
+                sim.clearEvents();
+                sim.writeSnapshot(snap);
+                feed::capture(state, snap);
+                return spectate::Server::Source::Updated;
+            });
+        }
+
+        server.report(std::clog);
+        return 0;
+    }
+
+    /// Plateau en texte : '#' pile, '@' pièce courante, '.' vide.
+    void printBoard(const spectate::Decoder& d) {
+        const feed::Record& r = d.state();
+        std::string line;
+        for (int y = 0; y < d.height(); y++) {
+            line.assign(d.width(), '.');
+            for (int x = 0; x < d.width(); x++) {
+                if (r.rows[y] & (1u << x)) line[x] = '#';
+            }
+            for (int i = 0; i < r.current.cellCount; i++) {
+                int x = r.current.cells[2 * i], cy = r.current.cells[2 * i + 1];
+                if (cy == y && x >= 0 && x < d.width()) line[x] = '@';
+            }
+            std::printf("  %s\n", line.c_str());
+        }
+    }
+
+    int watch(std::uint16_t port, bool board) {
+        int fd = connectLocal(port, true);
+        if (fd < 0) {
+            std::fprintf(stderr, "Connexion a 127.0.0.1:%u impossible : %s\n", port, std::strerror(errno));
+            return 1;
+        }
+
+        spectate::Decoder decoder;
+        feed::Record last{};
+        bool first = true;
+        std::uint64_t bytes = 0;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            bytes += static_cast<std::uint64_t>(n);
+            if (!decoder.receive(buffer, static_cast<std::size_t>(n))) {
+                std::fprintf(stderr, "Flux invalide\n");
+                break;
+            }
+            if (!decoder.ready()) continue;
+
+            const feed::Record& r = decoder.state();
+            if (first || r.gameId != last.gameId || r.score != last.score || r.level != last.level || r.lines != last.lines
+                || (r.flags & feed::GameOver) != (last.flags & feed::GameOver)) {
+                std::printf("[watch] tick %llu partie %u : score %u niveau %u lignes %u%s\n",
+                            static_cast<unsigned long long>(r.tick), r.gameId, r.score, r.level, r.lines,
+                            (r.flags & feed::GameOver) ? " FIN" : "");
+                if (board) printBoard(decoder);
+                std::fflush(stdout);
+            }
+            last = r;
+            first = false;
+        }
+        ::close(fd);
+        std::printf("[watch] %llu octets, %llu messages\n", static_cast<unsigned long long>(bytes),
+                    static_cast<unsigned long long>(decoder.messages()));
+        return 0;
+    }
+
+    /**
+     * @brief Mesure du serveur : `count` spectateurs dans ce processus, sur une seule instance epoll.
+     *
+     * Vérifie aussi que tous les spectateurs arrivés au même tick ont reconstruit le même état.
+     */
+    int load(int count, std::uint16_t port, double seconds) {
+        struct Viewer {
+            int fd = -1;
+            spectate::Decoder decoder;
+            std::uint64_t bytes = 0;
+            bool failed = false;
+        };
+
+        int ep = ::epoll_create1(EPOLL_CLOEXEC);
+        std::vector<Viewer> viewers(static_cast<std::size_t>(count));
+        for (auto& v : viewers) {
+            v.fd = connectLocal(port, false);
+            if (v.fd < 0) {
+                std::fprintf(stderr, "Connexion a 127.0.0.1:%u impossible : %s\n", port, std::strerror(errno));
+                return 1;
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = &v;
+            ::epoll_ctl(ep, EPOLL_CTL_ADD, v.fd, &ev);
+        }
+
+        using Clock = std::chrono::steady_clock;
+        const auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        std::vector<epoll_event> events(viewers.size());
+        char buffer[16384];
+        while (Clock::now() < end) {
+            int n = ::epoll_wait(ep, events.data(), static_cast<int>(events.size()), 100);
+            for (int i = 0; i < n; i++) {
+                Viewer& v = *static_cast<Viewer*>(events[i].data.ptr);
+                ssize_t r = ::recv(v.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+                if (r > 0) {
+                    v.bytes += static_cast<std::uint64_t>(r);
+                    if (!v.decoder.receive(buffer, static_cast<std::size_t>(r))) v.failed = true;
+                } else if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    v.failed = true;
+                    ::epoll_ctl(ep, EPOLL_CTL_DEL, v.fd, nullptr);
+                }
+            }
+        }
+
+        // Même tick, même état : un delta mal appliqué se verrait ici
+        std::map<std::uint64_t, const feed::Record*> reference;
+        int ready = 0, failed = 0, disagree = 0;
+        std::uint64_t bytes = 0;
+        for (const auto& v : viewers) {
+            bytes += v.bytes;
+            if (v.failed) failed++;
+            if (!v.decoder.ready()) continue;
+            ready++;
+            const feed::Record& s = v.decoder.state();
+            auto [it, inserted] = reference.try_emplace(s.tick, &s);
+            if (!inserted) {
+                const feed::Record& o = *it->second;
+                if (o.score != s.score || o.lines != s.lines || o.flags != s.flags || o.rows != s.rows
+                    || std::memcmp(&o.current, &s.current, sizeof(s.current)) != 0) {
+                    disagree++;
+                }
+            }
+        }
+        for (auto& v : viewers) ::close(v.fd);
+        ::close(ep);
+
+        std::printf("[load] %d spectateurs, %d a jour, %d en echec, %d en desaccord ; %.1f o/s par spectateur\n",
+                    count, ready, failed, disagree, count ? bytes / seconds / count : 0.0);
+        return failed || disagree ? 1 : 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) return usage();
+    std::string_view mode = argv[1];
+
+    std::uint16_t port = spectate::DEFAULT_PORT;
+    std::string feedName;
+    std::uint32_t seed = 1;
+    bool board = false;
+    double seconds = 10.0;
+    int first = 2;
+    int count = 0;
+    if (mode == "load") {
+        if (argc < 3) return usage();
+        count = std::stoi(argv[2]);
+        first = 3;
+    }
+    for (int i = first; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) port = static_cast<std::uint16_t>(std::stoi(argv[++i]));
+        else if (arg == "--feed" && i + 1 < argc) feedName = argv[++i];
+        else if (arg == "--bot") {
+            if (i + 1 < argc && argv[i + 1][0] != '-') seed = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--board") board = true;
+        else if (arg == "--seconds" && i + 1 < argc) seconds = std::stod(argv[++i]);
+        else return usage();
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+    if (mode == "serve") return serve(port, feedName, seed);
+    if (mode == "watch") return watch(port, board);
+    if (mode == "load" && count > 0) return load(count, port, seconds);
+    return usage();
+}
@@ -0,0 +1,89 @@
+/**
+ * @file state_feed.cpp
+ * @brief Outil `tetris-feed` : suit le flux d'état d'une partie en cours (voir StateFeed.hpp).
+ *
+ * @code
+ * tetris-feed <nom> [--board]     une ligne à chaque changement de score, de niveau ou de partie
+ * @endcode
+ *
+ * Exemple de lecteur : il ne fait que lire le segment partagé, et attend
+ * quelques millisecondes quand il n'y a rien de nouveau. S'arrête à la
+ * fermeture du jeu (ou sur Ctrl+C) avec le nombre d'enregistrements reçus et perdus.
+ */
+#include "../../includes/StateFeedReader.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+    std::atomic<bool> interrupted{false};
+
+    int usage() {
+        std::fprintf(stderr, "Utilisation : tetris-feed <nom> [--board]\n");
+        return 2;
+    }
+
+    /// Plateau en texte : '#' pile, '@' pièce courante, '.' vide.
+    void printBoard(const feed::Record& r, const feed::Header& info) {
+        std::string line;
+        for (std::uint32_t y = 0; y < info.height; y++) {
+            line.assign(info.width, '.');
+            for (std::uint32_t x = 0; x < info.width; x++) {
+                if (r.rows[y] & (1u << x)) line[x] = '#';
+            }
+            for (int i = 0; i < r.current.cellCount; i++) {
+                int x = r.current.cells[2 * i], cy = r.current.cells[2 * i + 1];
+                if (cy == static_cast<int>(y) && x >= 0 && x < static_cast<int>(info.width)) line[x] = '@';
+            }
+            std::printf("  %s\n", line.c_str());
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) return usage();
+    bool board = argc >= 3 && std::string_view(argv[2]) == "--board";
+
+    feed::Reader reader(argv[1]);
+    if (!reader.isOpen()) {
+        std::fprintf(stderr, "Flux %s illisible : %s\n", argv[1], reader.error().c_str());
+        return 1;
+    }
+    const feed::Header& info = reader.info();
+    std::printf("[feed] %s : plateau %ux%u, ecrivain pid %u\n", argv[1], info.width, info.height, info.producer);
+
+    std::signal(SIGINT, [](int) { interrupted = true; });
+
+    feed::Record r;
+    feed::Record last{};
+    bool first = true;
+    while (!interrupted) {
+        feed::Reader::Status status = reader.next(r);
+        if (status == feed::Reader::Status::Closed) break;
+        if (status == feed::Reader::Status::Empty) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        bool changed = first || r.gameId != last.gameId || r.score != last.score || r.level != last.level
+                    || r.lines != last.lines || (r.flags & feed::GameOver) != (last.flags & feed::GameOver);
+        if (changed) {
+            std::printf("[feed] tick %llu partie %u : score %u niveau %u lignes %u%s (tick %u us, retard max %u us)\n",
+                        static_cast<unsigned long long>(r.tick), r.gameId, r.score, r.level, r.lines,
+                        (r.flags & feed::GameOver) ? " FIN" : "", r.lastBusyUs, r.maxLateUs);
+            if (board) printBoard(r, info);
+            std::fflush(stdout);
+        }
+        last = r;
+        first = false;
+    }
+
+    std::printf("[feed] %llu enregistrement(s) recu(s), %llu perdu(s)\n",
+                static_cast<unsigned long long>(reader.received()), static_cast<unsigned long long>(reader.missed()));
+    return 0;
+}
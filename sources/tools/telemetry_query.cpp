@@ -0,0 +1,271 @@
+/**
+ * @file telemetry_query.cpp
+ * @brief Outil `tetris-telemetry` : agrège les fichiers de télémétrie des parties.
+ *
+ * @code
+ * tetris-telemetry summary <fichier>...           distributions sur toutes les parties
+ * tetris-telemetry compact <sortie> <fichier>...  regroupe les parties en gros segments
+ * tetris-telemetry check <fichier>                 vérifie la reprise après un segment tronqué
+ * @endcode
+ *
+ * Les fichiers sont lus par mmap et seules les colonnes utiles sont parcourues.
+ */
+#include "../../includes/TelemetryReader.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace telemetry;
+
+namespace {
+    /// Niveaux suivis pour le temps moyen d'accès à chaque niveau.
+    constexpr std::size_t TRACKED_LEVELS = 30;
+    /// Taille des segments produits par `compact`.
+    constexpr std::size_t COMPACT_ROWS = 65536;
+
+    struct Summary {
+        std::uint64_t games = 0;
+        std::uint64_t segments = 0;
+        std::uint64_t bytes = 0;
+        Histogram durationS{10.0, 720};          // tranches de 10 s jusqu'à 2 h
+        Histogram score{100.0, 2000};
+        Histogram finalLevel{1.0, 64};
+        Histogram piecesPerSecond{0.05, 400};
+        Histogram maxStack{1.0, 64};
+        Histogram placementIntervalMs{10.0, 1000};
+        Histogram frameP99Ms{0.25, 400};
+        Histogram frameMaxMs{1.0, 1000};
+        std::array<std::uint64_t, 4> clears{};
+        std::array<double, TRACKED_LEVELS> levelReachSum{};
+        std::array<std::uint64_t, TRACKED_LEVELS> levelReachCount{};
+    };
+
+    void accumulate(Summary& s, const Segment& seg) {
+        auto duration = seg.column<std::uint32_t>(Column::DurationMs);
+        auto score = seg.column<std::uint32_t>(Column::Score);
+        auto level = seg.column<std::uint32_t>(Column::FinalLevel);
+        auto pieces = seg.column<std::uint32_t>(Column::Pieces);
+        auto stack = seg.column<std::uint32_t>(Column::MaxStackHeight);
+        auto p99 = seg.column<std::uint32_t>(Column::FrameP99Us);
+        auto fmax = seg.column<std::uint32_t>(Column::FrameMaxUs);
+        std::array<std::span<const std::uint32_t>, 4> clears {
+            seg.column<std::uint32_t>(Column::Clears1), seg.column<std::uint32_t>(Column::Clears2),
+            seg.column<std::uint32_t>(Column::Clears3), seg.column<std::uint32_t>(Column::Clears4)};
+
+        s.games += seg.rows();
+        s.segments++;
+        for (auto v : duration) s.durationS.add(v / 1000.0);
+        for (auto v : score) s.score.add(v);
+        for (auto v : level) s.finalLevel.add(v);
+        for (auto v : stack) s.maxStack.add(v);
+        for (auto v : p99) s.frameP99Ms.add(v / 1000.0);
+        for (auto v : fmax) s.frameMaxMs.add(v / 1000.0);
+        for (std::size_t i = 0; i < pieces.size() && i < duration.size(); i++) {
+            if (duration[i] > 0) s.piecesPerSecond.add(pieces[i] * 1000.0 / duration[i]);
+        }
+        for (std::size_t k = 0; k < 4; k++) {
+            for (auto v : clears[k]) s.clears[k] += v;
+        }
+
+        // Intervalles entre deux poses successives d'une même partie
+        auto offsets = seg.column<std::uint64_t>(Column::PlacementOffsets);
+        auto placements = seg.column<std::uint32_t>(Column::PlacementMs);
+        for (std::size_t g = 0; g + 1 < offsets.size(); g++) {
+            for (auto k = offsets[g] + 1; k < offsets[g + 1] && k < placements.size(); k++) {
+                s.placementIntervalMs.add(placements[k] - placements[k - 1]);
+            }
+        }
+
+        auto levelMs = seg.column<std::uint32_t>(Column::LevelUpMs);
+        auto levels = seg.column<std::uint32_t>(Column::LevelUpLevel);
+        for (std::size_t k = 0; k < levelMs.size() && k < levels.size(); k++) {
+            if (levels[k] < TRACKED_LEVELS) {
+                s.levelReachSum[levels[k]] += levelMs[k] / 1000.0;
+                s.levelReachCount[levels[k]]++;
+            }
+        }
+    }
+
+    void printDistribution(const char* label, const Histogram& h) {
+        std::printf("%-28s p50 %9.2f   p95 %9.2f   p99 %9.2f   max %9.2f   moy %9.2f\n",
+                    label, h.percentile(50), h.percentile(95), h.percentile(99), h.max(), h.mean());
+    }
+
+    int summary(const std::vector<std::string>& paths) {
+        auto start = std::chrono::steady_clock::now();
+        Summary s;
+        for (const auto& path : paths) {
+            SegmentFile file(path);
+            if (!file.isOpen()) {
+                std::cerr << "Impossible d'ouvrir " << path << '\n';
+                return 1;
+            }
+            s.bytes += file.size();
+            file.forEachSegment([&](const Segment& seg) { accumulate(s, seg); });
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("parties : %llu   segments : %llu   octets : %llu\n",
+                    static_cast<unsigned long long>(s.games), static_cast<unsigned long long>(s.segments),
+                    static_cast<unsigned long long>(s.bytes));
+        std::printf("analyse : %.3f s (%.0f parties/s)\n\n", seconds, seconds > 0 ? s.games / seconds : 0.0);
+        if (s.games == 0) return 0;
+
+        printDistribution("duree (s)", s.durationS);
+        printDistribution("score", s.score);
+        printDistribution("niveau final", s.finalLevel);
+        printDistribution("pieces par seconde", s.piecesPerSecond);
+        printDistribution("intervalle entre poses (ms)", s.placementIntervalMs);
+        printDistribution("hauteur max de pile", s.maxStack);
+        printDistribution("image p99 par partie (ms)", s.frameP99Ms);
+        printDistribution("image max par partie (ms)", s.frameMaxMs);
+
+        std::uint64_t totalClears = s.clears[0] + s.clears[1] + s.clears[2] + s.clears[3];
+        std::printf("\neffacements :");
+        for (std::size_t k = 0; k < 4; k++) {
+            std::printf("   %zu ligne(s) %llu (%.1f%%)", k + 1, static_cast<unsigned long long>(s.clears[k]),
+                        totalClears ? 100.0 * s.clears[k] / totalClears : 0.0);
+        }
+        std::printf("\n\ntemps moyen pour atteindre un niveau :\n");
+        for (std::size_t l = 0; l < TRACKED_LEVELS; l++) {
+            if (s.levelReachCount[l] == 0) continue;
+            std::printf("  niveau %2zu : %8.1f s   (%llu parties)\n", l, s.levelReachSum[l] / s.levelReachCount[l],
+                        static_cast<unsigned long long>(s.levelReachCount[l]));
+        }
+        return 0;
+    }
+
+    int compact(const std::string& output, const std::vector<std::string>& paths) {
+        std::vector<GameRecord> batch;
+        batch.reserve(COMPACT_ROWS);
+        std::uint64_t games = 0;
+        bool ok = true;
+
+        auto flush = [&]() {
+            ok = ok && appendSegment(output, batch);
+            games += batch.size();
+            batch.clear();
+        };
+
+        for (const auto& path : paths) {
+            SegmentFile file(path);
+            if (!file.isOpen()) {
+                std::cerr << "Impossible d'ouvrir " << path << '\n';
+                return 1;
+            }
+            file.forEachSegment([&](const Segment& seg) {
+                for (std::size_t i = 0; i < seg.rows(); i++) {
+                    batch.push_back(seg.row(i));
+                    if (batch.size() == COMPACT_ROWS) flush();
+                }
+            });
+        }
+        flush();
+
+        if (!ok) {
+            std::cerr << "Echec d'ecriture dans " << output << '\n';
+            return 1;
+        }
+        std::printf("%llu parties ecrites dans %s\n", static_cast<unsigned long long>(games), output.c_str());
+        return 0;
+    }
+
+    /// Scores des parties lues dans `path`, dans l'ordre des segments.
+    std::vector<std::uint32_t> readScores(const std::string& path) {
+        std::vector<std::uint32_t> scores;
+        SegmentFile file(path);
+        file.forEachSegment([&](const Segment& seg) {
+            for (auto v : seg.column<std::uint32_t>(Column::Score)) scores.push_back(v);
+        });
+        return scores;
+    }
+
+    /**
+     * @brief Mode `check` : un segment coupé à chaque longueur possible, suivi
+     * d'un segment complet, ne doit rendre que le segment complet.
+     *
+     * Reproduit un arrêt brutal pendant l'écriture suivi d'une nouvelle partie.
+     * Le fichier `path` est écrasé puis supprimé.
+     *
+     * @return 0 si le segment ajouté est relu intact à chaque coupure, 1 sinon.
+     */
+    int check(const std::string& path) {
+        auto games = [](std::uint32_t first, std::size_t count) {
+            std::vector<GameRecord> g(count);
+            for (std::size_t i = 0; i < count; i++) {
+                g[i].score = first + static_cast<std::uint32_t>(i);
+                g[i].placementMs.assign(i + 1, 1000);
+                g[i].levelUps.push_back({500, 2});
+            }
+            return g;
+        };
+        const std::vector<std::uint32_t> appended {900, 901};
+
+        std::filesystem::remove(path);
+        if (!appendSegment(path, games(100, 3))) {
+            std::cerr << "Echec d'ecriture dans " << path << '\n';
+            return 1;
+        }
+        const std::uintmax_t full = std::filesystem::file_size(path);
+
+        int failures = 0;
+        for (std::uintmax_t cut = 1; cut < full; cut++) {
+            std::filesystem::remove(path);
+            appendSegment(path, games(100, 3));
+            std::filesystem::resize_file(path, cut);
+            appendSegment(path, games(900, 2));
+            if (readScores(path) != appended) {
+                std::fprintf(stderr, "segment coupe a %llu octets sur %llu : segment suivant perdu\n",
+                             static_cast<unsigned long long>(cut), static_cast<unsigned long long>(full));
+                failures++;
+            }
+        }
+
+        // Sans coupure, les deux segments sont lus
+        std::filesystem::remove(path);
+        appendSegment(path, games(100, 3));
+        appendSegment(path, games(900, 2));
+        if (readScores(path) != std::vector<std::uint32_t>{100, 101, 102, 900, 901}) {
+            std::fprintf(stderr, "segments complets mal relus\n");
+            failures++;
+        }
+        std::filesystem::remove(path);
+
+        std::printf("%llu coupures verifiees, %d echec(s)\n", static_cast<unsigned long long>(full - 1), failures);
+        return failures == 0 ? 0 : 1;
+    }
+
+    int usage() {
+        std::cerr << "Utilisation :\n"
+                     "  tetris-telemetry summary <fichier>...\n"
+                     "  tetris-telemetry compact <sortie> <fichier>...\n"
+                     "  tetris-telemetry check <fichier>\n";
+        return 2;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) return usage();
+    std::string command = argv[1];
+
+    if (command == "summary") {
+        return summary(std::vector<std::string>(argv + 2, argv + argc));
+    }
+    if (command == "compact" && argc >= 4) {
+        std::vector<std::string> inputs(argv + 3, argv + argc);
+        for (const auto& in : inputs) {
+            if (in == argv[2]) {
+                std::cerr << "La sortie ne peut pas etre aussi une entree\n";
+                return 2;
+            }
+        }
+        return compact(argv[2], inputs);
+    }
+    if (command == "check" && argc == 3) {
+        return check(argv[2]);
+    }
+    return usage();
+}